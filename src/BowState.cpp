@@ -1,5 +1,10 @@
 #include "BowState.h"
 
+#include <bit>
+
+#include "InventoryIndex.h"
+#include "config/ConfigSnapshot.h"
+#include "bow_input/ArmedState.h"
 #include "patchs/SkipEquipController.h"
 
 namespace {
@@ -22,79 +27,183 @@ namespace {
         }
     };
 
-    RE::ExtraDataList* ResolveLiveExtra(RE::TESBoundObject* base, RE::ExtraDataList* candidate) {
-        if (!base || !candidate) {
+    bool IsWornExtra(const RE::ExtraDataList* extra) {
+        return extra && (extra->HasType(RE::ExtraDataType::kWorn) || extra->HasType(RE::ExtraDataType::kWornLeft));
+    }
+
+    RE::ExtraDataList* FindWornExtra(const RE::TESBoundObject* armor) {
+        auto const* entry = BowState::Inventory::Find(armor);
+        if (!entry) {
             return nullptr;
         }
 
+        auto const it = std::ranges::find_if(entry->extras, IsWornExtra);
+        return it != entry->extras.end() ? *it : nullptr;
+    }
+
+    // Reads the third-person biped, whose slot i holds what is worn in armor slot 30 + i. Skin and other non-inventory
+    // armor has no worn extra list and is left out. Without loaded 3D the armor's own slot mask places it instead.
+    void CaptureWornSlots(BowState::WornSlots& out) {
+        out.bySlot.fill({});
+
         auto* player = RE::PlayerCharacter::GetSingleton();
         if (!player) {
-            return nullptr;
+            return;
         }
 
-        auto inventory = player->GetInventory();
+        if (auto const& biped = player->GetBiped(false)) {
+            for (std::size_t i = 0; i < BowState::WornSlots::kCount; ++i) {
+                auto* form = biped->objects[i].item;
+                auto* armor = form ? form->As<RE::TESObjectARMO>() : nullptr;
+                if (!armor) {
+                    continue;
+                }
 
-        for (auto const& [obj, data] : inventory) {
-            if (obj != base) {
-                continue;
+                if (i > 0 && out.bySlot[i - 1].base == armor) {
+                    out.bySlot[i] = out.bySlot[i - 1];
+                } else if (auto* extra = FindWornExtra(armor)) {
+                    out.bySlot[i] = BowState::ExtraEquippedItem{armor, extra};
+                }
             }
+            return;
+        }
 
-            auto const* entry = data.second.get();
-            if (!entry || !entry->extraLists) {
-                return nullptr;
+        for (auto const* entry : BowState::Inventory::Armor()) {
+            auto const* armor = entry->base->As<RE::TESObjectARMO>();
+            auto* extra = armor ? FindWornExtra(armor) : nullptr;
+            if (!extra) {
+                continue;
             }
 
-            for (auto* x : *entry->extraLists) {
-                if (x == candidate) {
-                    return x;
-                }
+            for (auto mask = static_cast<std::uint32_t>(armor->GetSlotMask()); mask != 0; mask &= mask - 1) {
+                const auto i = static_cast<std::size_t>(std::countr_zero(mask));
+                out.bySlot[i] = BowState::ExtraEquippedItem{entry->base, extra};
             }
-
-            return nullptr;
         }
+    }
 
-        return nullptr;
+    // Multi-slot armor is handled once, at its lowest slot.
+    bool IsFirstSlotOf(const BowState::WornSlots& worn, std::size_t slot) {
+        auto const* base = worn.bySlot[slot].base;
+        return std::ranges::none_of(worn.bySlot.begin(), worn.bySlot.begin() + static_cast<std::ptrdiff_t>(slot),
+                                    [base](auto const& other) { return other.base == base; });
     }
 
-    void RemoveChosenTagFromAnyTaggedInstance(RE::TESBoundObject* base) {
-        if (!base) {
-            return;
+    // Checked against the live inventory rather than the index: callers equip or rename through the result.
+    RE::ExtraDataList* ResolveLiveExtra(RE::TESBoundObject* base, RE::ExtraDataList* candidate) {
+        return BowState::Inventory::IsLive(base, candidate) ? candidate : nullptr;
+    }
+
+    std::uint16_t UniqueIdOf(const RE::ExtraDataList* extra) {
+        auto const* uid = extra ? extra->GetByType<RE::ExtraUniqueID>() : nullptr;
+        return uid ? uid->uniqueID : 0;
+    }
+
+    // Same assignment the engine makes when an instance first has to be told apart from the rest of its stack.
+    std::uint16_t EnsureUniqueId(RE::TESBoundObject* base, RE::ExtraDataList* extra) {
+        if (!base || !extra) {
+            return 0;
+        }
+        if (const auto id = UniqueIdOf(extra); id != 0) {
+            return id;
         }
 
         auto* player = RE::PlayerCharacter::GetSingleton();
-        if (!player) {
-            return;
+        auto* changes = player ? player->GetInventoryChanges() : nullptr;
+        if (!changes) {
+            return 0;
         }
 
+        changes->SetUniqueID(extra, nullptr, base);
+        BowState::Inventory::Invalidate();
+        return UniqueIdOf(extra);
+    }
+
+    // Saves from before the unique-ID tracking only mark the chosen instance through its name; read once to migrate.
+    RE::ExtraDataList* FindLegacyTaggedInstance(RE::TESBoundObject* base) {
         constexpr const char* kChosenTag = " (chosen)";
         constexpr std::size_t kTagLen = 9;
 
-        auto inventory = player->GetInventory();
-        for (auto const& [obj, data] : inventory) {
-            if (obj != base) {
+        auto const* entry = BowState::Inventory::Find(base);
+        if (!entry) {
+            return nullptr;
+        }
+
+        for (auto* x : entry->extras) {
+            const char* disp = x->GetDisplayName(base);
+            if (!disp) {
                 continue;
             }
-
-            auto const* entry = data.second.get();
-            if (!entry || !entry->extraLists) {
-                return;
+            std::size_t len = std::strlen(disp);
+            if (len >= kTagLen && std::memcmp(disp + (len - kTagLen), kChosenTag, kTagLen) == 0) {
+                return x;
             }
+        }
+        return nullptr;
+    }
 
-            for (auto* x : *entry->extraLists) {
-                if (!x) {
-                    continue;
-                }
-                const char* disp = x->GetDisplayName(base);
-                if (!disp) {
-                    continue;
-                }
-                std::size_t len = std::strlen(disp);
-                if (len >= kTagLen && std::memcmp(disp + (len - kTagLen), kChosenTag, kTagLen) == 0) {
-                    BowState::detail::RemoveChosenTagFromInstance(base, x);
-                }
+    std::uint16_t ChosenUniqueId() {
+        return static_cast<std::uint16_t>(IntegratedBow::GetBowConfig().chosenBowUid.load(std::memory_order_relaxed));
+    }
+
+    void TrackChosenInstance(RE::TESBoundObject* base, RE::ExtraDataList* extra) {
+        IntegratedBow::GetBowConfig().chosenBowUid.store(EnsureUniqueId(base, extra), std::memory_order_relaxed);
+    }
+
+    // The tracked instance of base: by unique ID, or by the legacy name tag when no ID was recorded yet or the recorded
+    // one no longer resolves (so a tagged instance is re-tracked instead of a second one getting tagged).
+    RE::ExtraDataList* FindChosenInstance(RE::TESBoundObject* base) {
+        if (const auto uid = ChosenUniqueId(); uid != 0) {
+            if (auto* tracked = BowState::Inventory::FindUnique(base, uid)) {
+                return tracked;
             }
+        }
+
+        auto* legacy = FindLegacyTaggedInstance(base);
+        if (legacy) {
+            TrackChosenInstance(base, legacy);
+        }
+        return legacy;
+    }
+
+    void UntagChosenInstance(RE::TESBoundObject* base, RE::ExtraDataList* extra) {
+        auto* live = ResolveLiveExtra(base, extra);
+        if (!live) {
+            live = FindChosenInstance(base);
+        }
+        if (live) {
+            BowState::detail::RemoveChosenTagFromInstance(base, live);
+        }
+    }
+
+    // The suffix is cosmetic only; tracking never reads it. Brings the name in line with NoChosenTag, so turning the
+    // option on also strips a tag written earlier.
+    void SyncChosenTag(RE::TESBoundObject* base, RE::ExtraDataList* extra) {
+        if (IntegratedBow::CurrentConfig()->noChosenTag) {
+            BowState::detail::RemoveChosenTagFromInstance(base, extra);
+        } else {
+            BowState::detail::ApplyChosenTagToInstance(base, extra);
+        }
+    }
+
+    constexpr std::size_t kNameBufferSize = 512;
+
+    // SetName copies the string, so the composed name only has to live on the stack; names that do not fit fall back
+    // to the heap.
+    void SetDisplayName(RE::ExtraTextDisplayData* tdd, std::string_view base, std::string_view suffix) {
+        if (base.size() + suffix.size() < kNameBufferSize) {
+            std::array<char, kNameBufferSize> buf;
+            auto* end = std::ranges::copy(base, buf.data()).out;
+            end = std::ranges::copy(suffix, end).out;
+            *end = '\0';
+            tdd->SetName(buf.data());
             return;
         }
+
+        std::string name;
+        name.reserve(base.size() + suffix.size());
+        name.append(base).append(suffix);
+        tdd->SetName(name.c_str());
     }
 
     bool IsHandReady(RE::PlayerCharacter* player, RE::TESBoundObject* desired, bool leftHand) {
@@ -108,87 +217,95 @@ namespace {
         }
         return curBase == desired;
     }
-}
 
-bool BowState::detail::IsTemperingTag(std::string_view inside) {
-    for (auto q : kQualityTags) {
-        if (inside.size() != q.size()) {
-            continue;
-        }
+    constexpr std::uint64_t kFinalizeExtrasTimeoutMs = 2000;
 
-        bool match = true;
-        for (std::size_t i = 0; i < q.size(); ++i) {
-            const auto c = static_cast<char>(std::tolower(static_cast<unsigned char>(inside[i])));
-            if (c != q[i]) {
-                match = false;
-                break;
-            }
-        }
+    void FinalizeDeferredExtras(RE::PlayerCharacter* player, RE::ActorEquipManager* equipMgr) {
+        auto& st = BowState::Get();
+        BowState::ReequipPrevExtraEquipped(player, equipMgr);
 
-        if (match) {
-            return true;
-        }
+        st.pendingFinalizeExtras = false;
+        BowInput::Scheduler::Cancel(st.pendingFinalizeExtrasTimer);
+        st.pendingDesiredRight = nullptr;
+        st.pendingDesiredLeft = nullptr;
+        BowInput::Armed::Disarm(BowInput::Armed::Bit::DeferredFinalize);
+
+        BowState::ClearPrevExtraEquipped();
     }
 
-    return false;
-}
+    // As mãos nunca ficaram prontas: re-equipa os extras assim mesmo.
+    void OnFinalizeExtrasTimeout(std::uintptr_t) {
+        auto& st = BowState::Get();
+        st.pendingFinalizeExtrasTimer = BowInput::TimerWheel::kNone;
+        if (!st.pendingFinalizeExtras) return;
 
-void BowState::detail::TrimTrailingSpaces(std::string& s) {
-    while (!s.empty() && s.back() == ' ') {
-        s.pop_back();
+        auto* player = RE::PlayerCharacter::GetSingleton();
+        auto* equipMgr = RE::ActorEquipManager::GetSingleton();
+        if (player && equipMgr) {
+            FinalizeDeferredExtras(player, equipMgr);
+        }
     }
 }
 
-void BowState::detail::RemoveChosenTagInplace(std::string& s) {
-    constexpr std::string_view chosenTag{" (chosen)"};
-
-    for (;;) {
-        auto pos = s.find(chosenTag);
-        if (pos == std::string::npos) {
-            break;
-        }
+bool BowState::detail::IsTemperingTag(std::string_view inside) noexcept {
+    if (inside.size() < kMinQualityTagLen || inside.size() > kMaxQualityTagLen) {
+        return false;
+    }
 
-        s.erase(pos, chosenTag.size());
+    std::array<char, kMaxQualityTagLen> folded{};
+    for (std::size_t i = 0; i < inside.size(); ++i) {
+        const char c = inside[i];
+        folded[i] = c >= 'A' && c <= 'Z' ? static_cast<char>(c | 0x20) : c;
     }
 
-    TrimTrailingSpaces(s);
+    return std::ranges::find(kQualityTags, std::string_view{folded.data(), inside.size()}) != kQualityTags.end();
 }
 
-void BowState::detail::StripTemperingSuffixes(std::string& name) {
-    TrimTrailingSpaces(name);
+std::size_t BowState::detail::BaseNameLength(std::string_view name) noexcept {
+    constexpr std::string_view chosen{"chosen"};
 
+    std::size_t n = name.size();
     for (;;) {
-        bool canStrip = true;
-        std::size_t open = std::string::npos;
-
-        if (name.size() < 3 || name.back() != ')') {
-            canStrip = false;
+        while (n > 0 && name[n - 1] == ' ') {
+            --n;
         }
-
-        if (canStrip) {
-            open = name.rfind('(');
-            if (open == std::string::npos || open == 0 || name[open - 1] != ' ') {
-                canStrip = false;
-            }
+        if (n < 3 || name[n - 1] != ')') {
+            return n;
         }
 
-        std::string_view inside{};
-        if (canStrip) {
-            inside = std::string_view(name.data() + open + 1, name.size() - open - 2);
-            if (!IsTemperingTag(inside)) {
-                canStrip = false;
-            }
+        const auto head = name.substr(0, n);
+        const auto open = head.rfind('(');
+        if (open == std::string_view::npos || open == 0 || head[open - 1] != ' ') {
+            return n;
         }
 
-        if (!canStrip) {
-            break;
+        if (const auto inside = head.substr(open + 1, n - open - 2); inside != chosen && !IsTemperingTag(inside)) {
+            return n;
         }
 
-        name.erase(open - 1);
-        TrimTrailingSpaces(name);
+        n = open - 1;
     }
+}
+
+std::string_view BowState::detail::RemoveChosenTags(std::string_view name, std::span<char> scratch) noexcept {
+    constexpr std::string_view chosenTag{" (chosen)"};
+
+    auto pos = name.find(chosenTag);
+    if (pos == std::string_view::npos || name.size() > scratch.size()) {
+        return name;
+    }
+
+    char* const first = scratch.data();
+    std::size_t size = name.copy(first, name.size());
 
-    TrimTrailingSpaces(name);
+    while (pos != std::string_view::npos) {
+        std::ranges::copy(first + pos + chosenTag.size(), first + size, first + pos);
+        size -= chosenTag.size();
+        // Closing the gap can form a new tag across it, so the search resumes just before the joint.
+        pos = std::string_view{first, size}.find(chosenTag, pos >= chosenTag.size() ? pos - chosenTag.size() + 1 : 0);
+    }
+
+    return {first, size};
 }
 
 void BowState::detail::ApplyChosenTagToInstance(RE::TESBoundObject* base, RE::ExtraDataList* extra) {
@@ -196,8 +313,6 @@ void BowState::detail::ApplyChosenTagToInstance(RE::TESBoundObject* base, RE::Ex
         return;
     }
 
-    if (IntegratedBow::GetBowConfig().noChosenTag) return;
-
     auto* tdd = extra->GetExtraTextDisplayData();
 
     const char* cstr = nullptr;
@@ -218,17 +333,14 @@ void BowState::detail::ApplyChosenTagToInstance(RE::TESBoundObject* base, RE::Ex
         return;
     }
 
-    constexpr std::string_view chosenTag{" (chosen)"};
-    std::string curName{cstr};
-
-    RemoveChosenTagInplace(curName);
-    StripTemperingSuffixes(curName);
+    std::array<char, kNameBufferSize> scratch;
+    const auto cleaned = RemoveChosenTags(cstr, scratch);
+    const auto baseName = cleaned.substr(0, BaseNameLength(cleaned));
+    const std::string_view suffix = baseName.empty() ? "(chosen)" : " (chosen)";
 
-    const auto cleanedName = curName;
-    if (!curName.empty()) {
-        curName += chosenTag;
-    } else {
-        curName = "(chosen)";
+    if (const std::string_view cur{cstr};
+        tdd && cur.size() == baseName.size() + suffix.size() && cur.starts_with(baseName) && cur.ends_with(suffix)) {
+        return;
     }
 
     if (!tdd) {
@@ -239,7 +351,7 @@ void BowState::detail::ApplyChosenTagToInstance(RE::TESBoundObject* base, RE::Ex
         extra->Add(tdd);
     }
 
-    tdd->SetName(curName.c_str());
+    SetDisplayName(tdd, baseName, suffix);
 }
 
 void BowState::detail::RemoveChosenTagFromInstance(RE::TESBoundObject* base, RE::ExtraDataList* extra) {
@@ -260,25 +372,38 @@ void BowState::detail::RemoveChosenTagFromInstance(RE::TESBoundObject* base, RE:
         return;
     }
 
-    std::string curName = cstr;
-
-    RemoveChosenTagInplace(curName);
-    StripTemperingSuffixes(curName);
+    const std::string_view curName{cstr};
+    std::array<char, kNameBufferSize> scratch;
+    const auto cleaned = RemoveChosenTags(curName, scratch);
+    const auto len = BaseNameLength(cleaned);
 
-    if (curName.empty()) {
+    if (len == 0) {
         extra->RemoveByType(RE::ExtraDataType::kTextDisplayData);
-    } else {
-        tdd->SetName(curName.c_str());
+    } else if (len != curName.size()) {
+        SetDisplayName(tdd, cleaned.substr(0, len), {});
     }
 }
 
-RE::BSFixedString BowState::detail::GetAttackUserEvent() {
-    static RE::BSFixedString ev{"Right Attack/Block"};
+const RE::BSFixedString& BowState::detail::GetAttackUserEvent() {
+    static const RE::BSFixedString ev{"Right Attack/Block"};  // NOSONAR
     return ev;
 }
 
 RE::ButtonEvent* BowState::detail::MakeAttackButtonEvent(float value, float heldSecs) {
-    return RE::ButtonEvent::Create(RE::INPUT_DEVICE::kMouse, GetAttackUserEvent(), kAttackMouseIdCode, value, heldSecs);
+    auto* ev = GetAttackEventPool().Acquire([] {
+        return RE::ButtonEvent::Create(RE::INPUT_DEVICE::kMouse, GetAttackUserEvent(), kAttackMouseIdCode, 0.0f,
+                                       0.0f);
+    });
+
+    if (!ev) {
+        return RE::ButtonEvent::Create(RE::INPUT_DEVICE::kMouse, GetAttackUserEvent(), kAttackMouseIdCode, value,
+                                       heldSecs);
+    }
+
+    ev->next = nullptr;
+    ev->value = value;
+    ev->heldDownSecs = heldSecs;
+    return ev;
 }
 
 void BowState::detail::EnqueueSyntheticAttack(RE::ButtonEvent* ev) {
@@ -286,37 +411,55 @@ void BowState::detail::EnqueueSyntheticAttack(RE::ButtonEvent* ev) {
         return;
     }
 
-    auto& st = GetSyntheticInputState();
-    {
-        std::scoped_lock lk(st.mutex);
-        st.pending.push(ev);
+    if (!GetSyntheticInputState().pending.TryPush(ev)) {
+        GetAttackEventPool().Release(ev);
+        static std::atomic_bool s_warned{false};  // NOSONAR
+        if (!s_warned.exchange(true, std::memory_order_relaxed)) {
+            spdlog::warn("[INTEGRATEDBOW][SyntheticInput] queue full ({} events), dropping synthetic input",
+                         kSyntheticInputCapacity);
+        }
     }
 }
 
-RE::InputEvent* BowState::detail::FlushSyntheticInput(RE::InputEvent* head) {
-    auto& st = GetSyntheticInputState();
+bool BowState::detail::HasPendingSyntheticInput() noexcept {
+    return !GetSyntheticInputState().pending.EmptyRelaxed();
+}
 
-    std::queue<RE::ButtonEvent*> local;
-    {
-        std::scoped_lock lk(st.mutex);
-        local.swap(st.pending);
+namespace {
+    bool IsMergeableHold(const RE::ButtonEvent* prev, const RE::ButtonEvent* ev) {
+        return prev->IsHeld() && ev->IsHeld() && prev->GetDevice() == ev->GetDevice() &&
+               prev->idCode == ev->idCode && prev->QUserEvent() == ev->QUserEvent();
     }
+}
 
-    if (local.empty()) {
+RE::InputEvent* BowState::detail::FlushSyntheticInput(RE::InputEvent* head) {
+    auto& st = GetSyntheticInputState();
+
+    if (st.pending.EmptyRelaxed()) {
         return head;
     }
 
-    RE::InputEvent* synthHead = nullptr;
-    RE::InputEvent* synthTail = nullptr;
+    RE::ButtonEvent* synthHead = nullptr;
+    RE::ButtonEvent* synthTail = nullptr;
 
-    while (!local.empty()) {
-        auto* ev = local.front();
-        local.pop();
+    // Stops once every in-flight slot is taken (a poll whose events were not recycled yet); the rest stays queued
+    // for the next poll.
+    RE::ButtonEvent* ev = nullptr;
+    while (st.inFlightCount < st.inFlight.size() && st.pending.TryPop(ev)) {
         if (!ev) {
             continue;
         }
 
+        // Several hold frames queued between two polls: the engine only needs the latest held time.
+        if (synthTail && IsMergeableHold(synthTail, ev)) {
+            synthTail->value = ev->value;
+            synthTail->heldDownSecs = ev->heldDownSecs;
+            GetAttackEventPool().Release(ev);
+            continue;
+        }
+
         ev->next = nullptr;
+        st.inFlight[st.inFlightCount++] = ev;
 
         if (!synthHead) {
             synthHead = ev;
@@ -327,8 +470,8 @@ RE::InputEvent* BowState::detail::FlushSyntheticInput(RE::InputEvent* head) {
         }
     }
 
-    if (!head) {
-        return synthHead;
+    if (!synthHead) {
+        return head;
     }
 
     synthTail->next = head;
@@ -336,6 +479,27 @@ RE::InputEvent* BowState::detail::FlushSyntheticInput(RE::InputEvent* head) {
     return synthHead;
 }
 
+bool BowState::detail::IsSyntheticInput(const RE::InputEvent* ev) noexcept {
+    auto const& st = GetSyntheticInputState();
+    for (std::size_t i = 0; i < st.inFlightCount; ++i) {
+        if (st.inFlight[i] == ev) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void BowState::detail::RecycleDeliveredSyntheticInput() {
+    auto& st = GetSyntheticInputState();
+    auto& pool = GetAttackEventPool();
+
+    for (std::size_t i = 0; i < st.inFlightCount; ++i) {
+        pool.Release(st.inFlight[i]);
+        st.inFlight[i] = nullptr;
+    }
+    st.inFlightCount = 0;
+}
+
 void BowState::detail::DispatchAttackButtonEvent(RE::ButtonEvent* ev) { EnqueueSyntheticAttack(ev); }
 
 BowState::detail::SyntheticInputState& BowState::detail::GetSyntheticInputState() {
@@ -343,6 +507,11 @@ BowState::detail::SyntheticInputState& BowState::detail::GetSyntheticInputState(
     return s;
 }
 
+BowState::detail::AttackEventPool& BowState::detail::GetAttackEventPool() {
+    static AttackEventPool s;  // NOSONAR
+    return s;
+}
+
 BowState::IntegratedBowState& BowState::Get() {
     static IntegratedBowState s;  // NOSONAR
     return s;
@@ -364,54 +533,9 @@ void BowState::LoadChosenBow(RE::TESObjectWEAP* bow) {
     }
 
     st.chosenBow.base = base;
-
-    auto* player = RE::PlayerCharacter::GetSingleton();
-    if (!player) {
-        return;
-    }
-
-    auto inventory = player->GetInventory([base](RE::TESBoundObject& obj) { return &obj == base; });
-
-    constexpr const char* kChosenTag = " (chosen)";
-    constexpr std::size_t kTagLen = 9;
-
-    for (auto const& [obj, data] : inventory) {
-        if (obj != base) {
-            continue;
-        }
-
-        auto const& entryPtr = data.second;
-
-        auto const* entry = entryPtr.get();
-        if (!entry) {
-            continue;
-        }
-
-        if (!entry || !entry->extraLists) {
-            continue;
-        }
-
-        for (auto* extra : *entry->extraLists) {
-            if (!extra) {
-                continue;
-            }
-
-            const char* dispName = extra->GetDisplayName(obj);
-            if (!dispName || !*dispName) {
-                continue;
-            }
-
-            const std::size_t len = std::strlen(dispName);
-            if (len < kTagLen) {
-                continue;
-            }
-
-            if (std::memcmp(dispName + (len - kTagLen), kChosenTag, kTagLen) == 0) {
-                st.chosenBow.extra = extra;
-
-                return;
-            }
-        }
+    st.chosenBow.extra = FindChosenInstance(base);
+    if (st.chosenBow.extra) {
+        SyncChosenTag(base, st.chosenBow.extra);
     }
 }
 
@@ -427,6 +551,7 @@ void BowState::ClearChosenBow() {
     st.chosenBow.extra = nullptr;
 
     cfg.chosenBowFormID.store(0u, std::memory_order_relaxed);
+    cfg.chosenBowUid.store(0u, std::memory_order_relaxed);
     cfg.Save();
 }
 
@@ -451,85 +576,23 @@ bool BowState::EnsureChosenBowInInventory() {
         }
     }
 
-    auto const* const chosenBase = st.chosenBow.base;
-    if (!chosenBase) {
-        return false;
-    }
-
-    auto inventory = player->GetInventory([chosenBase](RE::TESBoundObject& obj) { return &obj == chosenBase; });
-
-    constexpr const char* kChosenTag = " (chosen)";
-    constexpr std::size_t kTagLen = 9;
-
-    bool anyFound = false;
-    RE::ExtraDataList* foundAnyExtra = nullptr;
-    RE::ExtraDataList* foundExact = nullptr;
-    RE::ExtraDataList* foundTagged = nullptr;
-
-    for (auto const& [obj, data] : inventory) {
-        if (obj != chosenBase) {
-            continue;
-        }
-
-        if (auto const count = data.first; count > 0) {
-            anyFound = true;
-        }
-
-        auto const& entryPtr = data.second;
-        auto const* entry = entryPtr.get();
-        if (!entry) {
-            continue;
-        }
-
-        if (!entry->extraLists || entry->extraLists->empty()) {
-            continue;
-        }
-
-        for (auto* extra : *entry->extraLists) {
-            if (!extra) {
-                continue;
-            }
-
-            if (!foundAnyExtra) {
-                foundAnyExtra = extra;
-            }
+    auto* const chosenBase = st.chosenBow.base;
 
-            const char* dispName = extra->GetDisplayName(obj);
-            if (!dispName || !*dispName) {
-                continue;
-            }
-
-            if (st.chosenBow.extra && extra == st.chosenBow.extra) {
-                foundExact = extra;
-
-                break;
-            }
-
-            const std::size_t len = std::strlen(dispName);
-            if (len >= kTagLen && std::memcmp(dispName + (len - kTagLen), kChosenTag, kTagLen) == 0) {
-                foundTagged = extra;
-            }
-        }
-
-        if (foundExact) {
-            break;
-        }
-    }
-
-    if (foundExact) {
+    if (ResolveLiveExtra(chosenBase, st.chosenBow.extra)) {
         return true;
     }
 
-    if (foundTagged) {
-        st.chosenBow.extra = foundTagged;
+    if (auto* tracked = FindChosenInstance(chosenBase)) {
+        st.chosenBow.extra = tracked;
 
         return true;
     }
 
-    if (foundAnyExtra) {
-        st.chosenBow.extra = foundAnyExtra;
+    if (auto* first = FindAnyInstanceExtraForBase(chosenBase)) {
+        st.chosenBow.extra = first;
 
-        BowState::detail::ApplyChosenTagToInstance(st.chosenBow.base, st.chosenBow.extra);
+        TrackChosenInstance(chosenBase, st.chosenBow.extra);
+        SyncChosenTag(st.chosenBow.base, st.chosenBow.extra);
 
         if (auto const* bow = st.chosenBow.base->As<RE::TESObjectWEAP>()) {
             cfg.chosenBowFormID.store(bow->GetFormID(), std::memory_order_relaxed);
@@ -542,7 +605,7 @@ bool BowState::EnsureChosenBowInInventory() {
         return true;
     }
 
-    if (anyFound) {
+    if (auto const* entry = Inventory::Find(chosenBase); entry && entry->count > 0) {
         st.chosenBow.extra = nullptr;
 
         if (auto const* bow = st.chosenBow.base ? st.chosenBow.base->As<RE::TESObjectWEAP>() : nullptr) {
@@ -565,25 +628,18 @@ void BowState::SetChosenBow(RE::TESObjectWEAP* bow, RE::ExtraDataList* extra) {
     const auto newBase = bow ? bow->As<RE::TESBoundObject>() : nullptr;
 
     if (RE::TESBoundObject const* base = newBase; st.chosenBow.base == base && st.chosenBow.extra == extra) {
-        if (auto* live = ResolveLiveExtra(st.chosenBow.base, st.chosenBow.extra)) {
-            detail::RemoveChosenTagFromInstance(st.chosenBow.base, live);
-        } else {
-            RemoveChosenTagFromAnyTaggedInstance(st.chosenBow.base);
-        }
+        UntagChosenInstance(st.chosenBow.base, st.chosenBow.extra);
         st.chosenBow.base = nullptr;
         st.chosenBow.extra = nullptr;
         cfg.chosenBowFormID.store(0u, std::memory_order_relaxed);
+        cfg.chosenBowUid.store(0u, std::memory_order_relaxed);
         cfg.Save();
 
         return;
     }
 
     if (st.chosenBow.base && st.chosenBow.extra) {
-        if (auto* live = ResolveLiveExtra(st.chosenBow.base, st.chosenBow.extra)) {
-            detail::RemoveChosenTagFromInstance(st.chosenBow.base, live);
-        } else {
-            RemoveChosenTagFromAnyTaggedInstance(st.chosenBow.base);
-        }
+        UntagChosenInstance(st.chosenBow.base, st.chosenBow.extra);
     }
 
     st.chosenBow.base = newBase;
@@ -591,108 +647,75 @@ void BowState::SetChosenBow(RE::TESObjectWEAP* bow, RE::ExtraDataList* extra) {
 
     const auto newId = bow ? bow->GetFormID() : 0u;
     cfg.chosenBowFormID.store(newId, std::memory_order_relaxed);
+    TrackChosenInstance(st.chosenBow.base, st.chosenBow.extra);
     cfg.Save();
     if (!st.chosenBow.extra) {
         EnsureChosenBowInInventory();
     }
-    detail::ApplyChosenTagToInstance(st.chosenBow.base, st.chosenBow.extra);
+    SyncChosenTag(st.chosenBow.base, st.chosenBow.extra);
 }
 
+// Callers equip or tag the result, so it is confirmed live; a stale index is rebuilt once.
 RE::ExtraDataList* BowState::FindAnyInstanceExtraForBase(RE::TESBoundObject* base) {
     if (!base) {
         return nullptr;
     }
 
-    auto* player = RE::PlayerCharacter::GetSingleton();
-    if (!player) {
-        return nullptr;
-    }
-
-    auto inventory = player->GetInventory([base](RE::TESBoundObject& obj) { return &obj == base; });
-
-    for (auto const& [obj, data] : inventory) {
-        if (obj != base) {
-            continue;
-        }
-
-        auto const& entryPtr = data.second;
-        auto const* entry = entryPtr.get();
-        if (!entry) {
-            continue;
-        }
-        if (!entry->extraLists) {
-            continue;
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        auto const* entry = Inventory::Find(base);
+        if (!entry || entry->extras.empty()) {
+            return nullptr;
         }
-
-        for (auto* extra : *entry->extraLists) {
-            if (!extra) {
-                continue;
-            }
-
-            return extra;
+        if (auto* first = entry->extras.front(); Inventory::IsLive(base, first)) {
+            return first;
         }
     }
-
     return nullptr;
 }
 
-void BowState::CaptureWornArmorSnapshot(std::vector<ExtraEquippedItem>& out) {
-    out.clear();
+void BowState::ScanForEnterBowMode(EnterBowScan& out, const RE::TESAmmo* preferredArrow,
+                                   std::span<const RE::FormID> hiddenFormIDs) {
+    out.hiddenSlots = 0;
+    out.preferredArrowCount = 0;
 
-    auto* player = RE::PlayerCharacter::GetSingleton();
-    if (!player) {
-        return;
-    }
-
-    auto inventory = player->GetInventory([](RE::TESBoundObject&) { return true; });
-
-    for (auto const& [obj, data] : inventory) {
-        auto* armor = obj->As<RE::TESObjectARMO>();
-        if (!armor) {
-            continue;
+    if (preferredArrow) {
+        if (auto const* entry = Inventory::Find(preferredArrow)) {
+            out.preferredArrowCount = entry->count;
         }
+    }
 
-        auto const& entryPtr = data.second;
-        auto const* entry = entryPtr.get();
-        if (!entry || !entry->extraLists) {
-            continue;
-        }
-
-        for (auto* extra : *entry->extraLists) {
-            if (!extra) {
-                continue;
-            }
-
-            const bool worn = extra->HasType(RE::ExtraDataType::kWorn);
-            const bool wornLeft = extra->HasType(RE::ExtraDataType::kWornLeft);
+    CaptureWornSlots(out.worn);
 
-            if (worn || wornLeft) {
-                out.push_back(ExtraEquippedItem{armor->As<RE::TESBoundObject>(), extra});
-            }
+    for (std::size_t i = 0; i < WornSlots::kCount; ++i) {
+        auto const* base = out.worn.bySlot[i].base;
+        if (base && std::ranges::binary_search(hiddenFormIDs, base->GetFormID())) {
+            out.hiddenSlots |= std::uint32_t{1} << i;
         }
     }
 }
 
-std::vector<BowState::ExtraEquippedItem> BowState::DiffArmorSnapshot(const std::vector<ExtraEquippedItem>& before,
-                                                                     const std::vector<ExtraEquippedItem>& after) {
-    std::vector<ExtraEquippedItem> removed;
-
-    for (auto const& b : before) {
-        bool stillWorn = false;
-
-        for (auto const& a : after) {
-            if (a.base == b.base && a.extra == b.extra) {
-                stillWorn = true;
-                break;
-            }
+// Only armor worn before the equip can have been displaced by it, so the before snapshot is checked against the live
+// worn flags slot by slot; no second snapshot. The equip may have merged a snapshotted list back into its stack, so
+// each one is confirmed live before its flags are read; a list that is gone was unequipped unless the base is still
+// worn through another one, and is recorded without a list for the engine to pick one on re-equip.
+void BowState::RecordDisplacedArmor(const WornSlots& before) {
+    auto& prev = Get().prevExtraEquipped;
+    prev.clear();
+
+    for (std::size_t i = 0; i < WornSlots::kCount; ++i) {
+        auto const& item = before.bySlot[i];
+        if (!item.base || !IsFirstSlotOf(before, i)) {
+            continue;
         }
 
-        if (!stillWorn) {
-            removed.push_back(b);
+        if (ResolveLiveExtra(item.base, item.extra)) {
+            if (!IsWornExtra(item.extra)) {
+                prev.push_back(item);
+            }
+        } else if (!FindWornExtra(item.base)) {
+            prev.push_back(ExtraEquippedItem{item.base, nullptr});
         }
     }
-
-    return removed;
 }
 
 void BowState::ReequipPrevExtraEquipped(RE::Actor* actor, RE::ActorEquipManager* equipMgr) {
@@ -708,12 +731,13 @@ void BowState::ReequipPrevExtraEquipped(RE::Actor* actor, RE::ActorEquipManager*
         }
 
         const bool isArmor = (item.base->GetFormType() == RE::FormType::Armor);
+        auto* extra = ResolveLiveExtra(item.base, item.extra);
 
         const bool queue = false;
         const bool force = !isArmor;
         const bool applyNow = isArmor;
 
-        equipMgr->EquipObject(actor, item.base, item.extra, 1, nullptr, queue, force, true, applyNow);
+        equipMgr->EquipObject(actor, item.base, extra, 1, nullptr, queue, force, true, applyNow);
     }
 
     st.prevExtraEquipped.clear();
@@ -731,50 +755,27 @@ bool BowState::ContainsPrevExtraEquipped(const ExtraEquippedItem& item) {
 }
 
 void BowState::ApplyHiddenItemsPatch(RE::PlayerCharacter* player, RE::ActorEquipManager* equipMgr,
-                                     const std::vector<RE::FormID>& hiddenFormIDs) {
+                                     const WornSlots& worn, std::uint32_t hiddenSlots) {
     if (!player || !equipMgr) {
         return;
     }
-    if (hiddenFormIDs.empty()) {
-        return;
-    }
-
-    auto inventory = player->GetInventory([](RE::TESBoundObject&) { return true; });
-
-    for (auto const& [obj, data] : inventory) {
-        auto* armor = obj->As<RE::TESObjectARMO>();
-        if (!armor) {
-            continue;
-        }
 
-        if (const auto armorId = armor->GetFormID(); !std::ranges::binary_search(hiddenFormIDs, armorId)) {
+    for (; hiddenSlots != 0; hiddenSlots &= hiddenSlots - 1) {
+        const auto i = static_cast<std::size_t>(std::countr_zero(hiddenSlots));
+        if (!IsFirstSlotOf(worn, i)) {
             continue;
         }
 
-        auto const& entryPtr = data.second;
-        auto const* entry = entryPtr.get();
-        if (!entry || !entry->extraLists) {
+        // The snapshot predates the bow equip, which may have merged its list away.
+        auto const& snap = worn.bySlot[i];
+        const ExtraEquippedItem item{snap.base, ResolveLiveExtra(snap.base, snap.extra)};
+        // Already taken off by the bow equip and recorded for re-equip.
+        if (!IsWornExtra(item.extra) || ContainsPrevExtraEquipped(item)) {
             continue;
         }
 
-        for (auto* extra : *entry->extraLists) {
-            if (!extra) {
-                continue;
-            }
-
-            const bool worn = extra->HasType(RE::ExtraDataType::kWorn);
-            if (const bool wornLeft = extra->HasType(RE::ExtraDataType::kWornLeft); !worn && !wornLeft) {
-                continue;
-            }
-
-            ExtraEquippedItem item{armor->As<RE::TESBoundObject>(), extra};
-            if (ContainsPrevExtraEquipped(item)) {
-                continue;
-            }
-
-            equipMgr->UnequipObject(player, item.base, item.extra, 1, nullptr, true, true, true, false, nullptr);
-            AppendPrevExtraEquipped(item);
-        }
+        equipMgr->UnequipObject(player, item.base, item.extra, 1, nullptr, true, true, true, false, nullptr);
+        AppendPrevExtraEquipped(item);
     }
 }
 
@@ -805,9 +806,7 @@ void BowState::RestorePrevWeaponsAndAmmo(RE::PlayerCharacter* player, RE::ActorE
         return;
     }
 
-    auto const& cfg = IntegratedBow::GetBowConfig();
-
-    const bool doSkipReturn = cfg.skipEquipReturnToMeleePatch.load(std::memory_order_relaxed);
+    const bool doSkipReturn = IntegratedBow::CurrentConfig()->skipEquipReturnToMeleePatch;
     ScopedSkipEquipReturn skipGuard(doSkipReturn, player);
 
     BowInput::ForceAllowUnequip();
@@ -886,33 +885,28 @@ void BowState::RestorePrevWeaponsAndAmmo(RE::PlayerCharacter* player, RE::ActorE
     }
 
     st.pendingFinalizeExtras = true;
-    st.pendingFinalizeExtrasTimer = 0.0f;
+    BowInput::Scheduler::Cancel(st.pendingFinalizeExtrasTimer);
+    st.pendingFinalizeExtrasTimer = BowInput::Scheduler::After(kFinalizeExtrasTimeoutMs, &OnFinalizeExtrasTimeout);
+    BowInput::Armed::Arm(BowInput::Armed::Bit::DeferredFinalize);
     st.pendingDesiredRight = st.prevRight.base;
     st.pendingDesiredLeft = st.prevLeft.base;
 
     ClearPrevWeapons();
 }
 
-void BowState::UpdateDeferredFinalize(RE::PlayerCharacter* player, RE::ActorEquipManager* equipMgr, float dt) {
+void BowState::UpdateDeferredFinalize(RE::PlayerCharacter* player, RE::ActorEquipManager* equipMgr) {
     auto& st = Get();
     if (!st.pendingFinalizeExtras) {
+        BowInput::Armed::Disarm(BowInput::Armed::Bit::DeferredFinalize);
         return;
     }
 
-    st.pendingFinalizeExtrasTimer += dt;
-
     const bool rightOK = IsHandReady(player, st.pendingDesiredRight, false);
     const bool leftOK = IsHandReady(player, st.pendingDesiredLeft, true);
-    if (const bool timedOut = (st.pendingFinalizeExtrasTimer >= 2.0f); !timedOut && !(rightOK && leftOK)) {
+    if (const bool timedOut = !BowInput::Scheduler::IsPending(st.pendingFinalizeExtrasTimer);
+        !timedOut && !(rightOK && leftOK)) {
         return;
     }
 
-    ReequipPrevExtraEquipped(player, equipMgr);
-
-    st.pendingFinalizeExtras = false;
-    st.pendingFinalizeExtrasTimer = 0.0f;
-    st.pendingDesiredRight = nullptr;
-    st.pendingDesiredLeft = nullptr;
-
-    ClearPrevExtraEquipped();
-}
\ No newline at end of file
+    FinalizeDeferredExtras(player, equipMgr);
+}
@@ -1,9 +1,11 @@
 #pragma once
 #include <array>
-#include <mutex>
-#include <queue>
 #include <ranges>
+#include <span>
 
+#include "bow_input/EventPool.h"
+#include "bow_input/MpscRing.h"
+#include "bow_input/TimerWheel.h"
 #include "config/BowConfig.h"
 #include "PCH.h"
 
@@ -17,23 +19,39 @@ namespace BowState {
     namespace detail {
         static constexpr std::array<std::string_view, 6> kQualityTags{"fine",     "superior", "exquisite",
                                                                       "flawless", "epic",     "legendary"};
+        constexpr std::size_t kMinQualityTagLen = 4;
+        constexpr std::size_t kMaxQualityTagLen = 9;
         constexpr std::uint32_t kAttackMouseIdCode = 0;
+        constexpr std::size_t kSyntheticInputCapacity = 64;
+        constexpr std::size_t kAttackEventPoolSize = 16;
         struct SyntheticInputState {
-            std::mutex mutex;
-            std::queue<RE::ButtonEvent*> pending;
+            BowInput::MpscRing<RE::ButtonEvent*, kSyntheticInputCapacity> pending;
+
+            // Events handed to the engine by the current poll; recycled once the original call returns.
+            std::array<RE::ButtonEvent*, kSyntheticInputCapacity> inFlight{};
+            std::size_t inFlightCount{0};
         };
 
+        using AttackEventPool = BowInput::EventPool<RE::ButtonEvent, kAttackEventPoolSize>;
+
         SyntheticInputState& GetSyntheticInputState();
-        bool IsTemperingTag(std::string_view inside);
-        void TrimTrailingSpaces(std::string& s);
-        void RemoveChosenTagInplace(std::string& s);
-        void StripTemperingSuffixes(std::string& name);
+        AttackEventPool& GetAttackEventPool();
+        bool IsTemperingTag(std::string_view inside) noexcept;
+        // Length of name once trailing spaces and " (chosen)" / " (<quality>)" suffixes are peeled off, right to left.
+        std::size_t BaseNameLength(std::string_view name) noexcept;
+        // Drops every " (chosen)" occurrence, copying into scratch only when there is one; names that do not fit are
+        // returned unchanged.
+        std::string_view RemoveChosenTags(std::string_view name, std::span<char> scratch) noexcept;
         void ApplyChosenTagToInstance(RE::TESBoundObject* base, RE::ExtraDataList* extra);
         void RemoveChosenTagFromInstance(RE::TESBoundObject* base, RE::ExtraDataList* extra);
-        RE::BSFixedString GetAttackUserEvent();
+        const RE::BSFixedString& GetAttackUserEvent();
         RE::ButtonEvent* MakeAttackButtonEvent(float value, float heldSecs);
         void EnqueueSyntheticAttack(RE::ButtonEvent* ev);
+        [[nodiscard]] bool HasPendingSyntheticInput() noexcept;
         RE::InputEvent* FlushSyntheticInput(RE::InputEvent* head);
+        // Whether ev was injected by the poll in progress (between Flush and Recycle).
+        [[nodiscard]] bool IsSyntheticInput(const RE::InputEvent* ev) noexcept;
+        void RecycleDeliveredSyntheticInput();
         void DispatchAttackButtonEvent(RE::ButtonEvent* ev);
     }
 
@@ -47,6 +65,19 @@ namespace BowState {
         RE::ExtraDataList* extra{nullptr};
     };
 
+    // Worn armor per biped slot; index 0 is slot 30 (head). An armor covering several slots sits in each of them.
+    struct WornSlots {
+        static constexpr std::size_t kCount = 32;
+        std::array<ExtraEquippedItem, kCount> bySlot{};
+    };
+
+    // Everything EnterBowMode reads from the inventory, gathered in one pass and without heap allocations.
+    struct EnterBowScan {
+        WornSlots worn{};
+        std::uint32_t hiddenSlots{0};  // bit i: worn.bySlot[i] is on the hidden list
+        std::int32_t preferredArrowCount{0};
+    };
+
     struct IntegratedBowState {
         ChosenInstance chosenBow{};
         ChosenInstance prevRight{};
@@ -62,7 +93,7 @@ namespace BowState {
         std::vector<ExtraEquippedItem> prevExtraEquipped{};
         RE::TESAmmo* prevAmmo{nullptr};
         bool pendingFinalizeExtras{false};
-        float pendingFinalizeExtrasTimer{0.0f};
+        BowInput::TimerWheel::Handle pendingFinalizeExtrasTimer{BowInput::TimerWheel::kNone};
         RE::TESBoundObject* pendingDesiredRight{nullptr};
         RE::TESBoundObject* pendingDesiredLeft{nullptr};
     };
@@ -113,7 +144,7 @@ namespace BowState {
         st.prevAmmo = nullptr;
 
         st.pendingFinalizeExtras = false;
-        st.pendingFinalizeExtrasTimer = 0.0f;
+        BowInput::Scheduler::Cancel(st.pendingFinalizeExtrasTimer);
         st.pendingDesiredRight = nullptr;
         st.pendingDesiredLeft = nullptr;
 
@@ -129,10 +160,6 @@ namespace BowState {
         st.waitingAutoAttackAfterEquip.store(v, std::memory_order_relaxed);
     }
     inline bool IsWaitingAutoAfterEquip() { return Get().waitingAutoAttackAfterEquip.load(std::memory_order_relaxed); }
-    inline void SetPrevExtraEquipped(std::vector<ExtraEquippedItem>&& items) {
-        auto& st = Get();
-        st.prevExtraEquipped = std::move(items);
-    }
     inline const std::vector<ExtraEquippedItem>& GetPrevExtraEquipped() { return Get().prevExtraEquipped; }
     inline void ClearPrevExtraEquipped() {
         auto& st = Get();
@@ -147,17 +174,17 @@ namespace BowState {
     bool EnsureChosenBowInInventory();
     void SetChosenBow(RE::TESObjectWEAP* bow, RE::ExtraDataList* extra);
     RE::ExtraDataList* FindAnyInstanceExtraForBase(RE::TESBoundObject* base);
-    void CaptureWornArmorSnapshot(std::vector<ExtraEquippedItem>& out);
-    std::vector<ExtraEquippedItem> DiffArmorSnapshot(const std::vector<ExtraEquippedItem>& before,
-                                                     const std::vector<ExtraEquippedItem>& after);
+    void ScanForEnterBowMode(EnterBowScan& out, const RE::TESAmmo* preferredArrow,
+                             std::span<const RE::FormID> hiddenFormIDs);
+    void RecordDisplacedArmor(const WornSlots& before);
     void ReequipPrevExtraEquipped(RE::Actor* actor, RE::ActorEquipManager* equipMgr);
     void AppendPrevExtraEquipped(const ExtraEquippedItem& item);
     bool ContainsPrevExtraEquipped(const ExtraEquippedItem& item);
-    void ApplyHiddenItemsPatch(RE::PlayerCharacter* player, RE::ActorEquipManager* equipMgr,
-                               const std::vector<RE::FormID>& hiddenFormIDs);
+    void ApplyHiddenItemsPatch(RE::PlayerCharacter* player, RE::ActorEquipManager* equipMgr, const WornSlots& worn,
+                               std::uint32_t hiddenSlots);
     RE::TESAmmo* GetPreferredArrow();
     void SetPreferredArrow(RE::TESAmmo* ammo);
     void RestorePrevWeaponsAndAmmo(RE::PlayerCharacter* player, RE::ActorEquipManager* equipMgr,
                                    IntegratedBowState& st);
-    void UpdateDeferredFinalize(RE::PlayerCharacter* player, RE::ActorEquipManager* equipMgr, float dt);
+    void UpdateDeferredFinalize(RE::PlayerCharacter* player, RE::ActorEquipManager* equipMgr);
 }
@@ -115,6 +115,13 @@ namespace {
         static inline std::uintptr_t func{0};
         static void thunk(RE::BSTEventSource<RE::InputEvent*>* a_dispatcher, RE::InputEvent* const* a_events) {
             using namespace BowState::detail;
+            if (!HasPendingSyntheticInput()) {
+                if (func != 0) {
+                    reinterpret_cast<Fn*>(func)(a_dispatcher, a_events);  // NOSONAR
+                }
+                return;
+            }
+
             RE::InputEvent* headBefore = a_events ? *a_events : nullptr;
             RE::InputEvent* headAfter = FlushSyntheticInput(headBefore);
 
@@ -123,6 +130,9 @@ namespace {
                 auto* original = reinterpret_cast<Fn*>(func);  // NOSONAR
                 original(a_dispatcher, arr);
             }
+
+            // The dispatch above is synchronous, so the pooled events are free again.
+            RecycleDeliveredSyntheticInput();
         }
 
         static void Install() {
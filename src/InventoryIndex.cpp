@@ -0,0 +1,192 @@
+#include "InventoryIndex.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "PCH.h"
+
+namespace BowState::Inventory {
+    namespace {
+        struct Index {
+            std::unordered_map<const RE::TESBoundObject*, Entry> entries;
+            std::vector<const Entry*> armor;
+            std::unordered_map<std::uint16_t, std::pair<const RE::TESBoundObject*, RE::ExtraDataList*>> byUniqueId;
+            const RE::InventoryChanges* changes{nullptr};
+            bool dirty{true};
+        };
+
+        Index& Get() {
+            static Index s;  // NOSONAR
+            return s;
+        }
+
+        bool IsIndexed(const RE::TESBoundObject* obj) {
+            if (!obj) return false;
+
+            switch (obj->GetFormType()) {
+                case RE::FormType::Weapon:
+                case RE::FormType::Ammo:
+                case RE::FormType::Armor:
+                case RE::FormType::Light:
+                case RE::FormType::Scroll:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        // Same merge as TESObjectREFR::GetInventory: change entries carry the extra lists and a count delta, the
+        // base container adds its static counts. No entry data is copied.
+        void Rebuild(Index& idx, RE::PlayerCharacter* player) {
+            idx.entries.clear();
+            idx.armor.clear();
+            idx.byUniqueId.clear();
+            idx.changes = player->GetInventoryChanges();
+
+            if (idx.changes && idx.changes->entryList) {
+                for (auto* data : *idx.changes->entryList) {
+                    if (!data || !IsIndexed(data->object)) continue;
+
+                    auto& e = idx.entries[data->object];
+                    e.base = data->object;
+                    e.count += data->countDelta;
+                    if (!data->extraLists) continue;
+
+                    for (auto* x : *data->extraLists) {
+                        if (!x) continue;
+
+                        e.extras.push_back(x);
+                        if (auto const* uid = x->GetByType<RE::ExtraUniqueID>()) {
+                            idx.byUniqueId.insert_or_assign(uid->uniqueID, std::pair{data->object, x});
+                        }
+                    }
+                }
+            }
+
+            if (auto* container = player->GetContainer()) {
+                container->ForEachContainerObject([&idx](RE::ContainerObject& obj) {
+                    if (IsIndexed(obj.obj)) {
+                        auto& e = idx.entries[obj.obj];
+                        e.base = obj.obj;
+                        e.count += obj.count;
+                    }
+                    return RE::BSContainer::ForEachResult::kContinue;
+                });
+            }
+
+            for (auto const& [base, e] : idx.entries) {
+                if (base->IsArmor()) idx.armor.push_back(&e);
+            }
+            idx.dirty = false;
+        }
+
+        Index* Current() {
+            auto& idx = Get();
+            auto* player = RE::PlayerCharacter::GetSingleton();
+            if (!player) {
+                idx.dirty = true;
+                return nullptr;
+            }
+
+            if (idx.dirty || idx.changes != player->GetInventoryChanges()) {
+                Rebuild(idx, player);
+            }
+            return &idx;
+        }
+
+        class ChangeSink final : public RE::BSTEventSink<RE::TESContainerChangedEvent>,
+                                 public RE::BSTEventSink<RE::TESEquipEvent> {
+        public:
+            static ChangeSink* GetSingleton() {
+                static ChangeSink s;  // NOSONAR
+                return &s;
+            }
+
+            RE::BSEventNotifyControl ProcessEvent(const RE::TESContainerChangedEvent* ev,
+                                                  RE::BSTEventSource<RE::TESContainerChangedEvent>*) override {
+                if (!ev) return RE::BSEventNotifyControl::kContinue;
+
+                auto const* player = RE::PlayerCharacter::GetSingleton();
+                if (!player) return RE::BSEventNotifyControl::kContinue;
+
+                const auto id = player->GetFormID();
+                if (ev->oldContainer != id && ev->newContainer != id) return RE::BSEventNotifyControl::kContinue;
+
+                // Most of a hoarder's pickups (misc items, potions, ingredients) are bases the index does not hold.
+                auto const* base = RE::TESForm::LookupByID<RE::TESBoundObject>(ev->baseObj);
+                if (!base || IsIndexed(base)) Invalidate();
+                return RE::BSEventNotifyControl::kContinue;
+            }
+
+            // Equipping splits and merges extra lists without any container change.
+            RE::BSEventNotifyControl ProcessEvent(const RE::TESEquipEvent* ev,
+                                                  RE::BSTEventSource<RE::TESEquipEvent>*) override {
+                if (ev && ev->actor && ev->actor.get() == RE::PlayerCharacter::GetSingleton()) {
+                    Invalidate();
+                }
+                return RE::BSEventNotifyControl::kContinue;
+            }
+
+        private:
+            ChangeSink() = default;
+        };
+    }
+
+    const Entry* Find(const RE::TESBoundObject* base) {
+        if (!base) return nullptr;
+
+        auto const* idx = Current();
+        if (!idx) return nullptr;
+
+        const auto it = idx->entries.find(base);
+        return it != idx->entries.end() ? &it->second : nullptr;
+    }
+
+    std::span<const Entry* const> Armor() {
+        auto const* idx = Current();
+        if (!idx) return {};
+        return idx->armor;
+    }
+
+    // Callers tag and equip the result, so a hit is confirmed against the live lists; a stale one rebuilds and retries.
+    RE::ExtraDataList* FindUnique(const RE::TESBoundObject* base, std::uint16_t uniqueId) {
+        if (!base || uniqueId == 0) return nullptr;
+
+        for (int attempt = 0; attempt < 2; ++attempt) {
+            auto const* idx = Current();
+            if (!idx) return nullptr;
+
+            const auto it = idx->byUniqueId.find(uniqueId);
+            if (it == idx->byUniqueId.end() || it->second.first != base) return nullptr;
+            if (IsLive(base, it->second.second)) return it->second.second;
+        }
+        return nullptr;
+    }
+
+    bool IsLive(const RE::TESBoundObject* base, const RE::ExtraDataList* extra) {
+        if (!base || !extra) return false;
+
+        auto* player = RE::PlayerCharacter::GetSingleton();
+        auto* changes = player ? player->GetInventoryChanges() : nullptr;
+        if (changes && changes->entryList) {
+            for (auto* data : *changes->entryList) {
+                if (!data || data->object != base || !data->extraLists) continue;
+                if (std::ranges::find(*data->extraLists, extra) != data->extraLists->end()) return true;
+            }
+        }
+
+        Invalidate();
+        return false;
+    }
+
+    void Invalidate() noexcept { Get().dirty = true; }
+
+    void Register() {
+        auto* holder = RE::ScriptEventSourceHolder::GetSingleton();
+        if (!holder) return;
+
+        auto* sink = ChangeSink::GetSingleton();
+        holder->AddEventSink<RE::TESContainerChangedEvent>(sink);
+        holder->AddEventSink<RE::TESEquipEvent>(sink);
+    }
+}
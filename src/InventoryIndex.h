@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace RE {
+    class TESBoundObject;
+    class ExtraDataList;
+}
+
+// Player inventory view for the bases bow mode touches (weapons, ammo, armor, lights, scrolls), keyed by base.
+// Built in one pass over the inventory changes plus the base container, the first time it is queried after a
+// container change, an equip or a game load marked it stale; queries in between are a hash lookup. Main thread
+// only. The index hears about a stack merge or split only when the event arrives, which can be after code holding
+// one of its extra-list pointers runs: read through them freely, but check IsLive before writing through one.
+namespace BowState::Inventory {
+    struct Entry {
+        RE::TESBoundObject* base{nullptr};
+        std::int32_t count{0};
+        std::vector<RE::ExtraDataList*> extras;
+    };
+
+    [[nodiscard]] const Entry* Find(const RE::TESBoundObject* base);
+    [[nodiscard]] std::span<const Entry* const> Armor();
+
+    // Instance of base carrying the given ExtraUniqueID, or nullptr. Unique IDs are per container, so this is a single
+    // hash lookup.
+    [[nodiscard]] RE::ExtraDataList* FindUnique(const RE::TESBoundObject* base, std::uint16_t uniqueId);
+
+    // Whether extra is still one of base's lists in the live InventoryChanges (walked directly, not the index). A miss
+    // marks the index stale.
+    [[nodiscard]] bool IsLive(const RE::TESBoundObject* base, const RE::ExtraDataList* extra);
+
+    void Invalidate() noexcept;
+
+    // Hooks the container-changed and equip event sources; call once the data handler is up.
+    void Register();
+}
@@ -0,0 +1,50 @@
+#include "AnimTags.h"
+
+namespace BowInput {
+    namespace {
+        constexpr std::array<std::string_view, static_cast<std::size_t>(AnimTag::Count)> kNames{
+            "", "EnableBumper", "WeaponSheathe", "bowReset", "arrowAttach"};
+
+        struct InternedTags {
+            std::array<RE::BSFixedString, static_cast<std::size_t>(AnimTag::Count)> strings{};
+
+            InternedTags() {
+                for (std::size_t i = 1; i < kNames.size(); ++i) {
+                    strings[i] = RE::BSFixedString{kNames[i]};
+                }
+            }
+        };
+
+        const InternedTags& Interned() {
+            static const InternedTags s;  // NOSONAR
+            return s;
+        }
+
+        AnimTagHits& MutableHits() noexcept {
+            static AnimTagHits s{};  // NOSONAR
+            return s;
+        }
+    }
+
+    AnimTag AnimTags::Classify(const RE::BSFixedString& tag) noexcept {
+        const char* p = tag.data();
+        if (!p) return AnimTag::None;
+
+        const auto& interned = Interned().strings;
+        for (std::size_t i = 1; i < interned.size(); ++i) {
+            if (p == interned[i].data()) return static_cast<AnimTag>(i);
+        }
+        return AnimTag::None;
+    }
+
+    std::string_view AnimTags::Name(AnimTag tag) noexcept {
+        const auto i = static_cast<std::size_t>(tag);
+        return i < kNames.size() ? kNames[i] : std::string_view{};
+    }
+
+    void AnimTags::CountHit(AnimTag tag) noexcept {
+        MutableHits()[static_cast<std::size_t>(tag)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const AnimTagHits& AnimTags::Hits() noexcept { return MutableHits(); }
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+
+#include "RE/B/BSFixedString.h"
+
+namespace BowInput {
+    enum class AnimTag : std::uint8_t {
+        None = 0,
+        EnableBumper,
+        WeaponSheathe,
+        BowReset,
+        ArrowAttach,
+        Count
+    };
+
+    using AnimTagHits = std::array<std::atomic<std::uint64_t>, static_cast<std::size_t>(AnimTag::Count)>;
+
+    struct AnimTags {
+        // Graph event tags live in the engine string pool, so the tags we react to are matched by pointer;
+        // everything else is None without touching the characters.
+        [[nodiscard]] static AnimTag Classify(const RE::BSFixedString& tag) noexcept;
+        [[nodiscard]] static std::string_view Name(AnimTag tag) noexcept;
+
+        static void CountHit(AnimTag tag) noexcept;
+        [[nodiscard]] static const AnimTagHits& Hits() noexcept;
+    };
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// One summary word with a bit per subsystem that still has per-frame work queued. ProcessEvent skips the
+// whole pipeline when the word is zero and no button touched the hotkey combo. Subsystems arm their bit
+// whenever they schedule work and their pump clears it once they are idle again, so a stale bit only ever
+// costs one extra full frame.
+namespace BowInput::Armed {
+    enum class Bit : std::uint32_t {
+        Hotkey = 1u << 0,
+        SmartPending = 1u << 1,
+        ExitPending = 1u << 2,
+        AttackHold = 1u << 3,
+        PostExitAttack = 1u << 4,
+        DeferredFinalize = 1u << 5,
+        Timers = 1u << 6,
+    };
+
+    inline std::atomic<std::uint32_t>& Word() noexcept {
+        static std::atomic<std::uint32_t> s{0};  // NOSONAR
+        return s;
+    }
+
+    inline void Arm(Bit b) noexcept { Word().fetch_or(static_cast<std::uint32_t>(b), std::memory_order_relaxed); }
+
+    inline void Disarm(Bit b) noexcept {
+        Word().fetch_and(~static_cast<std::uint32_t>(b), std::memory_order_relaxed);
+    }
+
+    // One read-modify-write either way, so a concurrent Arm of another bit (or of this one, from a hook) is never
+    // lost. Only the bit's owner calls this, at the point of its frame where it recomputes the bit from its own state.
+    inline void Set(Bit b, bool armed) noexcept {
+        if (armed) {
+            Arm(b);
+        } else {
+            Disarm(b);
+        }
+    }
+
+    [[nodiscard]] inline bool Any() noexcept { return Word().load(std::memory_order_relaxed) != 0; }
+}
@@ -1,78 +1,75 @@
 #include "BowInputHandler.h"
 
 #include <atomic>
-#include <chrono>
-#include <ranges>
+#include <string>
 #include <string_view>
+#include <utility>
 
 #include "../PCH.h"
-#include "../config/BowConfig.h"
-#include "../patchs/SkipEquipController.h"
-#include "BowInputTiming.h"
+#include "../config/ConfigSnapshot.h"
+#include "ArmedState.h"
 #include "BowModeController.h"
+#include "FrameClock.h"
 #include "HotkeyDetector.h"
+#include "HotkeyPattern.h"
 #include "InputGate.h"
 #include "InputState.h"
-using namespace BowInput::Timing;
+#include "InputTrace.h"
+#include "StageProfiler.h"
+#include "TimerWheel.h"
+#include "TransformWatcher.h"
 
 using namespace std::literals;
 
 namespace BowInput {
     namespace {
-        inline std::uint64_t NowMs() noexcept {
-            using clock = std::chrono::steady_clock;
-            return static_cast<std::uint64_t>(
-                std::chrono::duration_cast<std::chrono::milliseconds>(clock::now().time_since_epoch()).count());
-        }
-
-        inline bool HasTransformArchetype(const RE::MagicItem* item) {
-            if (!item) return false;
+        struct CaptureState {
+            std::atomic_bool requested{false};
+            std::atomic_int capturedEncoded{-1};
+        };
 
-            using ArchetypeID = RE::EffectArchetypes::ArchetypeID;
+        CaptureState g_capture;  // NOSONAR
 
-            return std::ranges::any_of(item->effects, [](const auto* effect) {
-                if (!effect || !effect->baseEffect) return false;
-                const auto arch = effect->baseEffect->GetArchetype();
-                return arch == ArchetypeID::kWerewolf || arch == ArchetypeID::kVampireLord;
-            });
+        HotkeyConfig MakeDefaultHotkeyConfig() {
+            HotkeyConfig hk{.bowKeyScanCodes = {0x2F, -1, -1}, .bowPadButtons = {-1, -1, -1}};
+            HotkeyDetector::CompileKeyboard(hk);
+            HotkeyDetector::CompileGamepad(hk);
+            return hk;
         }
 
-        inline const std::vector<RE::SpellItem*>& GetTransformPowers() {
-            static std::vector<RE::SpellItem*> s_powers;  // NOSONAR
-            if (!s_powers.empty()) return s_powers;
+        HotkeyConfig g_hotkeyConfig = MakeDefaultHotkeyConfig();  // NOSONAR
 
-            auto* dh = RE::TESDataHandler::GetSingleton();
-            if (!dh) return s_powers;
+        HotkeyRuntime g_hotkeyRuntime;  // NOSONAR
 
-            auto const& spells = dh->GetFormArray<RE::SpellItem>();
-            s_powers.reserve(spells.size());
+        FrameCounters g_frameCounters;  // NOSONAR
 
-            for (auto* spell : spells) {
-                if (!spell) continue;
-                if (spell->GetSpellType() != RE::MagicSystem::SpellType::kPower) continue;
-                if (HasTransformArchetype(spell)) s_powers.push_back(spell);
-            }
-            return s_powers;
-        }
+        // Settings pinned for the length of ProcessEvent, so every stage of the frame sees the same Apply. Null
+        // outside it and on any other thread.
+        thread_local const IntegratedBow::ConfigSnapshot* t_frameConfig = nullptr;  // NOSONAR
 
-        inline bool IsCurrentTransformPower(RE::Actor* actor) {
-            if (!actor) return false;
-            for (auto* power : GetTransformPowers()) {
-                if (actor->IsCurrentShout(power)) return true;
-            }
-            return false;
-        }
+        class FramePin {
+        public:
+            FramePin() noexcept { t_frameConfig = _ref.get(); }
+            ~FramePin() { t_frameConfig = nullptr; }
 
-        struct CaptureState {
-            std::atomic_bool requested{false};
-            std::atomic_int capturedEncoded{-1};
-        };
+            FramePin(const FramePin&) = delete;
+            FramePin& operator=(const FramePin&) = delete;
 
-        CaptureState g_capture;  // NOSONAR
+            [[nodiscard]] const IntegratedBow::ConfigSnapshot* operator->() const noexcept { return _ref.get(); }
 
-        HotkeyConfig g_hotkeyConfig{.bowKeyScanCodes = {0x2F, -1, -1}, .bowPadButtons = {-1, -1, -1}};  // NOSONAR
+        private:
+            IntegratedBow::ConfigRef _ref;
+        };
 
-        HotkeyRuntime g_hotkeyRuntime;  // NOSONAR
+        // Only the input thread writes the counters, so a plain load/store avoids a locked add per frame.
+        inline void Bump(std::atomic<std::uint64_t>& counter) noexcept {
+            counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+
+        inline void SuppressHotkeyUntilReleased() noexcept {
+            g_hotkeyRuntime.suppressUntilReleased = true;
+            Armed::Arm(Armed::Bit::Hotkey);
+        }
     }
 
     BowInputHandler* BowInputHandler::GetSingleton() {
@@ -80,8 +77,8 @@ namespace BowInput {
         return &s_instance;
     }
 
-    void BowInputHandler::ProcessOneButton(const RE::ButtonEvent* button, RE::PlayerCharacter* player) const {
-        if (!button || !player) return;
+    bool BowInputHandler::ProcessOneButton(const RE::ButtonEvent* button, RE::PlayerCharacter* player) const {
+        if (!button || !player) return false;
 
         const auto dev = button->GetDevice();
         const auto code = static_cast<int>(button->idCode);
@@ -89,51 +86,54 @@ namespace BowInput {
         const bool isDownEdge = button->IsDown();
         const bool isUpEdge = button->IsUp();
 
+        if (InputTrace::Enabled()) {
+            InputTrace::RecordButton(std::to_underlying(dev), code, isPressed, isDownEdge, isUpEdge,
+                                     button->HeldDuration(), button->QUserEvent().c_str(),
+                                     BowState::detail::IsSyntheticInput(button));
+        }
+
         Inputs().OnButton(dev, code, isPressed, isDownEdge, isUpEdge);
 
+        const bool comboKey =
+            HotkeyDetector::OnButton(g_hotkeyConfig, g_hotkeyRuntime, dev, code, isPressed, isDownEdge, isUpEdge,
+                                     FrameClock::NowMs(), t_frameConfig->requireExclusiveHotkeyPatch);
+
         if (g_capture.requested.load(std::memory_order_relaxed)) {
             if (isDownEdge) {
                 g_capture.capturedEncoded.store(InputUtil::EncodeCapture(dev, code), std::memory_order_relaxed);
                 g_capture.requested.store(false, std::memory_order_relaxed);
             }
-            return;
+            return comboKey;
         }
 
-        if (!isDownEdge && !isUpEdge) return;
+        if (!isDownEdge && !isUpEdge) return comboKey;
 
-        const auto& ue = button->QUserEvent();
+        const UserEventKind kind = InputGate::ClassifyUserEvent(button->QUserEvent());
         auto& ctrl = BowModeController::Get();
 
         {
-            auto const& cfg = IntegratedBow::GetBowConfig();
+            auto const& cfg = *t_frameConfig;
             const bool isMouse = (dev == RE::INPUT_DEVICE::kMouse);
             const bool isGp = (dev == RE::INPUT_DEVICE::kGamepad);
 
-            if (cfg.cancelHoldExitDelayOnAttackPatch.load(std::memory_order_relaxed) && button->IsDown() &&
-                (isMouse || isGp) && InputGate::IsAttackEvent(ue) && ctrl.IsInHoldAutoExitDelay() &&
+            if (cfg.cancelHoldExitDelayOnAttackPatch && button->IsDown() &&
+                (isMouse || isGp) && kind == UserEventKind::Attack && ctrl.IsInHoldAutoExitDelay() &&
                 !ctrl.AttackHold().active.load(std::memory_order_relaxed)) {
                 ctrl.CompleteExit();
-                g_hotkeyRuntime.suppressUntilReleased = true;
-
-                const std::uint64_t now = NowMs();
-                auto& pea = ctrl.PostExitAttack();
-                pea.pending = true;
-                pea.stage = 0;
-                pea.downAtMs = now + kPostExitAttackDownDelayMs;
-                pea.upAtMs = pea.downAtMs + kPostExitAttackTapMs;
-                return;
+                SuppressHotkeyUntilReleased();
+                ctrl.SchedulePostExitAttackTap();
+                return true;
             }
         }
 
-        if (ue == "Shout"sv && button->IsDown() && IsCurrentTransformPower(player)) {
-            ctrl.ForceImmediateExit();
-            g_hotkeyRuntime.suppressUntilReleased = true;
-            return;
+        if (kind == UserEventKind::Shout && button->IsDown() && TransformWatcher::IsCurrentTransformPower(player)) {
+            ForceExitBowMode();
+            return true;
         }
 
-        if (ue == "Ready Weapon"sv && button->IsDown()) {
+        if (kind == UserEventKind::ReadyWeapon && button->IsDown()) {
             const auto& bowSt = BowState::Get();
-            const std::uint64_t now = NowMs();
+            const std::uint64_t now = FrameClock::NowMs();
             const std::uint64_t lastHotkey = ctrl.lastHotkeyPressMs.load(std::memory_order_relaxed);
             const bool nearHotkey = (lastHotkey != 0) && (now - lastHotkey) < 250;
 
@@ -144,27 +144,20 @@ namespace BowInput {
                 ctrl.sheathRequestedByPlayer.store(true, std::memory_order_relaxed);
             }
         }
+
+        return comboKey;
     }
 
-    void BowInputHandler::ProcessButtonEvents(RE::InputEvent* const* a_events, RE::PlayerCharacter* player) const {
-        if (!a_events) return;
+    bool BowInputHandler::ProcessButtonEvents(RE::InputEvent* const* a_events, RE::PlayerCharacter* player) const {
+        if (!a_events) return false;
+
+        bool comboEdge = false;
         for (auto* e = *a_events; e; e = e->next) {
             if (auto const* btn = e->AsButtonEvent()) {
-                ProcessOneButton(btn, player);
+                comboEdge |= ProcessOneButton(btn, player);
             }
         }
-    }
-
-    float BowInputHandler::CalculateDeltaTime() {
-        using clock = std::chrono::steady_clock;
-        static clock::time_point s_last = clock::now();  // NOSONAR
-
-        const auto now = clock::now();
-        float dt = std::chrono::duration<float>(now - s_last).count();
-        s_last = now;
-
-        if (dt < 0.0f || dt > 0.5f) dt = 0.0f;
-        return dt;
+        return comboEdge;
     }
 
     RE::BSEventNotifyControl BowInputHandler::ProcessEvent(RE::InputEvent* const* a_events,
@@ -174,52 +167,64 @@ namespace BowInput {
         auto* player = RE::PlayerCharacter::GetSingleton();
         if (!player) return RE::BSEventNotifyControl::kContinue;
 
-        const float dt = CalculateDeltaTime();
-        auto& ctrl = BowModeController::Get();
-        const bool blocked = InputGate::IsInputBlockedByMenus();
+        FrameClock::BeginFrame();
+        const float dt = FrameClock::Dt();
+        const FramePin frameConfig;
+
+        if (InputTrace::Enabled()) {
+            InputTrace::RecordFrame(dt);
+        }
 
-        ctrl.UpdateUnequipGate();
+        using Profiler::Stage;
+        using Profiler::Timed;
 
-        ProcessButtonEvents(a_events, player);
+        const bool comboEdge = Timed(Stage::Buttons, [&] { return ProcessButtonEvents(a_events, player); });
 
-        const bool requireExclusive =
-            IntegratedBow::GetBowConfig().requireExclusiveHotkeyPatch.load(std::memory_order_relaxed);
+        if (!comboEdge && !Armed::Any()) {
+            Bump(g_frameCounters.fastPath);
+            return RE::BSEventNotifyControl::kContinue;
+        }
+        Bump(g_frameCounters.fullPath);
 
-        HotkeyDetector::Tick(player, dt, g_hotkeyConfig, Inputs(), requireExclusive, blocked, ctrl.hotkeyDown,
-                             g_hotkeyRuntime, ctrl);
+        auto& ctrl = BowModeController::Get();
+        const bool blocked = Timed(Stage::MenuGate, [] { return InputGate::IsInputBlockedByMenus(); });
 
-        ctrl.UpdateSmartMode(player, dt);
-        if (ctrl.UpdateExitPending(dt)) {
-            g_hotkeyRuntime.suppressUntilReleased = true;
+        Timed(Stage::Timers, [] { Scheduler::Advance(); });
+
+        const bool requireExclusive = frameConfig->requireExclusiveHotkeyPatch;
+
+        Timed(Stage::HotkeyTick, [&] {
+            HotkeyDetector::Tick(player, dt, FrameClock::NowMs(), g_hotkeyConfig, Inputs(), requireExclusive,
+                                 blocked, ctrl.hotkeyDown, g_hotkeyRuntime, ctrl);
+        });
+
+        Timed(Stage::SmartMode, [&] { ctrl.UpdateSmartMode(player, dt); });
+        if (Timed(Stage::ExitPending, [&] { return ctrl.UpdateExitPending(); })) {
+            SuppressHotkeyUntilReleased();
             g_hotkeyRuntime.prevRawKbComboDown = false;
             g_hotkeyRuntime.prevRawGpComboDown = false;
             g_hotkeyRuntime.exclusivePendingSrc = 0;
             g_hotkeyRuntime.exclusivePendingTimer = 0.0f;
         }
-        ctrl.PumpPostExitAttackTap();
-        ctrl.PumpAttackHold(dt);
-
-        if (ctrl.fakeEnableBumperAtMs != 0 && NowMs() >= ctrl.fakeEnableBumperAtMs) {
-            ctrl.fakeEnableBumperAtMs = 0;
-
-            if (BowState::IsWaitingAutoAfterEquip() && BowState::IsUsingBow()) {
-                ctrl.OnAnimEvent("EnableBumper", player);
-            }
-        }
-
-        IntegratedBow::SkipEquipController::Tick();
+        Timed(Stage::AttackPumps, [&] {
+            ctrl.PumpPostExitAttackTap();
+            ctrl.PumpAttackHold(dt);
+        });
 
         if (auto* equipMgr = RE::ActorEquipManager::GetSingleton()) {
-            BowState::UpdateDeferredFinalize(player, equipMgr, dt);
+            Timed(Stage::DeferredFinalize, [&] { BowState::UpdateDeferredFinalize(player, equipMgr); });
         }
 
         return RE::BSEventNotifyControl::kContinue;
     }
 
+    const IntegratedBow::ConfigSnapshot* FrameConfig() noexcept { return t_frameConfig; }
+
     void RegisterInputHandler() {
         if (auto* mgr = RE::BSInputDeviceManager::GetSingleton()) {
             mgr->AddEventSink(BowInputHandler::GetSingleton());
         }
+        InputGate::RegisterMenuWatcher();
     }
 
     void SetMode(int mode) {
@@ -247,6 +252,7 @@ namespace BowInput {
 
     void SetKeyScanCodes(int k1, int k2, int k3) {
         g_hotkeyConfig.bowKeyScanCodes = {k1, k2, k3};
+        HotkeyDetector::CompileKeyboard(g_hotkeyConfig);
 
         auto& ctrl = BowModeController::Get();
         ctrl.hotkeyDown = false;
@@ -257,6 +263,7 @@ namespace BowInput {
 
     void SetGamepadButtons(int b1, int b2, int b3) {
         g_hotkeyConfig.bowPadButtons = {b1, b2, b3};
+        HotkeyDetector::CompileGamepad(g_hotkeyConfig);
 
         auto& ctrl = BowModeController::Get();
         ctrl.hotkeyDown = false;
@@ -265,6 +272,26 @@ namespace BowInput {
         g_hotkeyRuntime.exclusivePendingTimer = 0.0f;
     }
 
+    bool SetHotkeyPattern(std::string_view text) {
+        HotkeyPattern compiled{};
+        if (!text.empty()) {
+            std::string error;
+            if (!HotkeyPattern::Compile(text, compiled, error)) {
+                spdlog::warn("[INTEGRATEDBOW][Input] Ignoring HotkeyPattern '{}': {}", text, error);
+                return false;
+            }
+            spdlog::info("[INTEGRATEDBOW][Input] HotkeyPattern '{}' compiled to {} states", text,
+                         compiled.next.size());
+        }
+
+        g_hotkeyConfig.pattern = std::move(compiled);
+
+        auto& ctrl = BowModeController::Get();
+        ctrl.hotkeyDown = false;
+        PatternEngine::Reset(g_hotkeyRuntime.pattern);
+        return true;
+    }
+
     void RequestGamepadCapture() {
         g_capture.requested.store(true, std::memory_order_relaxed);
         g_capture.capturedEncoded.store(-1, std::memory_order_relaxed);
@@ -278,30 +305,32 @@ namespace BowInput {
         return -1;
     }
 
+    const FrameCounters& GetFrameCounters() noexcept { return g_frameCounters; }
+
     bool IsHotkeyDown() { return BowModeController::Get().hotkeyDown; }
 
     bool IsUnequipAllowed() noexcept { return BowModeController::Get().allowUnequip.load(std::memory_order_relaxed); }
 
-    void BlockUnequipForMs(std::uint64_t ms) noexcept {
-        auto& ctrl = BowModeController::Get();
-        ctrl.allowUnequip.store(false, std::memory_order_relaxed);
-        ctrl.allowUnequipReenableMs.store(NowMs() + ms, std::memory_order_relaxed);
-    }
+    void BlockUnequipForMs(std::uint64_t ms) noexcept { BowModeController::Get().BlockUnequipFor(ms); }
 
-    void ForceAllowUnequip() noexcept {
-        auto& ctrl = BowModeController::Get();
-        ctrl.allowUnequip.store(true, std::memory_order_relaxed);
-        ctrl.allowUnequipReenableMs.store(0, std::memory_order_relaxed);
+    void ForceExitBowMode() {
+        BowModeController::Get().ForceImmediateExit();
+        SuppressHotkeyUntilReleased();
     }
 
+    void ForceAllowUnequip() noexcept { BowModeController::Get().AllowUnequip(); }
+
     void HandleAnimEvent(const RE::BSAnimationGraphEvent* ev, RE::BSTEventSource<RE::BSAnimationGraphEvent>*) {
         if (!ev || !ev->holder) return;
 
+        const AnimTag tag = AnimTags::Classify(ev->tag);
+        if (tag == AnimTag::None) return;
+
         auto* actor = ev->holder->As<RE::Actor>();
         auto* player = RE::PlayerCharacter::GetSingleton();
         if (!actor || actor != player) return;
 
-        const std::string_view tag{ev->tag.c_str(), ev->tag.size()};
+        AnimTags::CountHit(tag);
         BowModeController::Get().OnAnimEvent(tag, player);
     }
 
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
+#include <string_view>
 
 namespace RE {
     template <class T>
@@ -11,16 +13,32 @@ namespace RE {
     struct BSAnimationGraphEvent;
 }
 
+namespace IntegratedBow {
+    struct ConfigSnapshot;
+}
+
 namespace BowInput {
 
+    struct FrameCounters {
+        std::atomic<std::uint64_t> fastPath{0};
+        std::atomic<std::uint64_t> fullPath{0};
+    };
+
     void RegisterInputHandler();
 
+    // The config snapshot pinned for the input frame being processed, or null outside ProcessEvent. Code that also
+    // runs from other threads falls back to IntegratedBow::CurrentConfig().
+    [[nodiscard]] const IntegratedBow::ConfigSnapshot* FrameConfig() noexcept;
+
     void SetMode(int mode);
 
     void SetKeyScanCodes(int k1, int k2, int k3);
 
     void SetGamepadButtons(int b1, int b2, int b3);
 
+    // Empty text clears the pattern and goes back to the key/button chords. Returns false if it did not parse.
+    bool SetHotkeyPattern(std::string_view text);
+
     void RequestGamepadCapture();
 
     int PollCapturedGamepadButton();
@@ -33,6 +51,11 @@ namespace BowInput {
 
     void ForceAllowUnequip() noexcept;
 
+    // Leaves bow mode immediately (transformations) and ignores the hotkey until it is released.
+    void ForceExitBowMode();
+
+    [[nodiscard]] const FrameCounters& GetFrameCounters() noexcept;
+
     void HandleAnimEvent(const RE::BSAnimationGraphEvent* ev, RE::BSTEventSource<RE::BSAnimationGraphEvent>* src);
 
     class BowInputHandler final : public RE::BSTEventSink<RE::InputEvent*> {
@@ -45,9 +68,8 @@ namespace BowInput {
     private:
         BowInputHandler() = default;
 
-        void ProcessButtonEvents(RE::InputEvent* const* a_events, RE::PlayerCharacter* player) const;
-        void ProcessOneButton(const RE::ButtonEvent* button, RE::PlayerCharacter* player) const;
-        [[nodiscard]] static float CalculateDeltaTime();
+        [[nodiscard]] bool ProcessButtonEvents(RE::InputEvent* const* a_events, RE::PlayerCharacter* player) const;
+        [[nodiscard]] bool ProcessOneButton(const RE::ButtonEvent* button, RE::PlayerCharacter* player) const;
     };
 
 }
\ No newline at end of file
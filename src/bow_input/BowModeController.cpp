@@ -1,15 +1,19 @@
 #include "BowModeController.h"
 
-#include <chrono>
 #include <string_view>
 
 #include "../PCH.h"
 #include "../config/BowConfig.h"
+#include "../config/ConfigSnapshot.h"
 #include "../patchs/HiddenItemsPatch.h"
 #include "../patchs/SkipEquipController.h"
+#include "ArmedState.h"
+#include "BowInputHandler.h"
 #include "BowInputTiming.h"
 #include "BowState.h"
+#include "FrameClock.h"
 #include "InputGate.h"
+#include "TimerWheel.h"
 using namespace BowInput::Timing;
 
 using namespace std::literals;
@@ -18,18 +22,16 @@ namespace BowInput {
     namespace {
         constexpr float kSmartClickThreshold = 0.18f;
 
-        inline std::uint64_t NowMs() noexcept {
-            using clock = std::chrono::steady_clock;
-            return static_cast<std::uint64_t>(
-                std::chrono::duration_cast<std::chrono::milliseconds>(clock::now().time_since_epoch()).count());
-        }
-
+        // The input frame's pinned snapshot when called from it; anything else (SKSE tasks, anim events) takes its
+        // own reference for the one read.
         inline bool IsAutoDrawEnabled() {
-            return IntegratedBow::GetBowConfig().autoDrawEnabled.load(std::memory_order_relaxed);
+            if (auto const* frame = FrameConfig()) return frame->autoDrawEnabled;
+            return IntegratedBow::CurrentConfig()->autoDrawEnabled;
         }
 
         inline float GetSheathedDelayMs() {
-            float secs = IntegratedBow::GetBowConfig().sheathedDelaySeconds.load(std::memory_order_relaxed);
+            auto const* frame = FrameConfig();
+            float secs = frame ? frame->sheathedDelaySeconds : IntegratedBow::CurrentConfig()->sheathedDelaySeconds;
             if (secs < 0.0f) secs = 0.0f;
             return secs * 1000.0f;
         }
@@ -49,16 +51,32 @@ namespace BowInput {
         if (hotkeyDown) return false;
         if (!IsAutoDrawEnabled()) return false;
 
-        const auto target = static_cast<float>(exit_.delayMs);
-        return exit_.delayTimer < target;
+        return exit_.waitForEquip || Scheduler::IsPending(exit_.delayTimer);
+    }
+
+    void BowModeController::BlockUnequipFor(std::uint64_t ms) noexcept {
+        allowUnequip.store(false, std::memory_order_relaxed);
+        Scheduler::Cancel(allowUnequipTimer);
+        allowUnequipTimer = Scheduler::After(ms, &OnUnequipGateDue);
     }
 
-    void BowModeController::UpdateUnequipGate() noexcept {
-        if (allowUnequip.load(std::memory_order_relaxed)) return;
+    void BowModeController::AllowUnequip() noexcept {
+        Scheduler::Cancel(allowUnequipTimer);
+        allowUnequip.store(true, std::memory_order_relaxed);
+    }
 
-        const std::uint64_t until = allowUnequipReenableMs.load(std::memory_order_relaxed);
-        if (until != 0 && NowMs() >= until) {
-            allowUnequip.store(true, std::memory_order_relaxed);
+    void BowModeController::OnUnequipGateDue(std::uintptr_t) {
+        auto& ctrl = Get();
+        ctrl.allowUnequipTimer = TimerWheel::kNone;
+        ctrl.allowUnequip.store(true, std::memory_order_relaxed);
+    }
+
+    void BowModeController::OnFakeEnableBumperDue(std::uintptr_t) {
+        auto& ctrl = Get();
+        ctrl.fakeEnableBumperTimer = TimerWheel::kNone;
+
+        if (BowState::IsWaitingAutoAfterEquip() && BowState::IsUsingBow()) {
+            ctrl.OnAnimEvent(AnimTag::EnableBumper, RE::PlayerCharacter::GetSingleton());
         }
     }
 
@@ -68,6 +86,7 @@ namespace BowInput {
             if (!blocked) {
                 mode_.smartPending = true;
                 mode_.smartTimer = 0.0f;
+                Armed::Arm(Armed::Bit::SmartPending);
             } else {
                 mode_.smartPending = false;
                 mode_.smartTimer = 0.0f;
@@ -100,7 +119,10 @@ namespace BowInput {
     }
 
     void BowModeController::UpdateSmartMode(RE::PlayerCharacter* player, float dt) {
-        if (!mode_.smartMode || !mode_.smartPending || !hotkeyDown) return;
+        if (!mode_.smartMode || !mode_.smartPending || !hotkeyDown) {
+            Armed::Disarm(Armed::Bit::SmartPending);
+            return;
+        }
 
         mode_.smartTimer += dt;
 
@@ -108,6 +130,7 @@ namespace BowInput {
             mode_.smartPending = false;
             mode_.smartTimer = 0.0f;
             mode_.holdMode = true;
+            Armed::Disarm(Armed::Bit::SmartPending);
 
             if (!InputGate::IsInputBlockedByMenus()) {
                 OnKeyPressed(player);
@@ -115,47 +138,41 @@ namespace BowInput {
         }
     }
 
-    bool BowModeController::UpdateExitPending(float dt) {
-        if (!exit_.pending) return false;
-
-        if (exit_.waitForEquip && !BowState::IsBowEquipped()) {
-            UpdateExitEquipWait(dt);
+    // Only the equip wait is polled; the wait timeout and the sheathe delay run on the scheduler and re-arm the
+    // ExitPending bit when they fire, so the exit completes on the same frame.
+    bool BowModeController::UpdateExitPending() {
+        if (!exit_.pending) {
+            Armed::Disarm(Armed::Bit::ExitPending);
             return false;
         }
 
-        if (IsExitDelayReady(dt)) {
-            CompleteExit();
-            return true;
+        if (exit_.waitForEquip) {
+            if (!BowState::IsBowEquipped()) return false;
+
+            exit_.waitForEquip = false;
+            Scheduler::Cancel(exit_.waitEquipTimer);
+            BeginExitDelay();
+        }
+
+        if (Scheduler::IsPending(exit_.delayTimer)) {
+            Armed::Disarm(Armed::Bit::ExitPending);
+            return false;
         }
 
-        return false;
+        CompleteExit();
+        return true;
     }
 
     void BowModeController::PumpAttackHold(float dt) {
-        if (!attackHold_.active.load(std::memory_order_relaxed)) return;
+        if (!attackHold_.active.load(std::memory_order_relaxed)) {
+            Armed::Disarm(Armed::Bit::AttackHold);
+            return;
+        }
 
         if (!BowState::IsAutoAttackHeld()) {
             attackHold_.active.store(false, std::memory_order_relaxed);
             attackHold_.secs.store(0.0f, std::memory_order_relaxed);
-            return;
-        }
-
-        constexpr std::uint8_t kMaxRetries = 6;
-        if (!attackHold_.arrowAttachConfirmed && attackHold_.watchdogAtMs != 0 && NowMs() >= attackHold_.watchdogAtMs) {
-            if (attackHold_.retryCount >= kMaxRetries) {
-                StopAutoAttackDraw();
-                BowState::SetAutoAttackHeld(false);
-                attackHold_.watchdogAtMs = 0;
-                attackHold_.retryCount = 0;
-                return;
-            }
-
-            attackHold_.retryCount++;
-            StopAutoAttackDraw();
-
-            attackHold_.active.store(true, std::memory_order_relaxed);
-            BowState::SetAutoAttackHeld(true);
-            StartAutoAttackDraw();
+            Armed::Disarm(Armed::Bit::AttackHold);
             return;
         }
 
@@ -167,38 +184,93 @@ namespace BowInput {
         BowState::detail::DispatchAttackButtonEvent(ev);
     }
 
-    void BowModeController::PumpPostExitAttackTap() {
-        if (!postExitAttack_.pending) return;
-        const std::uint64_t now = NowMs();
-        if (postExitAttack_.stage == 0) {
-            if (postExitAttack_.downAtMs != 0 && now >= postExitAttack_.downAtMs) {
-                auto* evPress = BowState::detail::MakeAttackButtonEvent(1.0f, 0.0f);
-                BowState::detail::DispatchAttackButtonEvent(evPress);
-                postExitAttack_.holdStartMs = now;
-                postExitAttack_.stage = 1;
-            }
+    void BowModeController::OnAttackWatchdogDue(std::uintptr_t) {
+        auto& ctrl = Get();
+        auto& hold = ctrl.attackHold_;
+        hold.watchdogTimer = TimerWheel::kNone;
+
+        if (hold.arrowAttachConfirmed || !hold.active.load(std::memory_order_relaxed) ||
+            !BowState::IsAutoAttackHeld()) {
             return;
         }
 
-        if (postExitAttack_.stage == 1) {
-            std::uint64_t heldDuration = now - postExitAttack_.holdStartMs;
-            auto* evHold = BowState::detail::MakeAttackButtonEvent(1.0f, heldDuration / 1000.0f);
-            BowState::detail::DispatchAttackButtonEvent(evHold);
-            if (heldDuration >= postExitAttack_.minHoldMs) {
-                postExitAttack_.stage = 2;
-            }
+        constexpr std::uint8_t kMaxRetries = 6;
+        if (hold.retryCount >= kMaxRetries) {
+            StopAutoAttackDraw();
+            BowState::SetAutoAttackHeld(false);
+            hold.retryCount = 0;
+            return;
+        }
+
+        hold.retryCount++;
+        StopAutoAttackDraw();
+
+        BowState::SetAutoAttackHeld(true);
+        StartAutoAttackDraw();
+    }
+
+    // Stage 0 (press delay) and stage 2 (release) are timers; only the stage-1 hold needs a per-frame event.
+    void BowModeController::SchedulePostExitAttackTap() {
+        Scheduler::Cancel(postExitAttack_.downTimer);
+        Scheduler::Cancel(postExitAttack_.upTimer);
+
+        postExitAttack_.pending = true;
+        postExitAttack_.stage = 0;
+        postExitAttack_.downTimer = Scheduler::After(kPostExitAttackDownDelayMs, &OnPostExitAttackDownDue);
+    }
+
+    void BowModeController::OnPostExitAttackDownDue(std::uintptr_t) {
+        auto& pea = Get().postExitAttack_;
+        pea.downTimer = TimerWheel::kNone;
+        if (!pea.pending || pea.stage != 0) return;
+
+        auto* evPress = BowState::detail::MakeAttackButtonEvent(1.0f, 0.0f);
+        BowState::detail::DispatchAttackButtonEvent(evPress);
+        pea.holdStartMs = FrameClock::NowMs();
+        pea.stage = 1;
+        pea.upTimer = Scheduler::After(kPostExitAttackTapMs, &OnPostExitAttackUpDue);
+        Armed::Arm(Armed::Bit::PostExitAttack);
+    }
+
+    void BowModeController::OnPostExitAttackUpDue(std::uintptr_t) {
+        auto& ctrl = Get();
+        ctrl.postExitAttack_.upTimer = TimerWheel::kNone;
+        if (ctrl.postExitAttack_.pending && ctrl.postExitAttack_.stage == 2) {
+            ctrl.ReleasePostExitAttack();
+        }
+    }
+
+    void BowModeController::ReleasePostExitAttack() {
+        auto* evRelease = BowState::detail::MakeAttackButtonEvent(0.0f, 0.1f);
+        BowState::detail::DispatchAttackButtonEvent(evRelease);
+
+        Scheduler::Cancel(postExitAttack_.downTimer);
+        Scheduler::Cancel(postExitAttack_.upTimer);
+        postExitAttack_ = {};
+        Armed::Disarm(Armed::Bit::PostExitAttack);
+    }
+
+    void BowModeController::PumpPostExitAttackTap() {
+        if (!postExitAttack_.pending || postExitAttack_.stage != 1) {
+            Armed::Disarm(Armed::Bit::PostExitAttack);
             return;
         }
 
-        if (postExitAttack_.stage == 2 && postExitAttack_.upAtMs != 0 && now >= postExitAttack_.upAtMs) {
-            auto* evRelease = BowState::detail::MakeAttackButtonEvent(0.0f, 0.1f);
-            BowState::detail::DispatchAttackButtonEvent(evRelease);
-            postExitAttack_ = {};
+        const std::uint64_t heldDuration = FrameClock::NowMs() - postExitAttack_.holdStartMs;
+        auto* evHold = BowState::detail::MakeAttackButtonEvent(1.0f, heldDuration / 1000.0f);
+        BowState::detail::DispatchAttackButtonEvent(evHold);
+        if (heldDuration < postExitAttack_.minHoldMs) return;
+
+        postExitAttack_.stage = 2;
+        if (Scheduler::IsPending(postExitAttack_.upTimer)) {
+            Armed::Disarm(Armed::Bit::PostExitAttack);
+        } else {
+            ReleasePostExitAttack();
         }
     }
 
-    void BowModeController::OnAnimEvent(std::string_view tag, RE::PlayerCharacter* player) {
-        if (tag == "EnableBumper"sv) {
+    void BowModeController::OnAnimEvent(AnimTag tag, RE::PlayerCharacter* player) {
+        if (tag == AnimTag::EnableBumper) {
             BowState::SetBowEquipped(true);
 
             const bool waiting = BowState::IsWaitingAutoAfterEquip();
@@ -215,10 +287,10 @@ namespace BowInput {
                 }
             }
 
-        } else if (tag == "WeaponSheathe"sv) {
+        } else if (tag == AnimTag::WeaponSheathe) {
             OnWeaponSheathe(player);
 
-        } else if (tag == "bowReset"sv) {
+        } else if (tag == AnimTag::BowReset) {
             const bool autoDraw = IsAutoDrawEnabled();
             const bool autoHeld = BowState::IsAutoAttackHeld();
             const bool hkDown = hotkeyDown;
@@ -228,9 +300,9 @@ namespace BowInput {
                 BowState::SetAutoAttackHeld(true);
                 StartAutoAttackDraw();
             }
-        } else if (tag == "arrowAttach"sv) {
+        } else if (tag == AnimTag::ArrowAttach) {
             attackHold_.arrowAttachConfirmed = true;
-            attackHold_.watchdogAtMs = 0;
+            Scheduler::Cancel(attackHold_.watchdogTimer);
             attackHold_.retryCount = 0;
         }
     }
@@ -293,14 +365,15 @@ namespace BowInput {
         pendingRestoreAfterSheathe.store(false, std::memory_order_relaxed);
         sheathRequestedByPlayer.store(false, std::memory_order_relaxed);
 
-        fakeEnableBumperAtMs = 0;
+        Scheduler::Cancel(fakeEnableBumperTimer);
+        Scheduler::Cancel(attackHold_.watchdogTimer);
         attackHold_.active.store(false, std::memory_order_relaxed);
         attackHold_.secs.store(0.0f, std::memory_order_relaxed);
 
         exit_.pending = false;
         exit_.waitForEquip = false;
-        exit_.waitEquipTimer = 0.0f;
-        exit_.delayTimer = 0.0f;
+        Scheduler::Cancel(exit_.waitEquipTimer);
+        Scheduler::Cancel(exit_.delayTimer);
         exit_.delayMs = 0;
 
         hotkeyDown = false;
@@ -309,7 +382,7 @@ namespace BowInput {
     }
 
     void BowModeController::OnKeyPressed(RE::PlayerCharacter* player) {
-        lastHotkeyPressMs.store(NowMs(), std::memory_order_relaxed);
+        lastHotkeyPressMs.store(FrameClock::NowMs(), std::memory_order_relaxed);
 
         auto* equipMgr = RE::ActorEquipManager::GetSingleton();
 
@@ -376,13 +449,19 @@ namespace BowInput {
 
         BowState::SetPrevAmmo(player->GetCurrentAmmo());
 
-        std::vector<BowState::ExtraEquippedItem> wornBefore;
-        BowState::CaptureWornArmorSnapshot(wornBefore);
-
         auto* bow = st.chosenBow.base ? st.chosenBow.base->As<RE::TESObjectWEAP>() : nullptr;
         auto* bowExtra = st.chosenBow.extra;
         if (!bow) return;
 
+        auto* preferred = BowState::GetPreferredArrow();
+        const bool hideItems = HiddenItemsPatch::IsEnabled();
+
+        std::span<const RE::FormID> hiddenIds{};
+        if (hideItems) hiddenIds = HiddenItemsPatch::GetHiddenFormIDs();
+
+        static BowState::EnterBowScan scan;  // NOSONAR
+        BowState::ScanForEnterBowMode(scan, preferred, hiddenIds);
+
         auto* rightEntry = player->GetEquippedEntryData(false);
         auto* leftEntry = player->GetEquippedEntryData(true);
 
@@ -394,9 +473,11 @@ namespace BowInput {
         st.isEquipingBow = true;
         st.isUsingBow = false;
 
-        auto const& cfg = IntegratedBow::GetBowConfig();
+        auto const* frame = FrameConfig();
+        const bool skipEquipAnim = frame ? frame->skipEquipBowAnimationPatch
+                                         : IntegratedBow::CurrentConfig()->skipEquipBowAnimationPatch;
 
-        if (cfg.skipEquipBowAnimationPatch.load(std::memory_order_relaxed)) {
+        if (skipEquipAnim) {
             IntegratedBow::SkipEquipController::EnableAndArmDisable(player, 0, false, kDisableSkipEquipDelayMs);
         }
 
@@ -405,19 +486,14 @@ namespace BowInput {
         st.isUsingBow = true;
         st.isEquipingBow = false;
 
-        std::vector<BowState::ExtraEquippedItem> wornAfter;
-        BowState::CaptureWornArmorSnapshot(wornAfter);
-        BowState::SetPrevExtraEquipped(BowState::DiffArmorSnapshot(wornBefore, wornAfter));
+        BowState::RecordDisplacedArmor(scan.worn);
 
-        if (HiddenItemsPatch::IsEnabled()) {
-            BowState::ApplyHiddenItemsPatch(player, equipMgr, HiddenItemsPatch::GetHiddenFormIDs());
+        if (hideItems) {
+            BowState::ApplyHiddenItemsPatch(player, equipMgr, scan.worn, scan.hiddenSlots);
         }
 
-        if (auto* preferred = BowState::GetPreferredArrow()) {
-            auto inv = player->GetInventory([preferred](RE::TESBoundObject const& obj) { return &obj == preferred; });
-            if (!inv.empty()) {
-                equipMgr->EquipObject(player, preferred, nullptr, 1, nullptr, true, false, true, false);
-            }
+        if (preferred && scan.preferredArrowCount > 0) {
+            equipMgr->EquipObject(player, preferred, nullptr, 1, nullptr, true, false, true, false);
         }
 
         if (!alreadyDrawn) SetWeaponDrawn(player, true);
@@ -427,13 +503,11 @@ namespace BowInput {
         const bool shouldWaitAuto = ctrl.mode_.holdMode && IsAutoDrawEnabled() && ctrl.hotkeyDown;
         BowState::SetWaitingAutoAfterEquip(shouldWaitAuto);
 
-        ctrl.allowUnequip.store(false, std::memory_order_relaxed);
-        ctrl.allowUnequipReenableMs.store(NowMs() + 2000, std::memory_order_relaxed);
+        ctrl.BlockUnequipFor(2000);
 
-        if (shouldWaitAuto && cfg.skipEquipBowAnimationPatch.load(std::memory_order_relaxed) && alreadyDrawn) {
-            ctrl.fakeEnableBumperAtMs = NowMs() + kFakeEnableBumperDelayMs;
-        } else {
-            ctrl.fakeEnableBumperAtMs = 0;
+        Scheduler::Cancel(ctrl.fakeEnableBumperTimer);
+        if (shouldWaitAuto && skipEquipAnim && alreadyDrawn) {
+            ctrl.fakeEnableBumperTimer = Scheduler::After(kFakeEnableBumperDelayMs, &OnFakeEnableBumperDue);
         }
     }
 
@@ -443,7 +517,7 @@ namespace BowInput {
 
         if (!player || !equipMgr) return;
 
-        ctrl.fakeEnableBumperAtMs = 0;
+        Scheduler::Cancel(ctrl.fakeEnableBumperTimer);
 
         if (!st.wasCombatPosed && !player->IsInCombat()) {
             SetWeaponDrawn(player, false);
@@ -456,35 +530,50 @@ namespace BowInput {
     }
 
     void BowModeController::ScheduleExitBowMode(bool waitForEquip, int delayMs) {
+        Scheduler::Cancel(exit_.waitEquipTimer);
+        Scheduler::Cancel(exit_.delayTimer);
+
         exit_.pending = true;
         exit_.waitForEquip = waitForEquip;
-        exit_.waitEquipTimer = 0.0f;
-        exit_.delayTimer = 0.0f;
         exit_.delayMs = delayMs;
+        Armed::Arm(Armed::Bit::ExitPending);
+
+        if (waitForEquip) {
+            exit_.waitEquipTimer = Scheduler::After(exit_.waitEquipMaxMs, &OnExitEquipWaitDue);
+        } else {
+            BeginExitDelay();
+        }
     }
 
-    void BowModeController::ScheduleAutoAttackDraw() {
-        if (!RE::PlayerCharacter::GetSingleton()) return;
-        if (!BowState::Get().isUsingBow) return;
-        BowState::SetWaitingAutoAfterEquip(true);
+    void BowModeController::BeginExitDelay() {
+        if (exit_.delayMs > 0) {
+            exit_.delayTimer = Scheduler::After(static_cast<std::uint64_t>(exit_.delayMs), &OnExitDelayDue);
+        }
     }
 
-    void BowModeController::UpdateExitEquipWait(float dt) {
-        if (!exit_.waitForEquip || BowState::IsBowEquipped()) return;
+    // Equip never confirmed: stop waiting and fall through to the sheathe delay, as if it had.
+    void BowModeController::OnExitEquipWaitDue(std::uintptr_t) {
+        auto& ctrl = Get();
+        ctrl.exit_.waitEquipTimer = TimerWheel::kNone;
+        if (!ctrl.exit_.pending || !ctrl.exit_.waitForEquip) return;
 
-        exit_.waitEquipTimer += dt;
+        ctrl.exit_.waitForEquip = false;
+        ctrl.BeginExitDelay();
+        Armed::Arm(Armed::Bit::ExitPending);
+    }
 
-        if (exit_.waitEquipTimer >= exit_.waitEquipMax) {
-            exit_.waitForEquip = false;
-            exit_.waitEquipTimer = 0.0f;
+    void BowModeController::OnExitDelayDue(std::uintptr_t) {
+        auto& ctrl = Get();
+        ctrl.exit_.delayTimer = TimerWheel::kNone;
+        if (ctrl.exit_.pending) {
+            Armed::Arm(Armed::Bit::ExitPending);
         }
     }
 
-    bool BowModeController::IsExitDelayReady(float dt) {
-        if (exit_.delayMs <= 0) return true;
-
-        exit_.delayTimer += dt * 1000.0f;
-        return exit_.delayTimer >= static_cast<float>(exit_.delayMs);
+    void BowModeController::ScheduleAutoAttackDraw() {
+        if (!RE::PlayerCharacter::GetSingleton()) return;
+        if (!BowState::Get().isUsingBow) return;
+        BowState::SetWaitingAutoAfterEquip(true);
     }
 
     void BowModeController::CompleteExit() {
@@ -501,8 +590,8 @@ namespace BowInput {
     void BowModeController::ResetExitState() {
         exit_.pending = false;
         exit_.waitForEquip = false;
-        exit_.waitEquipTimer = 0.0f;
-        exit_.delayTimer = 0.0f;
+        Scheduler::Cancel(exit_.waitEquipTimer);
+        Scheduler::Cancel(exit_.delayTimer);
         exit_.delayMs = 0;
 
         mode_.smartPending = false;
@@ -516,8 +605,10 @@ namespace BowInput {
         ctrl.attackHold_.active.store(true, std::memory_order_relaxed);
         ctrl.attackHold_.secs.store(0.0f, std::memory_order_relaxed);
         ctrl.attackHold_.arrowAttachConfirmed = false;
-        ctrl.attackHold_.watchdogAtMs = NowMs() + 400;
+        Scheduler::Cancel(ctrl.attackHold_.watchdogTimer);
+        ctrl.attackHold_.watchdogTimer = Scheduler::After(400, &OnAttackWatchdogDue);
         ctrl.sheathRequestedByPlayer.store(false, std::memory_order_relaxed);
+        Armed::Arm(Armed::Bit::AttackHold);
 
         auto* ev = BowState::detail::MakeAttackButtonEvent(1.0f, 0.0f);
         BowState::detail::DispatchAttackButtonEvent(ev);
@@ -532,6 +623,7 @@ namespace BowInput {
         auto* ev = BowState::detail::MakeAttackButtonEvent(0.0f, held);
         BowState::detail::DispatchAttackButtonEvent(ev);
 
+        Scheduler::Cancel(ctrl.attackHold_.watchdogTimer);
         ctrl.attackHold_.active.store(false, std::memory_order_relaxed);
         ctrl.attackHold_.secs.store(0.0f, std::memory_order_relaxed);
     }
@@ -2,8 +2,10 @@
 
 #include <cstdint>
 
+#include "AnimTags.h"
 #include "HotkeyDetector.h"
 #include "BowInputTiming.h"
+#include "TimerWheel.h"
 
 namespace RE {
     class PlayerCharacter;
@@ -28,9 +30,9 @@ namespace BowInput {
     struct ExitState {
         bool pending = false;
         bool waitForEquip = false;
-        float waitEquipTimer = 0.0f;
-        float delayTimer = 0.0f;
-        float waitEquipMax = 3.0f;
+        TimerWheel::Handle waitEquipTimer = TimerWheel::kNone;
+        TimerWheel::Handle delayTimer = TimerWheel::kNone;
+        std::uint64_t waitEquipMaxMs = 3000;
         int delayMs = 0;
     };
 
@@ -38,15 +40,15 @@ namespace BowInput {
         std::atomic_bool active{false};
         std::atomic<float> secs{0.0f};
         bool arrowAttachConfirmed = false;
-        std::uint64_t watchdogAtMs = 0;
+        TimerWheel::Handle watchdogTimer = TimerWheel::kNone;
         std::uint8_t retryCount = 0;
     };
 
     struct PostExitAttackState {
         bool pending = false;
         std::uint8_t stage = 0;
-        std::uint64_t downAtMs = 0;
-        std::uint64_t upAtMs = 0;
+        TimerWheel::Handle downTimer = TimerWheel::kNone;
+        TimerWheel::Handle upTimer = TimerWheel::kNone;
         std::uint64_t holdStartMs = 0;
         std::uint64_t minHoldMs = BowInput::Timing::kPostExitAttackMinHoldMs;
     };
@@ -57,10 +59,10 @@ namespace BowInput {
 
         bool hotkeyDown = false;
 
-        std::uint64_t fakeEnableBumperAtMs = 0;
+        TimerWheel::Handle fakeEnableBumperTimer = TimerWheel::kNone;
 
         std::atomic_bool allowUnequip{true};
-        std::atomic<std::uint64_t> allowUnequipReenableMs{0};
+        TimerWheel::Handle allowUnequipTimer = TimerWheel::kNone;
 
         std::atomic<std::uint64_t> lastHotkeyPressMs{0};
 
@@ -71,11 +73,12 @@ namespace BowInput {
         void OnHotkeyAcceptedReleased(RE::PlayerCharacter* player, bool blocked) override;
 
         void UpdateSmartMode(RE::PlayerCharacter* player, float dt);
-        [[nodiscard]] bool UpdateExitPending(float dt);
+        [[nodiscard]] bool UpdateExitPending();
         void PumpAttackHold(float dt);
         void PumpPostExitAttackTap();
+        void SchedulePostExitAttackTap();
 
-        void OnAnimEvent(std::string_view tag, RE::PlayerCharacter* player);
+        void OnAnimEvent(AnimTag tag, RE::PlayerCharacter* player);
 
         void OnWeaponSheathe(RE::PlayerCharacter* player);
 
@@ -92,7 +95,8 @@ namespace BowInput {
         const ModeState& Mode() const noexcept { return mode_; }
         const ExitState& Exit() const noexcept { return exit_; }
 
-        void UpdateUnequipGate() noexcept;
+        void BlockUnequipFor(std::uint64_t ms) noexcept;
+        void AllowUnequip() noexcept;
 
         void CompleteExit();
 
@@ -116,16 +120,23 @@ namespace BowInput {
         static void ScheduleAutoAttackDraw();
 
         void ResetExitState();
+        void BeginExitDelay();
+        void ReleasePostExitAttack();
 
         static bool IsWeaponDrawn(RE::Actor* actor);
         static void SetWeaponDrawn(RE::Actor* actor, bool drawn);
         static RE::ExtraDataList* GetPrimaryExtra(RE::InventoryEntryData const* entry);
 
-        void UpdateExitEquipWait(float dt);
-        [[nodiscard]] bool IsExitDelayReady(float dt);
-
         static void StartAutoAttackDraw();
         static void StopAutoAttackDraw();
+
+        static void OnUnequipGateDue(std::uintptr_t);
+        static void OnFakeEnableBumperDue(std::uintptr_t);
+        static void OnExitEquipWaitDue(std::uintptr_t);
+        static void OnExitDelayDue(std::uintptr_t);
+        static void OnAttackWatchdogDue(std::uintptr_t);
+        static void OnPostExitAttackDownDue(std::uintptr_t);
+        static void OnPostExitAttackUpDue(std::uintptr_t);
     };
 
 }
\ No newline at end of file
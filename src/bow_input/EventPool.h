@@ -0,0 +1,101 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace BowInput {
+    struct EventPoolStats {
+        std::uint32_t capacity{0};
+        std::uint32_t inUse{0};
+        std::uint32_t highWater{0};
+        std::uint64_t acquired{0};
+        std::uint64_t exhausted{0};
+    };
+
+    // Fixed set of reusable event objects. Slots are built lazily by the factory passed to Acquire and
+    // then kept forever; Release hands a slot back once the consumer is done with it. Any thread may
+    // acquire or release. Pointers the pool does not own are ignored by Release.
+    template <class Event, std::size_t N>
+    class EventPool {
+        static_assert(N > 0 && N <= 64, "EventPool tracks slots in one 64-bit mask");
+
+    public:
+        static constexpr std::size_t kCapacity = N;
+
+        // Returns nullptr when every slot is in flight; the caller then falls back to a one-off event.
+        template <class Factory>
+        Event* Acquire(Factory&& create) {
+            std::uint64_t used = _inUse.load(std::memory_order_relaxed);
+            std::size_t slot = 0;
+            for (;;) {
+                const std::uint64_t free = ~used & kAllMask;
+                if (free == 0) {
+                    _exhausted.fetch_add(1, std::memory_order_relaxed);
+                    return nullptr;
+                }
+
+                slot = static_cast<std::size_t>(std::countr_zero(free));
+                if (_inUse.compare_exchange_weak(used, used | (1ull << slot), std::memory_order_acquire,
+                                                 std::memory_order_relaxed)) {
+                    used |= 1ull << slot;
+                    break;
+                }
+            }
+
+            _acquired.fetch_add(1, std::memory_order_relaxed);
+            RaiseHighWater(static_cast<std::uint32_t>(std::popcount(used)));
+
+            Event* ev = _slots[slot].load(std::memory_order_relaxed);
+            if (!ev) {
+                ev = create();
+                _slots[slot].store(ev, std::memory_order_release);
+                if (!ev) {
+                    _inUse.fetch_and(~(1ull << slot), std::memory_order_release);
+                }
+            }
+            return ev;
+        }
+
+        bool Release(const Event* ev) noexcept {
+            if (!ev) {
+                return false;
+            }
+
+            for (std::size_t i = 0; i < N; ++i) {
+                if (_slots[i].load(std::memory_order_acquire) == ev) {
+                    _inUse.fetch_and(~(1ull << i), std::memory_order_release);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        [[nodiscard]] EventPoolStats Stats() const noexcept {
+            EventPoolStats s{};
+            s.capacity = static_cast<std::uint32_t>(N);
+            s.inUse = static_cast<std::uint32_t>(std::popcount(_inUse.load(std::memory_order_relaxed)));
+            s.highWater = _highWater.load(std::memory_order_relaxed);
+            s.acquired = _acquired.load(std::memory_order_relaxed);
+            s.exhausted = _exhausted.load(std::memory_order_relaxed);
+            return s;
+        }
+
+    private:
+        static constexpr std::uint64_t kAllMask = (N == 64) ? ~0ull : ((1ull << N) - 1);
+
+        void RaiseHighWater(std::uint32_t n) noexcept {
+            std::uint32_t cur = _highWater.load(std::memory_order_relaxed);
+            while (n > cur && !_highWater.compare_exchange_weak(cur, n, std::memory_order_relaxed)) {
+            }
+        }
+
+        std::array<std::atomic<Event*>, N> _slots{};
+        std::atomic<std::uint64_t> _inUse{0};
+        std::atomic<std::uint32_t> _highWater{0};
+        std::atomic<std::uint64_t> _acquired{0};
+        std::atomic<std::uint64_t> _exhausted{0};
+    };
+}
@@ -0,0 +1,67 @@
+#include "FrameClock.h"
+
+#include <atomic>
+#include <chrono>
+
+namespace BowInput::FrameClock {
+    namespace {
+        constexpr float kMaxFrameDt = 0.5f;
+
+        std::uint64_t SteadyUs() noexcept {
+            using clock = std::chrono::steady_clock;
+            return static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(clock::now().time_since_epoch()).count());
+        }
+
+        struct ClockState {
+            std::atomic<SourceFn> source{&SteadyUs};
+            std::atomic<std::uint64_t> frameUs{0};
+            std::atomic<float> dt{0.0f};
+            std::uint64_t lastUs{0};
+        };
+
+        ClockState& State() noexcept {
+            static ClockState s;  // NOSONAR
+            return s;
+        }
+
+        std::uint64_t Read(const ClockState& st) noexcept { return st.source.load(std::memory_order_relaxed)(); }
+    }
+
+    void SetSource(SourceFn fn) noexcept {
+        auto& st = State();
+        st.source.store(fn ? fn : &SteadyUs, std::memory_order_relaxed);
+        st.lastUs = 0;
+        st.frameUs.store(Read(st), std::memory_order_relaxed);
+        st.dt.store(0.0f, std::memory_order_relaxed);
+    }
+
+    void BeginFrame() noexcept {
+        auto& st = State();
+        const std::uint64_t now = Read(st);
+
+        float dt = 0.0f;
+        if (st.lastUs != 0 && now >= st.lastUs) {
+            dt = static_cast<float>(now - st.lastUs) * 1e-6f;
+            if (dt > kMaxFrameDt) dt = 0.0f;
+        }
+        st.lastUs = now;
+
+        st.frameUs.store(now, std::memory_order_relaxed);
+        st.dt.store(dt, std::memory_order_relaxed);
+    }
+
+    std::uint64_t NowUs() noexcept {
+        auto& st = State();
+        if (const auto us = st.frameUs.load(std::memory_order_relaxed); us != 0) {
+            return us;
+        }
+        return Read(st);
+    }
+
+    std::uint64_t NowMs() noexcept { return NowUs() / 1000; }
+
+    float Dt() noexcept { return State().dt.load(std::memory_order_relaxed); }
+
+    std::uint64_t SampleMs() noexcept { return Read(State()) / 1000; }
+}
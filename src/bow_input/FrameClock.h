@@ -0,0 +1,23 @@
+#pragma once
+#include <cstdint>
+
+// One clock sample per input frame. ProcessEvent calls BeginFrame once; every timer in the input modules
+// reads NowUs/NowMs/Dt from here instead of hitting steady_clock on its own. The source is injectable so the
+// state machine can be driven by a virtual clock.
+namespace BowInput::FrameClock {
+    // Monotonic time in microseconds.
+    using SourceFn = std::uint64_t (*)() noexcept;
+
+    // nullptr restores the steady_clock source.
+    void SetSource(SourceFn fn) noexcept;
+
+    void BeginFrame() noexcept;
+
+    // The input thread's sample for the current frame; anywhere else it may be a whole idle stretch old.
+    [[nodiscard]] std::uint64_t NowUs() noexcept;
+    [[nodiscard]] std::uint64_t NowMs() noexcept;
+    [[nodiscard]] float Dt() noexcept;
+
+    // Fresh reading for the callers that run outside an input frame (anim events, equip hooks, UI, timer deadlines).
+    [[nodiscard]] std::uint64_t SampleMs() noexcept;
+}
@@ -2,18 +2,14 @@
 
 #include <cstddef>
 #include <cstdint>
-#include <ranges>
 #include <utility>
 
+#include "ArmedState.h"
+
 namespace BowInput {
     namespace {
         constexpr float kExclusiveConfirmDelaySec = 0.10f;
 
-        constexpr int kDIK_W = 0x11;
-        constexpr int kDIK_A = 0x1E;
-        constexpr int kDIK_S = 0x1F;
-        constexpr int kDIK_D = 0x20;
-
         enum class PendingSrc : std::uint8_t { None = 0, Kb = 1, Gp = 2 };
 
         struct Snapshot {
@@ -25,80 +21,61 @@ namespace BowInput {
             bool gpPressedEdge{};
         };
 
-        inline bool AnyEnabled(const std::array<int, kMaxComboKeys>& a) {
-            return std::ranges::any_of(a, [](int v) { return v != -1; });
-        }
+        template <class Set, class Extras>
+        ComboMatcher<Set> Compile(const std::array<int, kMaxComboKeys>& codes, const Extras& allowedExtras) {
+            ComboMatcher<Set> m{};
 
-        inline bool ComboContains(const std::array<int, kMaxComboKeys>& combo, int code) {
-            return std::ranges::any_of(combo, [&](int v) {
-                if (v == -1) return false;
-                return InputUtil::NormalizePadCode(v) == code;
-            });
-        }
+            for (const int v : codes) {
+                if (v == -1) continue;
 
-        inline bool IsAllowedExtra_Keyboard_MoveOrCamera(int code) {
-            switch (code) {
-                case kDIK_W:
-                case kDIK_A:
-                case kDIK_S:
-                case kDIK_D:
-                    return true;
-                default:
-                    return false;
-            }
-        }
+                const int code = InputUtil::NormalizePadCode(v);
+                const int slot = (code >= 0 && code < kMaxCode) ? Set::SlotOf(code) : kInvalidSlot;
+                if (slot == kInvalidSlot) {
+                    // A key the device can never report: the combo can never be held.
+                    return ComboMatcher<Set>{};
+                }
 
-        inline bool IsAllowedExtra_Gamepad_MoveOrCamera(int) { return false; }
+                m.combo[static_cast<std::size_t>(slot) >> 6] |= Set::Bit(slot);
+                m.enabled = true;
+            }
 
-        bool ComboDown(const std::array<int, kMaxComboKeys>& combo,
-                       const std::array<std::atomic_bool, kMaxCode>& down) {
-            if (!AnyEnabled(combo)) return false;
+            m.allowed = m.combo;
+            for (const int code : allowedExtras) {
+                if (const int slot = Set::SlotOf(code); slot != kInvalidSlot) {
+                    m.allowed[static_cast<std::size_t>(slot) >> 6] |= Set::Bit(slot);
+                }
+            }
 
-            auto enabledOnly = combo | std::views::filter([](int v) { return v != -1; });
+            return m;
+        }
 
-            return std::ranges::all_of(enabledOnly, [&](int v) {
-                const int code = InputUtil::NormalizePadCode(v);
-                if (code < 0 || code >= kMaxCode) return false;
-                return down[static_cast<std::size_t>(code)].load(std::memory_order_relaxed);
-            });
-        }
-
-        template <class AllowedFn>
-        bool ComboExclusiveNow(const std::array<int, kMaxComboKeys>& combo,
-                               const std::array<std::atomic_bool, kMaxCode>& down, std::span<const int> downList,
-                               AllowedFn isAllowedExtra) {
-            if (!ComboDown(combo, down)) return false;
-
-            const auto isDisallowedExtraDown = [&](int code) {
-                if (code < 0 || code >= kMaxCode) return false;
-                if (!down[static_cast<std::size_t>(code)].load(std::memory_order_relaxed)) return false;
-                if (ComboContains(combo, code)) return false;
-                if (isAllowedExtra(code)) return false;
-                return true;
-            };
+        template <class Set>
+        bool ComboDown(const ComboMatcher<Set>& m, const Set& set) {
+            if (!m.enabled) return false;
 
-            return std::ranges::none_of(downList, isDisallowedExtraDown);
+            for (std::size_t i = 0; i < Set::kWords; ++i) {
+                if ((set.PressedWord(i) & m.combo[i]) != m.combo[i]) return false;
+            }
+            return true;
         }
 
-        template <class AllowedFn>
-        bool ComboExclusiveReleaseOk(const std::array<int, kMaxComboKeys>& combo,
-                                     const std::array<std::atomic_bool, kMaxCode>& down, std::span<const int> downList,
-                                     AllowedFn isAllowedExtra) {
-            const auto isDisallowedExtraDown = [&](int code) {
-                if (code < 0 || code >= kMaxCode) return false;
-                if (!down[static_cast<std::size_t>(code)].load(std::memory_order_relaxed)) return false;
-                if (ComboContains(combo, code)) return false;
-                if (isAllowedExtra(code)) return false;
-                return true;
-            };
+        template <class Set>
+        bool ComboExclusiveReleaseOk(const ComboMatcher<Set>& m, const Set& set) {
+            for (std::size_t i = 0; i < Set::kWords; ++i) {
+                if ((set.HeldWord(i) & ~m.allowed[i]) != 0) return false;
+            }
+            return true;
+        }
 
-            return std::ranges::none_of(downList, isDisallowedExtraDown);
+        template <class Set>
+        bool ComboExclusiveNow(const ComboMatcher<Set>& m, const Set& set) {
+            return ComboDown(m, set) && ComboExclusiveReleaseOk(m, set);
         }
 
         inline Snapshot MakeSnapshot(bool prevHotkeyDown, const HotkeyRuntime& rt, const HotkeyConfig& hk,
                                      const InputState& inputs) {
-            const bool kbNow = ComboDown(hk.bowKeyScanCodes, inputs.kbDown);
-            const bool gpNow = ComboDown(hk.bowPadButtons, inputs.gpDown);
+            const bool kbNow = ComboDown(hk.kbMatcher, inputs.kb);
+            const bool gpNow = ComboDown(hk.gpMatcher, inputs.gp);
 
             Snapshot s{};
             s.kbNow = kbNow;
@@ -115,6 +92,12 @@ namespace BowInput {
             rt.prevRawGpComboDown = s.gpNow;
         }
 
+        inline void PublishArmed(const HotkeyRuntime& rt, bool hotkeyDown) noexcept {
+            const bool armed = hotkeyDown || rt.suppressUntilReleased || rt.exclusivePendingSrc != 0 ||
+                               rt.prevRawKbComboDown || rt.prevRawGpComboDown || rt.pattern.state != 0;
+            Armed::Set(Armed::Bit::Hotkey, armed);
+        }
+
         inline void ClearPending(HotkeyRuntime& rt) noexcept {
             rt.exclusivePendingSrc = 0;
             rt.exclusivePendingTimer = 0.0f;
@@ -138,25 +121,18 @@ namespace BowInput {
 
         inline bool StillExclusive(PendingSrc pending, bool rawNow, const HotkeyConfig& hk, const InputState& inputs) {
             if (pending == PendingSrc::Kb) {
-                const auto kbList = inputs.DownList(RE::INPUT_DEVICE::kKeyboard);
-                return rawNow ? ComboExclusiveNow(hk.bowKeyScanCodes, inputs.kbDown, kbList,
-                                                  IsAllowedExtra_Keyboard_MoveOrCamera)
-                              : ComboExclusiveReleaseOk(hk.bowKeyScanCodes, inputs.kbDown, kbList,
-                                                        IsAllowedExtra_Keyboard_MoveOrCamera);
+                return rawNow ? ComboExclusiveNow(hk.kbMatcher, inputs.kb)
+                              : ComboExclusiveReleaseOk(hk.kbMatcher, inputs.kb);
             }
 
-            const auto gpList = inputs.DownList(RE::INPUT_DEVICE::kGamepad);
-            return rawNow
-                       ? ComboExclusiveNow(hk.bowPadButtons, inputs.gpDown, gpList, IsAllowedExtra_Gamepad_MoveOrCamera)
-                       : ComboExclusiveReleaseOk(hk.bowPadButtons, inputs.gpDown, gpList,
-                                                 IsAllowedExtra_Gamepad_MoveOrCamera);
+            return rawNow ? ComboExclusiveNow(hk.gpMatcher, inputs.gp)
+                          : ComboExclusiveReleaseOk(hk.gpMatcher, inputs.gp);
         }
 
         inline void ArmPendingIfEdge(const Snapshot& s, HotkeyRuntime& rt, const HotkeyConfig& hk,
                                      const InputState& inputs) {
             if (s.kbPressedEdge) {
-                if (const auto kbList = inputs.DownList(RE::INPUT_DEVICE::kKeyboard); ComboExclusiveNow(
-                        hk.bowKeyScanCodes, inputs.kbDown, kbList, IsAllowedExtra_Keyboard_MoveOrCamera)) {
+                if (ComboExclusiveNow(hk.kbMatcher, inputs.kb)) {
                     rt.exclusivePendingSrc = std::to_underlying(PendingSrc::Kb);
                     rt.exclusivePendingTimer = kExclusiveConfirmDelaySec;
                 }
@@ -164,8 +140,7 @@ namespace BowInput {
             }
 
             if (s.gpPressedEdge) {
-                const auto gpList = inputs.DownList(RE::INPUT_DEVICE::kGamepad);
-                if (ComboExclusiveNow(hk.bowPadButtons, inputs.gpDown, gpList, IsAllowedExtra_Gamepad_MoveOrCamera)) {
+                if (ComboExclusiveNow(hk.gpMatcher, inputs.gp)) {
                     rt.exclusivePendingSrc = std::to_underlying(PendingSrc::Gp);
                     rt.exclusivePendingTimer = kExclusiveConfirmDelaySec;
                 }
@@ -208,27 +183,61 @@ namespace BowInput {
 
             return false;
         }
+
+        // Pattern mode: edges already advanced the DFA in OnButton, so a frame only folds in the
+        // suppress request and the timeouts. Suppression drops the hotkey silently, like the chord gate.
+        inline bool ApplyPatternSuppress(const HotkeyConfig& hk, HotkeyRuntime& rt, std::uint64_t nowMs,
+                                         bool& inOut_hotkeyDown) {
+            if (!rt.suppressUntilReleased) {
+                return false;
+            }
+
+            rt.suppressUntilReleased = false;
+            PatternEngine::Suppress(hk.pattern, rt.pattern, nowMs);
+            inOut_hotkeyDown = false;
+            return true;
+        }
+    }
+
+    void HotkeyDetector::CompileKeyboard(HotkeyConfig& hk) {
+        hk.kbMatcher = Compile<KeyboardDownSet>(hk.bowKeyScanCodes, kAllowedExtras_Keyboard_MoveOrCamera);
+    }
+
+    void HotkeyDetector::CompileGamepad(HotkeyConfig& hk) {
+        hk.gpMatcher = Compile<GamepadDownSet>(hk.bowPadButtons, kAllowedExtras_Gamepad_MoveOrCamera);
     }
 
-    void HotkeyDetector::Tick(RE::PlayerCharacter* player, float dt, const HotkeyConfig& hk, const InputState& inputs,
-                              bool requireExclusive, bool blocked, bool& inOut_hotkeyDown, HotkeyRuntime& rt,
-                              IHotkeyCallbacks& cb) {
+    void HotkeyDetector::Tick(RE::PlayerCharacter* player, float dt, std::uint64_t nowMs, const HotkeyConfig& hk,
+                              const InputState& inputs, bool requireExclusive, bool blocked, bool& inOut_hotkeyDown,
+                              HotkeyRuntime& rt, IHotkeyCallbacks& cb) {
         if (!player) {
             return;
         }
 
-        const Snapshot s = MakeSnapshot(inOut_hotkeyDown, rt, hk, inputs);
+        const bool prevAccepted = inOut_hotkeyDown;
+        bool acceptedNow = false;
 
-        if (ApplySuppressGate(rt, s, inOut_hotkeyDown)) {
-            CommitEdges(rt, s);
-            return;
-        }
+        if (!hk.pattern.Empty()) {
+            if (ApplyPatternSuppress(hk, rt, nowMs, inOut_hotkeyDown)) {
+                PublishArmed(rt, inOut_hotkeyDown);
+                return;
+            }
 
-        const bool acceptedNow = ComputeAccepted(s, rt, hk, inputs, requireExclusive, dt);
+            PatternEngine::Expire(hk.pattern, rt.pattern, nowMs);
+            acceptedNow = PatternEngine::Accepted(hk.pattern, rt.pattern);
+        } else {
+            const Snapshot s = MakeSnapshot(inOut_hotkeyDown, rt, hk, inputs);
 
-        CommitEdges(rt, s);
+            if (ApplySuppressGate(rt, s, inOut_hotkeyDown)) {
+                CommitEdges(rt, s);
+                PublishArmed(rt, inOut_hotkeyDown);
+                return;
+            }
+
+            acceptedNow = ComputeAccepted(s, rt, hk, inputs, requireExclusive, dt);
+            CommitEdges(rt, s);
+        }
 
-        const bool prevAccepted = s.prevAccepted;
         inOut_hotkeyDown = acceptedNow;
 
         if (acceptedNow && !prevAccepted) {
@@ -236,5 +245,42 @@ namespace BowInput {
         } else if (!acceptedNow && prevAccepted) {
             cb.OnHotkeyAcceptedReleased(player, blocked);
         }
+
+        PublishArmed(rt, inOut_hotkeyDown);
+    }
+
+    bool HotkeyDetector::OnButton(const HotkeyConfig& hk, HotkeyRuntime& rt, RE::INPUT_DEVICE dev, int code,
+                                  bool isPressed, bool isDownEdge, bool isUpEdge, std::uint64_t nowMs,
+                                  bool requireExclusive) {
+        if (hk.pattern.Empty()) {
+            return IsComboKey(hk, dev, code);
+        }
+
+        const bool changed = PatternEngine::OnButton(hk.pattern, rt.pattern, dev, code, isPressed, isDownEdge, isUpEdge,
+                                                     nowMs, requireExclusive);
+        if (rt.pattern.state != 0) {
+            Armed::Arm(Armed::Bit::Hotkey);
+        }
+        return changed;
+    }
+
+    bool HotkeyDetector::IsComboKey(const HotkeyConfig& hk, RE::INPUT_DEVICE dev, int code) noexcept {
+        if (!hk.pattern.Empty()) {
+            return PatternEngine::IsKey(hk.pattern, dev, code);
+        }
+
+        if (dev == RE::INPUT_DEVICE::kKeyboard) {
+            const int slot = InputUtil::KeyboardSlot(code);
+            return slot != kInvalidSlot &&
+                   (hk.kbMatcher.combo[static_cast<std::size_t>(slot) >> 6] & KeyboardDownSet::Bit(slot)) != 0;
+        }
+
+        if (dev == RE::INPUT_DEVICE::kGamepad) {
+            const int slot = InputUtil::GamepadSlot(code);
+            return slot != kInvalidSlot &&
+                   (hk.gpMatcher.combo[static_cast<std::size_t>(slot) >> 6] & GamepadDownSet::Bit(slot)) != 0;
+        }
+
+        return false;
     }
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 
+#include "HotkeyPattern.h"
 #include "InputState.h"
 
 namespace RE {
@@ -11,9 +12,27 @@ namespace RE {
 namespace BowInput {
     inline constexpr int kMaxComboKeys = 3;
 
+    // A combo compiled to slot masks: `combo` must be fully pressed, and with the exclusive patch nothing
+    // outside `allowed` (combo plus the tolerated extras) may be held.
+    template <class Set>
+    struct ComboMatcher {
+        std::array<std::uint64_t, Set::kWords> combo{};
+        std::array<std::uint64_t, Set::kWords> allowed{};
+        bool enabled{false};
+    };
+
+    using KeyboardMatcher = ComboMatcher<KeyboardDownSet>;
+    using GamepadMatcher = ComboMatcher<GamepadDownSet>;
+
     struct HotkeyConfig {
         std::array<int, kMaxComboKeys> bowKeyScanCodes{};
         std::array<int, kMaxComboKeys> bowPadButtons{};
+
+        KeyboardMatcher kbMatcher{};
+        GamepadMatcher gpMatcher{};
+
+        // When non-empty, replaces the chord matchers above.
+        HotkeyPattern pattern{};
     };
 
     struct HotkeyRuntime {
@@ -24,6 +43,8 @@ namespace BowInput {
 
         std::uint8_t exclusivePendingSrc{0};
         float exclusivePendingTimer{0.0f};
+
+        PatternRuntime pattern{};
     };
 
     struct IHotkeyCallbacks {
@@ -33,8 +54,19 @@ namespace BowInput {
     };
 
     struct HotkeyDetector {
-        static void Tick(RE::PlayerCharacter* player, float dt, const HotkeyConfig& hk, const InputState& inputs,
-                         bool requireExclusive, bool blocked, bool& inOut_hotkeyDown, HotkeyRuntime& rt,
-                         IHotkeyCallbacks& cb);
+        static void CompileKeyboard(HotkeyConfig& hk);
+        static void CompileGamepad(HotkeyConfig& hk);
+
+        [[nodiscard]] static bool IsComboKey(const HotkeyConfig& hk, RE::INPUT_DEVICE dev, int code) noexcept;
+
+        // Called per button event; returns true when the event may change the accepted state this frame.
+        // `requireExclusive` only matters in pattern mode; chords apply it in Tick.
+        static bool OnButton(const HotkeyConfig& hk, HotkeyRuntime& rt, RE::INPUT_DEVICE dev, int code,
+                             bool isPressed, bool isDownEdge, bool isUpEdge, std::uint64_t nowMs,
+                             bool requireExclusive);
+
+        static void Tick(RE::PlayerCharacter* player, float dt, std::uint64_t nowMs, const HotkeyConfig& hk,
+                         const InputState& inputs, bool requireExclusive, bool blocked, bool& inOut_hotkeyDown,
+                         HotkeyRuntime& rt, IHotkeyCallbacks& cb);
     };
-}
\ No newline at end of file
+}
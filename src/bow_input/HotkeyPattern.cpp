@@ -0,0 +1,360 @@
+#include "HotkeyPattern.h"
+
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <utility>
+
+namespace BowInput {
+    namespace {
+        constexpr std::uint64_t Bit(int slot) noexcept { return 1ull << (static_cast<unsigned>(slot) & 63u); }
+        constexpr std::size_t Word(int slot) noexcept { return static_cast<std::size_t>(slot) >> 6; }
+
+        bool Has(const PatternMask& m, int slot) noexcept { return (m[Word(slot)] & Bit(slot)) != 0; }
+
+        bool Covers(const PatternMask& have, const PatternMask& need) noexcept {
+            for (std::size_t i = 0; i < kPatternWords; ++i) {
+                if ((have[i] & need[i]) != need[i]) return false;
+            }
+            return true;
+        }
+
+        bool AnyOutside(const PatternMask& have, const PatternMask& allowed) noexcept {
+            for (std::size_t i = 0; i < kPatternWords; ++i) {
+                if ((have[i] & ~allowed[i]) != 0) return true;
+            }
+            return false;
+        }
+
+        bool AnyInside(const PatternMask& have, const PatternMask& keys) noexcept {
+            for (std::size_t i = 0; i < kPatternWords; ++i) {
+                if ((have[i] & keys[i]) != 0) return true;
+            }
+            return false;
+        }
+
+        std::string_view Trim(std::string_view s) noexcept {
+            while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front()))) s.remove_prefix(1);
+            while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back()))) s.remove_suffix(1);
+            return s;
+        }
+
+        bool IEquals(std::string_view a, std::string_view b) noexcept {
+            if (a.size() != b.size()) return false;
+            for (std::size_t i = 0; i < a.size(); ++i) {
+                if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i]))) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool ParseNumber(std::string_view s, int& out) noexcept {
+            s = Trim(s);
+            int base = 10;
+            if (s.size() > 2 && s[0] == '0' && (s[1] == 'x' || s[1] == 'X')) {
+                s.remove_prefix(2);
+                base = 16;
+            }
+            if (s.empty()) return false;
+            const auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), out, base);
+            return ec == std::errc{} && ptr == s.data() + s.size();
+        }
+
+        // Splits on `sep` and hands every (trimmed) piece to `fn`; stops early if fn returns false.
+        template <class Fn>
+        bool ForEachPart(std::string_view s, char sep, Fn&& fn) {
+            while (true) {
+                const auto pos = s.find(sep);
+                if (!fn(Trim(s.substr(0, pos)))) return false;
+                if (pos == std::string_view::npos) return true;
+                s.remove_prefix(pos + 1);
+            }
+        }
+
+        bool ParseKey(std::string_view tok, int& slot, std::string& error) {
+            if (tok.size() < 3 || tok[1] != ':') {
+                error = "expected K:<code> or G:<code>, got '" + std::string(tok) + "'";
+                return false;
+            }
+
+            int code = 0;
+            if (!ParseNumber(tok.substr(2), code) || code < 0 || code >= kMaxCode) {
+                error = "bad key code '" + std::string(tok) + "'";
+                return false;
+            }
+
+            const char dev = static_cast<char>(std::toupper(static_cast<unsigned char>(tok[0])));
+            if (dev == 'K') {
+                slot = InputUtil::KeyboardSlot(code);
+            } else if (dev == 'G') {
+                const int gs = InputUtil::GamepadSlot(InputUtil::NormalizePadCode(code));
+                slot = (gs == kInvalidSlot) ? kInvalidSlot : static_cast<int>(kKeyboardSlots) + gs;
+            } else {
+                error = "unknown device in '" + std::string(tok) + "'";
+                return false;
+            }
+
+            if (slot == kInvalidSlot) {
+                error = "key '" + std::string(tok) + "' can never be reported by its device";
+                return false;
+            }
+            return true;
+        }
+
+        bool ParseStep(std::string_view text, HotkeyPattern::Step& step, std::string& error) {
+            if (text.size() > 4 && IEquals(text.substr(0, 3), "tap") &&
+                std::isspace(static_cast<unsigned char>(text[3]))) {
+                step.tap = true;
+                text = Trim(text.substr(4));
+            }
+
+            if (text.empty()) {
+                error = "empty step";
+                return false;
+            }
+
+            return ForEachPart(text, '+', [&](std::string_view tok) {
+                int slot = kInvalidSlot;
+                if (!ParseKey(tok, slot, error)) return false;
+                step.chord[Word(slot)] |= Bit(slot);
+                return true;
+            });
+        }
+
+        bool ParseAttr(std::string_view attr, HotkeyPattern& p, std::string& error) {
+            const auto eq = attr.find('=');
+            const auto name = Trim(attr.substr(0, eq));
+            const auto value = (eq == std::string_view::npos) ? std::string_view{} : Trim(attr.substr(eq + 1));
+
+            if (IEquals(name, "exclusive") && value.empty()) {
+                p.exclusive = true;
+                return true;
+            }
+            if (IEquals(name, "nosuppress") && value.empty()) {
+                p.suppress = false;
+                return true;
+            }
+
+            int ms = 0;
+            if ((IEquals(name, "within") || IEquals(name, "tap")) && ParseNumber(value, ms) && ms > 0) {
+                (IEquals(name, "within") ? p.withinMs : p.tapMs) = static_cast<std::uint32_t>(ms);
+                return true;
+            }
+
+            error = "bad attribute '" + std::string(attr) + "'";
+            return false;
+        }
+
+        void BuildTable(HotkeyPattern& p) {
+            constexpr auto kSymbols = static_cast<std::size_t>(PatternSymbol::Count);
+            const auto n = static_cast<std::uint8_t>(p.steps.size());
+            const auto wait = [](std::size_t i) { return static_cast<std::uint8_t>(2 * i); };
+            const auto held = [](std::size_t i) { return static_cast<std::uint8_t>(2 * i + 1); };
+            const std::uint8_t suppressed = p.SuppressedState();
+            const std::uint8_t onSuppress = p.suppress ? suppressed : wait(0);
+
+            p.next.assign(static_cast<std::size_t>(suppressed) + 1, {});
+            p.timers.assign(static_cast<std::size_t>(suppressed) + 1, 0);
+
+            for (std::size_t s = 0; s < p.next.size(); ++s) {
+                for (std::size_t sym = 0; sym < kSymbols; ++sym) {
+                    p.next[s][sym] = static_cast<std::uint8_t>(s);
+                }
+            }
+
+            auto set = [&p](std::uint8_t from, PatternSymbol sym, std::uint8_t to) {
+                p.next[from][static_cast<std::size_t>(sym)] = to;
+            };
+
+            for (std::size_t i = 0; i < n; ++i) {
+                const bool last = (i + 1 == n);
+                const bool tap = p.steps[i].tap;
+
+                set(wait(i), PatternSymbol::ChordDown, (tap || last) ? held(i) : wait(i + 1));
+                set(wait(i), PatternSymbol::Foreign, wait(0));
+                set(wait(i), PatternSymbol::Suppress, onSuppress);
+                if (i > 0) {
+                    set(wait(i), PatternSymbol::Timeout, wait(0));
+                    p.timers[wait(i)] = HotkeyPattern::kUsesWindow;
+                }
+
+                if (last) {
+                    set(held(i), PatternSymbol::ChordUp, wait(0));
+                    set(held(i), PatternSymbol::Suppress, onSuppress);
+                    continue;
+                }
+
+                set(held(i), PatternSymbol::ChordUp, wait(i + 1));
+                set(held(i), PatternSymbol::Foreign, wait(0));
+                set(held(i), PatternSymbol::Timeout, wait(0));
+                set(held(i), PatternSymbol::Suppress, onSuppress);
+                p.timers[held(i)] = HotkeyPattern::kUsesWindow | HotkeyPattern::kUsesTap;
+            }
+
+            set(suppressed, PatternSymbol::AllReleased, wait(0));
+        }
+
+        void Advance(const HotkeyPattern& p, PatternRuntime& rt, PatternSymbol sym, std::uint64_t nowMs) {
+            const std::uint8_t from = rt.state;
+            const std::uint8_t to = p.next[from][static_cast<std::size_t>(sym)];
+            if (to == from) {
+                return;
+            }
+
+            rt.state = to;
+
+            if (from == 0 && to != p.SuppressedState()) {
+                rt.windowDeadlineMs = nowMs + p.withinMs;
+            }
+            if ((p.timers[to] & HotkeyPattern::kUsesTap) != 0) {
+                rt.tapDeadlineMs = nowMs + p.tapMs;
+            }
+        }
+
+        PatternSymbol Classify(const HotkeyPattern& p, const PatternRuntime& rt, int slot, bool isDownEdge,
+                               bool isUpEdge, bool exclusive) noexcept {
+            if (rt.state == p.SuppressedState()) {
+                return (isUpEdge && !AnyInside(rt.pressed, p.keys)) ? PatternSymbol::AllReleased
+                                                                    : PatternSymbol::Other;
+            }
+
+            const auto& chord = p.steps[rt.state >> 1].chord;
+
+            if (isDownEdge) {
+                if (exclusive && !Has(p.allowed, slot)) {
+                    return PatternSymbol::Foreign;
+                }
+                if (Has(chord, slot) && Covers(rt.pressed, chord)) {
+                    return (exclusive && AnyOutside(rt.pressed, p.allowed)) ? PatternSymbol::Foreign
+                                                                              : PatternSymbol::ChordDown;
+                }
+                return PatternSymbol::Other;
+            }
+
+            if (isUpEdge && Has(chord, slot)) {
+                return PatternSymbol::ChordUp;
+            }
+            return PatternSymbol::Other;
+        }
+    }
+
+    bool HotkeyPattern::Compile(std::string_view text, HotkeyPattern& out, std::string& error) {
+        HotkeyPattern p{};
+
+        text = Trim(text);
+        const auto bar = text.find('|');
+        const auto body = Trim(text.substr(0, bar));
+
+        if (body.empty()) {
+            error = "empty pattern";
+            return false;
+        }
+
+        const bool stepsOk = ForEachPart(body, '>', [&](std::string_view stepText) {
+            if (p.steps.size() >= kMaxPatternSteps) {
+                error = "too many steps";
+                return false;
+            }
+            HotkeyPattern::Step step{};
+            if (!ParseStep(stepText, step, error)) return false;
+            p.steps.push_back(step);
+            return true;
+        });
+        if (!stepsOk) {
+            return false;
+        }
+
+        if (p.steps.back().tap) {
+            error = "the last step is the held one and cannot be a tap";
+            return false;
+        }
+
+        if (bar != std::string_view::npos &&
+            !ForEachPart(text.substr(bar + 1), '|', [&](std::string_view a) { return ParseAttr(a, p, error); })) {
+            return false;
+        }
+
+        for (const auto& step : p.steps) {
+            for (std::size_t i = 0; i < kPatternWords; ++i) p.keys[i] |= step.chord[i];
+        }
+        p.allowed = p.keys;
+        for (const int code : kAllowedExtras_Keyboard_MoveOrCamera) {
+            const int slot = InputUtil::KeyboardSlot(code);
+            p.allowed[Word(slot)] |= Bit(slot);
+        }
+
+        BuildTable(p);
+        out = std::move(p);
+        return true;
+    }
+
+    int PatternEngine::SlotOf(RE::INPUT_DEVICE dev, int code) noexcept {
+        if (dev == RE::INPUT_DEVICE::kKeyboard) {
+            return InputUtil::KeyboardSlot(code);
+        }
+        if (dev == RE::INPUT_DEVICE::kGamepad) {
+            const int gs = InputUtil::GamepadSlot(code);
+            return (gs == kInvalidSlot) ? kInvalidSlot : static_cast<int>(kKeyboardSlots) + gs;
+        }
+        return kInvalidSlot;
+    }
+
+    bool PatternEngine::OnButton(const HotkeyPattern& p, PatternRuntime& rt, RE::INPUT_DEVICE dev, int code,
+                                 bool isPressed, bool isDownEdge, bool isUpEdge, std::uint64_t nowMs,
+                                 bool requireExclusive) {
+        const int slot = SlotOf(dev, code);
+        if (p.Empty() || slot == kInvalidSlot) {
+            return false;
+        }
+
+        if (isPressed) {
+            rt.pressed[Word(slot)] |= Bit(slot);
+        } else {
+            rt.pressed[Word(slot)] &= ~Bit(slot);
+        }
+
+        if (!isDownEdge && !isUpEdge) {
+            return false;
+        }
+
+        // A late edge must not extend a window that already ran out.
+        Expire(p, rt, nowMs);
+
+        const std::uint8_t before = rt.state;
+        const bool exclusive = p.exclusive || requireExclusive;
+        Advance(p, rt, Classify(p, rt, slot, isDownEdge, isUpEdge, exclusive), nowMs);
+        return rt.state != before;
+    }
+
+    void PatternEngine::Expire(const HotkeyPattern& p, PatternRuntime& rt, std::uint64_t nowMs) {
+        if (p.Empty()) {
+            return;
+        }
+
+        const std::uint8_t timers = p.timers[rt.state];
+        const bool windowOut = (timers & HotkeyPattern::kUsesWindow) != 0 && nowMs >= rt.windowDeadlineMs;
+        const bool tapOut = (timers & HotkeyPattern::kUsesTap) != 0 && nowMs >= rt.tapDeadlineMs;
+        if (windowOut || tapOut) {
+            Advance(p, rt, PatternSymbol::Timeout, nowMs);
+        }
+    }
+
+    void PatternEngine::Suppress(const HotkeyPattern& p, PatternRuntime& rt, std::uint64_t nowMs) {
+        if (p.Empty()) {
+            return;
+        }
+
+        Advance(p, rt, PatternSymbol::Suppress, nowMs);
+        if (rt.state == p.SuppressedState() && !AnyInside(rt.pressed, p.keys)) {
+            rt.state = 0;
+        }
+    }
+
+    void PatternEngine::Reset(PatternRuntime& rt) noexcept { rt = PatternRuntime{}; }
+
+    bool PatternEngine::IsKey(const HotkeyPattern& p, RE::INPUT_DEVICE dev, int code) noexcept {
+        const int slot = SlotOf(dev, code);
+        return slot != kInvalidSlot && Has(p.keys, slot);
+    }
+}
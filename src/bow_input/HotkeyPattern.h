@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "InputState.h"
+
+namespace BowInput {
+    // Keyboard slots first, gamepad slots after them, so one mask can describe mixed-device chords.
+    inline constexpr std::size_t kPatternSlots = kKeyboardSlots + kGamepadSlots;
+    inline constexpr std::size_t kPatternWords = (kPatternSlots + 63) / 64;
+    inline constexpr std::size_t kMaxPatternSteps = 8;
+
+    using PatternMask = std::array<std::uint64_t, kPatternWords>;
+
+    enum class PatternSymbol : std::uint8_t {
+        Other = 0,
+        ChordDown,
+        ChordUp,
+        Foreign,
+        AllReleased,
+        Timeout,
+        Suppress,
+        Count
+    };
+
+    // Compiled form of the [Input] HotkeyPattern INI value:
+    //
+    //   pattern := step ( '>' step )* ( '|' attr )*
+    //   step    := [ 'tap' ] key ( '+' key )*
+    //   key     := 'K:' code | 'G:' code          (decimal or 0x-prefixed hex)
+    //   attr    := 'within=' ms | 'tap=' ms | 'exclusive' | 'nosuppress'
+    //
+    // e.g. "G:0x100 > G:0xA | within=150" (LB then RT), "tap K:0x2F > K:0x2F" (tap V, then hold V).
+    // The last step is the one that is held; `tap` steps must be released within the tap window.
+    //
+    // States are Wait_i = 2i (waiting for step i), Held_i = 2i + 1 (step i held), and Suppressed = 2n
+    // (waiting for every pattern key to be released). Held of the last step is the accepted state.
+    struct HotkeyPattern {
+        struct Step {
+            PatternMask chord{};
+            bool tap{false};
+        };
+
+        static constexpr std::uint8_t kUsesWindow = 1u << 0;
+        static constexpr std::uint8_t kUsesTap = 1u << 1;
+
+        std::vector<Step> steps;
+        PatternMask keys{};
+        PatternMask allowed{};
+        std::uint32_t withinMs{300};
+        std::uint32_t tapMs{200};
+        bool exclusive{false};
+        bool suppress{true};
+
+        std::vector<std::array<std::uint8_t, static_cast<std::size_t>(PatternSymbol::Count)>> next;
+        std::vector<std::uint8_t> timers;
+
+        [[nodiscard]] bool Empty() const noexcept { return steps.empty(); }
+        [[nodiscard]] std::uint8_t AcceptState() const noexcept {
+            return static_cast<std::uint8_t>(2 * steps.size() - 1);
+        }
+        [[nodiscard]] std::uint8_t SuppressedState() const noexcept {
+            return static_cast<std::uint8_t>(2 * steps.size());
+        }
+
+        // Returns false and fills `error` when the text does not parse; `out` is left untouched then.
+        static bool Compile(std::string_view text, HotkeyPattern& out, std::string& error);
+    };
+
+    struct PatternRuntime {
+        std::uint8_t state{0};
+        std::uint64_t windowDeadlineMs{0};
+        std::uint64_t tapDeadlineMs{0};
+        PatternMask pressed{};
+    };
+
+    struct PatternEngine {
+        [[nodiscard]] static int SlotOf(RE::INPUT_DEVICE dev, int code) noexcept;
+
+        // Feeds one button event; returns true when the DFA changed state. `requireExclusive` (the global
+        // RequireExclusiveHotkeyPatch) makes the pattern exclusive as if it carried the attribute.
+        static bool OnButton(const HotkeyPattern& p, PatternRuntime& rt, RE::INPUT_DEVICE dev, int code,
+                             bool isPressed, bool isDownEdge, bool isUpEdge, std::uint64_t nowMs,
+                             bool requireExclusive);
+
+        static void Expire(const HotkeyPattern& p, PatternRuntime& rt, std::uint64_t nowMs);
+        static void Suppress(const HotkeyPattern& p, PatternRuntime& rt, std::uint64_t nowMs);
+        static void Reset(PatternRuntime& rt) noexcept;
+
+        [[nodiscard]] static bool IsKey(const HotkeyPattern& p, RE::INPUT_DEVICE dev, int code) noexcept;
+        [[nodiscard]] static bool Accepted(const HotkeyPattern& p, const PatternRuntime& rt) noexcept {
+            return !p.Empty() && rt.state == p.AcceptState();
+        }
+    };
+}
@@ -1,14 +1,129 @@
 #include "InputGate.h"
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+#include "../PCH.h"
 #include "RE/A/ActorState.h"
 #include "RE/B/BSFixedString.h"
 #include "RE/P/PlayerCharacter.h"
 #include "RE/U/UI.h"
 
 namespace BowInput {
-    bool InputGate::IsAttackEvent(std::string_view ue) noexcept {
-        using namespace std::literals;
-        return ue == "Left Attack Attack/Block"sv || ue == "Right Attack/Block"sv;
+    namespace {
+        struct InternedUserEvents {
+            RE::BSFixedString shout{"Shout"};
+            RE::BSFixedString readyWeapon{"Ready Weapon"};
+            RE::BSFixedString leftAttack{"Left Attack Attack/Block"};
+            RE::BSFixedString rightAttack{"Right Attack/Block"};
+        };
+
+        const InternedUserEvents& UserEvents() {
+            static const InternedUserEvents s;  // NOSONAR
+            return s;
+        }
+
+        constexpr std::size_t kMaxBlockingMenus = 64;
+
+        class MenuWatcher final : public RE::BSTEventSink<RE::MenuOpenCloseEvent> {
+        public:
+            static MenuWatcher* GetSingleton() {
+                static MenuWatcher s;  // NOSONAR
+                return &s;
+            }
+
+            RE::BSEventNotifyControl ProcessEvent(const RE::MenuOpenCloseEvent* ev,
+                                                  RE::BSTEventSource<RE::MenuOpenCloseEvent>*) override {
+                if (!ev) return RE::BSEventNotifyControl::kContinue;
+
+                std::scoped_lock lk(_mutex);
+                const char* p = ev->menuName.data();
+                for (std::size_t i = 0; i < _interned.size(); ++i) {
+                    if (_interned[i].data() != p) continue;
+
+                    const std::uint64_t bit = 1ull << i;
+                    if (ev->opening) {
+                        mask.fetch_or(bit, std::memory_order_relaxed);
+                    } else {
+                        mask.fetch_and(~bit, std::memory_order_relaxed);
+                    }
+                    break;
+                }
+                return RE::BSEventNotifyControl::kContinue;
+            }
+
+            void SetNames(const std::vector<std::string>& names) {
+                std::scoped_lock lk(_mutex);
+                _names.assign(names.begin(), names.begin() + std::min(names.size(), kMaxBlockingMenus));
+                if (names.size() > kMaxBlockingMenus) {
+                    spdlog::warn("[INTEGRATEDBOW][InputGate] Only the first {} BlockingMenus are used",
+                                 kMaxBlockingMenus);
+                }
+                if (_registered) {
+                    CompileLocked();
+                }
+            }
+
+            void Register() {
+                auto* ui = RE::UI::GetSingleton();
+                if (!ui) return;
+
+                std::scoped_lock lk(_mutex);
+                if (!_registered) {
+                    ui->AddEventSink<RE::MenuOpenCloseEvent>(this);
+                    _registered = true;
+                }
+                CompileLocked();
+            }
+
+            std::atomic<std::uint64_t> mask{0};
+
+        private:
+            MenuWatcher() = default;
+
+            // Interns the names and seeds the mask from the menus that are already open.
+            void CompileLocked() {
+                _interned.clear();
+                _interned.reserve(_names.size());
+
+                auto* ui = RE::UI::GetSingleton();
+                std::uint64_t seeded = 0;
+                for (std::size_t i = 0; i < _names.size(); ++i) {
+                    _interned.emplace_back(_names[i]);
+                    if (ui && ui->IsMenuOpen(_interned.back())) {
+                        seeded |= 1ull << i;
+                    }
+                }
+                mask.store(seeded, std::memory_order_relaxed);
+            }
+
+            std::mutex _mutex;
+            std::vector<std::string> _names;
+            std::vector<RE::BSFixedString> _interned;
+            bool _registered{false};
+        };
+    }
+
+    void InputGate::SetBlockingMenus(const std::vector<std::string>& names) {
+        MenuWatcher::GetSingleton()->SetNames(names);
+    }
+
+    void InputGate::RegisterMenuWatcher() { MenuWatcher::GetSingleton()->Register(); }
+
+    std::uint64_t InputGate::OpenBlockingMenus() noexcept {
+        return MenuWatcher::GetSingleton()->mask.load(std::memory_order_relaxed);
+    }
+
+    UserEventKind InputGate::ClassifyUserEvent(const RE::BSFixedString& ue) noexcept {
+        const char* p = ue.data();
+        if (!p) return UserEventKind::Other;
+
+        const auto& names = UserEvents();
+        if (p == names.rightAttack.data() || p == names.leftAttack.data()) return UserEventKind::Attack;
+        if (p == names.shout.data()) return UserEventKind::Shout;
+        if (p == names.readyWeapon.data()) return UserEventKind::ReadyWeapon;
+        return UserEventKind::Other;
     }
 
     bool IsPlayerStateBlockingInput(RE::PlayerCharacter* player) noexcept {
@@ -50,35 +165,7 @@ namespace BowInput {
         if (!ui) return false;
         if (ui->GameIsPaused()) return true;
 
-        static const RE::BSFixedString inventoryMenu{"InventoryMenu"};
-        static const RE::BSFixedString magicMenu{"MagicMenu"};
-        static const RE::BSFixedString statsMenu{"StatsMenu"};
-        static const RE::BSFixedString mapMenu{"MapMenu"};
-        static const RE::BSFixedString journalMenu{"Journal Menu"};
-        static const RE::BSFixedString favoritesMenu{"FavoritesMenu"};
-        static const RE::BSFixedString containerMenu{"ContainerMenu"};
-        static const RE::BSFixedString barterMenu{"BarterMenu"};
-        static const RE::BSFixedString trainingMenu{"Training Menu"};
-        static const RE::BSFixedString craftingMenu{"Crafting Menu"};
-        static const RE::BSFixedString giftMenu{"GiftMenu"};
-        static const RE::BSFixedString lockpickingMenu{"Lockpicking Menu"};
-        static const RE::BSFixedString sleepWaitMenu{"Sleep/Wait Menu"};
-        static const RE::BSFixedString loadingMenu{"Loading Menu"};
-        static const RE::BSFixedString mainMenu{"Main Menu"};
-        static const RE::BSFixedString console{"Console"};
-        static const RE::BSFixedString dialogueMenu{"Dialogue Menu"};
-        static const RE::BSFixedString dialogueTopicMenu{"Dialogue Topic Menu"};
-        static const RE::BSFixedString ostimMenu{"OstimSceneMenu"};
-        static const RE::BSFixedString faderMenu{"Fader Menu"};
-
-        if (static const RE::BSFixedString mcm{"Mod Configuration Menu"};
-            ui->IsMenuOpen(inventoryMenu) || ui->IsMenuOpen(magicMenu) || ui->IsMenuOpen(statsMenu) ||
-            ui->IsMenuOpen(mapMenu) || ui->IsMenuOpen(journalMenu) || ui->IsMenuOpen(favoritesMenu) ||
-            ui->IsMenuOpen(containerMenu) || ui->IsMenuOpen(barterMenu) || ui->IsMenuOpen(trainingMenu) ||
-            ui->IsMenuOpen(craftingMenu) || ui->IsMenuOpen(giftMenu) || ui->IsMenuOpen(lockpickingMenu) ||
-            ui->IsMenuOpen(sleepWaitMenu) || ui->IsMenuOpen(loadingMenu) || ui->IsMenuOpen(mainMenu) ||
-            ui->IsMenuOpen(console) || ui->IsMenuOpen(mcm) || ui->IsMenuOpen(dialogueMenu) ||
-            ui->IsMenuOpen(dialogueTopicMenu) || ui->IsMenuOpen(ostimMenu) || ui->IsMenuOpen(faderMenu)) {
+        if (OpenBlockingMenus() != 0) {
             return true;
         }
 
@@ -1,9 +1,31 @@
 #pragma once
-#include <string_view>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "RE/B/BSFixedString.h"
 
 namespace BowInput {
+    enum class UserEventKind : std::uint8_t {
+        Other = 0,
+        Shout,
+        ReadyWeapon,
+        Attack,
+    };
+
     struct InputGate {
         static bool IsInputBlockedByMenus();
-        static bool IsAttackEvent(std::string_view ue) noexcept;
+
+        // Blocking menus are tracked by a MenuOpenCloseEvent sink as one bit per configured menu (max 64).
+        // Names are only interned once the watcher is registered, so this may be called before kDataLoaded.
+        static void SetBlockingMenus(const std::vector<std::string>& names);
+        static void RegisterMenuWatcher();
+        [[nodiscard]] static std::uint64_t OpenBlockingMenus() noexcept;
+
+        // User-event names are pooled by the engine, so this is a handful of pointer compares.
+        [[nodiscard]] static UserEventKind ClassifyUserEvent(const RE::BSFixedString& ue) noexcept;
+        [[nodiscard]] static bool IsAttackEvent(const RE::BSFixedString& ue) noexcept {
+            return ClassifyUserEvent(ue) == UserEventKind::Attack;
+        }
     };
 }
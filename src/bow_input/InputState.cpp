@@ -1,7 +1,6 @@
 #include "InputState.h"
 
 #include <cassert>
-#include <ranges>
 
 namespace BowInput {
     InputState& Inputs() noexcept {
@@ -10,26 +9,20 @@ namespace BowInput {
     }
 
     void InputState::Clear() {
-        for (auto& v : kbDown) v.store(false, std::memory_order_relaxed);
-        for (auto& v : gpDown) v.store(false, std::memory_order_relaxed);
-
-        kbDownList.clear();
-        gpDownList.clear();
+        kb.Clear();
+        gp.Clear();
     }
 
     namespace {
-        inline void DownListAdd(std::vector<int>& list, int code) {
-            if (std::ranges::find(list, code) == list.end()) {
-                list.push_back(code);
+        template <class Set>
+        inline void Apply(Set& set, int slot, int code, bool isPressed, bool isDownEdge, bool isUpEdge) {
+            if (slot == kInvalidSlot) {
+                return;
             }
-        }
 
-        inline void DownListRemove(std::vector<int>& list, int code) {
-            auto it = std::ranges::find(list, code);
-            if (it != list.end()) {
-                *it = list.back();
-                list.pop_back();
-            }
+            set.SetPressed(slot, isPressed);
+            if (isDownEdge) set.Add(slot, code);
+            if (isUpEdge) set.Remove(slot);
         }
     }
 
@@ -38,17 +31,24 @@ namespace BowInput {
             return;
         }
 
-        const auto idx = static_cast<std::size_t>(code);
-
         if (dev == RE::INPUT_DEVICE::kKeyboard) {
-            kbDown[idx].store(isPressed, std::memory_order_relaxed);
-            if (isDownEdge) DownListAdd(kbDownList, code);
-            if (isUpEdge) DownListRemove(kbDownList, code);
+            Apply(kb, InputUtil::KeyboardSlot(code), code, isPressed, isDownEdge, isUpEdge);
 
         } else if (dev == RE::INPUT_DEVICE::kGamepad) {
-            gpDown[idx].store(isPressed, std::memory_order_relaxed);
-            if (isDownEdge) DownListAdd(gpDownList, code);
-            if (isUpEdge) DownListRemove(gpDownList, code);
+            Apply(gp, InputUtil::GamepadSlot(code), code, isPressed, isDownEdge, isUpEdge);
+        }
+    }
+
+    bool InputState::IsDown(RE::INPUT_DEVICE dev, int code) const noexcept {
+        switch (dev) {
+            case RE::INPUT_DEVICE::kKeyboard:
+                return kb.IsPressedSlot(InputUtil::KeyboardSlot(code));
+
+            case RE::INPUT_DEVICE::kGamepad:
+                return gp.IsPressedSlot(InputUtil::GamepadSlot(code));
+
+            default:
+                return false;
         }
     }
 
@@ -57,14 +57,14 @@ namespace BowInput {
             case RE::INPUT_DEVICE::kKeyboard:
 
             case RE::INPUT_DEVICE::kMouse:
-                return std::span<const int>(kbDownList);
+                return kb.List();
 
             case RE::INPUT_DEVICE::kGamepad:
-                return std::span<const int>(gpDownList);
+                return gp.List();
 
             default:
                 assert(false && "InputState::DownList: device não suportado");
                 return {};
         }
     }
-}
\ No newline at end of file
+}
@@ -1,16 +1,31 @@
 #pragma once
 #include <array>
 #include <atomic>
+#include <bit>
 #include <cassert>
 #include <cstdint>
 #include <span>
-#include <vector>
 
-#include "RE/I/InputEvent.h"
+#include "RE/I/InputDevices.h"
 
 namespace BowInput {
     constexpr int kMaxCode = 65536;
 
+    // DirectInput scan codes fit in a byte; Skyrim's gamepad codes are the XInput button masks plus the two
+    // trigger ids (0x9 / 0xA), which fold into 32 dense slots.
+    constexpr std::size_t kKeyboardSlots = 256;
+    constexpr std::size_t kGamepadSlots = 32;
+    constexpr int kInvalidSlot = -1;
+
+    constexpr int kDIK_W = 0x11;
+    constexpr int kDIK_A = 0x1E;
+    constexpr int kDIK_S = 0x1F;
+    constexpr int kDIK_D = 0x20;
+
+    // Keys the exclusive-hotkey check tolerates next to a combo or pattern (movement / camera).
+    inline constexpr std::array<int, 4> kAllowedExtras_Keyboard_MoveOrCamera{kDIK_W, kDIK_A, kDIK_S, kDIK_D};
+    inline constexpr std::array<int, 0> kAllowedExtras_Gamepad_MoveOrCamera{};
+
     namespace InputUtil {
 
         [[nodiscard]] inline int NormalizePadCode(int v) noexcept {
@@ -22,26 +37,111 @@ namespace BowInput {
         [[nodiscard]] inline int EncodeCapture(RE::INPUT_DEVICE dev, int code) noexcept {
             return (dev == RE::INPUT_DEVICE::kGamepad) ? (-code - 1) : code;
         }
+
+        [[nodiscard]] constexpr int KeyboardSlot(int code) noexcept {
+            return (code >= 0 && code < static_cast<int>(kKeyboardSlots)) ? code : kInvalidSlot;
+        }
+
+        [[nodiscard]] constexpr int GamepadSlot(int code) noexcept {
+            if (code >= 0 && code < 0x10) return code;
+            if (code >= 0x10 && code <= 0x8000 && std::has_single_bit(static_cast<unsigned>(code))) {
+                return 12 + std::countr_zero(static_cast<unsigned>(code));
+            }
+            return kInvalidSlot;
+        }
     }
 
-    struct InputState {
-        std::array<std::atomic_bool, kMaxCode> kbDown{};
-        std::array<std::atomic_bool, kMaxCode> gpDown{};
+    template <std::size_t N, auto SlotFn>
+    struct DownSet {
+        static constexpr std::size_t kWords = (N + 63) / 64;
+
+        [[nodiscard]] static constexpr int SlotOf(int code) noexcept { return SlotFn(code); }
 
-        std::vector<int> kbDownList;
-        std::vector<int> gpDownList;
+        // Pressed state as last reported by the device, one bit per slot.
+        std::array<std::atomic<std::uint64_t>, kWords> pressed{};
 
-        InputState() {
-            kbDownList.reserve(32);
-            gpDownList.reserve(32);
+        // Sparse set of codes that saw a down edge and no up edge yet. `listed` answers membership,
+        // `sparse` locates the entry inside `dense` so removal is a swap-and-pop.
+        std::array<std::uint64_t, kWords> listed{};
+        std::array<int, N> dense{};
+        std::array<std::uint16_t, N> sparse{};
+        std::uint16_t count{0};
+
+        [[nodiscard]] static constexpr std::uint64_t Bit(int slot) noexcept {
+            return std::uint64_t{1} << (static_cast<unsigned>(slot) & 63u);
+        }
+
+        [[nodiscard]] bool IsPressedSlot(int slot) const noexcept {
+            if (slot < 0 || static_cast<std::size_t>(slot) >= N) return false;
+            return (pressed[static_cast<std::size_t>(slot) >> 6].load(std::memory_order_relaxed) & Bit(slot)) != 0;
+        }
+
+        [[nodiscard]] bool IsListedSlot(int slot) const noexcept {
+            return (listed[static_cast<std::size_t>(slot) >> 6] & Bit(slot)) != 0;
+        }
+
+        // Only the input thread writes, so a plain load/store does; a locked read-modify-write per button event
+        // cost more than the 64K atomic_bool stores this replaced. Holds repeat every frame and store nothing.
+        void SetPressed(int slot, bool down) noexcept {
+            auto& w = pressed[static_cast<std::size_t>(slot) >> 6];
+            const std::uint64_t cur = w.load(std::memory_order_relaxed);
+            const std::uint64_t next = down ? (cur | Bit(slot)) : (cur & ~Bit(slot));
+            if (next != cur) w.store(next, std::memory_order_relaxed);
         }
 
+        void Add(int slot, int code) noexcept {
+            if (IsListedSlot(slot)) return;
+            listed[static_cast<std::size_t>(slot) >> 6] |= Bit(slot);
+            sparse[static_cast<std::size_t>(slot)] = count;
+            dense[count] = code;
+            ++count;
+        }
+
+        void Remove(int slot) noexcept {
+            if (!IsListedSlot(slot)) return;
+            listed[static_cast<std::size_t>(slot) >> 6] &= ~Bit(slot);
+
+            const std::uint16_t pos = sparse[static_cast<std::size_t>(slot)];
+            --count;
+            if (pos != count) {
+                dense[pos] = dense[count];
+                sparse[static_cast<std::size_t>(SlotOf(dense[pos]))] = pos;
+            }
+        }
+
+        void Clear() noexcept {
+            for (auto& w : pressed) w.store(0, std::memory_order_relaxed);
+            listed.fill(0);
+            count = 0;
+        }
+
+        [[nodiscard]] std::span<const int> List() const noexcept { return {dense.data(), count}; }
+
+        // Keys that are both pressed and listed, i.e. what exclusivity checks consider "held".
+        [[nodiscard]] std::uint64_t HeldWord(std::size_t i) const noexcept {
+            return pressed[i].load(std::memory_order_relaxed) & listed[i];
+        }
+
+        [[nodiscard]] std::uint64_t PressedWord(std::size_t i) const noexcept {
+            return pressed[i].load(std::memory_order_relaxed);
+        }
+    };
+
+    using KeyboardDownSet = DownSet<kKeyboardSlots, InputUtil::KeyboardSlot>;
+    using GamepadDownSet = DownSet<kGamepadSlots, InputUtil::GamepadSlot>;
+
+    struct InputState {
+        KeyboardDownSet kb;
+        GamepadDownSet gp;
+
         void Clear();
 
         void OnButton(RE::INPUT_DEVICE dev, int code, bool isPressed, bool isDownEdge, bool isUpEdge);
 
+        [[nodiscard]] bool IsDown(RE::INPUT_DEVICE dev, int code) const noexcept;
+
         [[nodiscard]] std::span<const int> DownList(RE::INPUT_DEVICE dev) const;
     };
 
     InputState& Inputs() noexcept;
-}
\ No newline at end of file
+}
@@ -0,0 +1,197 @@
+#include "InputTrace.h"
+
+#ifdef _WIN32
+    #include <Windows.h>
+    #ifdef GetObject
+        #undef GetObject
+    #endif
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+#include "../PCH.h"
+
+namespace BowInput::InputTrace {
+    namespace {
+        struct Mapping {
+#ifdef _WIN32
+            HANDLE file{INVALID_HANDLE_VALUE};
+            HANDLE mapping{nullptr};
+#else
+            int fd{-1};
+            std::size_t bytes{0};
+#endif
+            std::byte* view{nullptr};
+
+            Header* header{nullptr};
+            char* names{nullptr};
+            Record* records{nullptr};
+
+            // Engine user-event strings are interned, so the data pointer identifies the event.
+            const char* internedPtrs[kMaxUserEvents]{};
+
+            ~Mapping() { Reset(); }
+
+            void Reset() noexcept {
+#ifdef _WIN32
+                if (view) {
+                    ::FlushViewOfFile(view, 0);
+                    ::UnmapViewOfFile(view);
+                }
+                if (mapping) ::CloseHandle(mapping);
+                if (file != INVALID_HANDLE_VALUE) ::CloseHandle(file);
+
+                file = INVALID_HANDLE_VALUE;
+                mapping = nullptr;
+#else
+                if (view) {
+                    ::msync(view, bytes, MS_ASYNC);
+                    ::munmap(view, bytes);
+                }
+                if (fd >= 0) ::close(fd);
+
+                fd = -1;
+                bytes = 0;
+#endif
+                view = nullptr;
+                header = nullptr;
+                names = nullptr;
+                records = nullptr;
+                std::fill(std::begin(internedPtrs), std::end(internedPtrs), nullptr);
+            }
+        };
+
+        Mapping& Map() noexcept {
+            static Mapping s;  // NOSONAR
+            return s;
+        }
+
+        constexpr std::size_t kNamesBytes = std::size_t{kMaxUserEvents} * kUserEventNameLen;
+
+        std::uint16_t InternUserEvent(Mapping& m, const char* name) noexcept {
+            if (!name || !*name) {
+                return kNoUserEvent;
+            }
+
+            const std::uint32_t count = m.header->userEventCount;
+            for (std::uint32_t i = 0; i < count; ++i) {
+                if (m.internedPtrs[i] == name) return static_cast<std::uint16_t>(i);
+            }
+
+            if (count >= kMaxUserEvents) {
+                return kNoUserEvent;
+            }
+
+            char* slot = m.names + std::size_t{count} * kUserEventNameLen;
+            std::strncpy(slot, name, kUserEventNameLen - 1);
+            slot[kUserEventNameLen - 1] = '\0';
+            m.internedPtrs[count] = name;
+            m.header->userEventCount = count + 1;
+            return static_cast<std::uint16_t>(count);
+        }
+
+        void Push(Mapping& m, const Record& r) noexcept {
+            const std::uint64_t idx = m.header->written;
+            m.records[idx % m.header->capacity] = r;
+            m.header->written = idx + 1;
+        }
+    }
+
+    bool Open(const std::filesystem::path& path, std::uint32_t capacity) {
+        Close();
+        if (capacity == 0) {
+            return false;
+        }
+
+        auto& m = Map();
+        const std::uint64_t bytes = sizeof(Header) + kNamesBytes + std::uint64_t{capacity} * sizeof(Record);
+
+#ifdef _WIN32
+        m.file = ::CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS,
+                               FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (m.file == INVALID_HANDLE_VALUE) {
+            spdlog::warn("[INTEGRATEDBOW][InputTrace] Could not create {}", path.string());
+            return false;
+        }
+
+        m.mapping = ::CreateFileMappingW(m.file, nullptr, PAGE_READWRITE, static_cast<DWORD>(bytes >> 32),
+                                         static_cast<DWORD>(bytes & 0xFFFFFFFFu), nullptr);
+        if (m.mapping) {
+            m.view = static_cast<std::byte*>(::MapViewOfFile(m.mapping, FILE_MAP_WRITE, 0, 0, 0));
+        }
+#else
+        m.fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (m.fd < 0) {
+            spdlog::warn("[INTEGRATEDBOW][InputTrace] Could not create {}", path.string());
+            return false;
+        }
+
+        if (::ftruncate(m.fd, static_cast<off_t>(bytes)) == 0) {
+            void* view = ::mmap(nullptr, static_cast<std::size_t>(bytes), PROT_READ | PROT_WRITE, MAP_SHARED, m.fd, 0);
+            if (view != MAP_FAILED) {
+                m.view = static_cast<std::byte*>(view);
+                m.bytes = static_cast<std::size_t>(bytes);
+            }
+        }
+#endif
+        if (!m.view) {
+            spdlog::warn("[INTEGRATEDBOW][InputTrace] Could not map {} ({} bytes)", path.string(), bytes);
+            m.Reset();
+            return false;
+        }
+
+        m.header = reinterpret_cast<Header*>(m.view);  // NOSONAR - layout do arquivo
+        m.names = reinterpret_cast<char*>(m.view + sizeof(Header));
+        m.records = reinterpret_cast<Record*>(m.view + sizeof(Header) + kNamesBytes);  // NOSONAR
+
+        std::memcpy(m.header->magic, kMagic, sizeof(kMagic));
+        m.header->version = kVersion;
+        m.header->recordSize = sizeof(Record);
+        m.header->capacity = capacity;
+        m.header->userEventCount = 0;
+        m.header->written = 0;
+        m.header->frames = 0;
+
+        detail::EnabledFlag() = true;
+        spdlog::info("[INTEGRATEDBOW][InputTrace] Recording to {} ({} records)", path.string(), capacity);
+        return true;
+    }
+
+    void Close() {
+        detail::EnabledFlag() = false;
+        Map().Reset();
+    }
+
+    void RecordFrame(float dt) noexcept {
+        auto& m = Map();
+        if (!m.header) return;
+
+        Record r{};
+        r.frame = ++m.header->frames;
+        r.dt = dt;
+        r.userEvent = kNoUserEvent;
+        r.flags = kFrame;
+        Push(m, r);
+    }
+
+    void RecordButton(int device, int idCode, bool pressed, bool down, bool up, float heldDownSecs,
+                      const char* userEvent, bool synthetic) noexcept {
+        auto& m = Map();
+        if (!m.header) return;
+
+        Record r{};
+        r.frame = m.header->frames;
+        r.heldDownSecs = heldDownSecs;
+        r.idCode = static_cast<std::uint16_t>(idCode);
+        r.userEvent = InternUserEvent(m, userEvent);
+        r.device = static_cast<std::uint8_t>(device);
+        r.flags = static_cast<std::uint8_t>((pressed ? kPressed : 0) | (down ? kDown : 0) | (up ? kUp : 0) |
+                                            (synthetic ? kSynthetic : 0));
+        Push(m, r);
+    }
+}
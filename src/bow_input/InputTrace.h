@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+
+namespace BowInput::InputTrace {
+    // On-disk layout: Header, then kMaxUserEvents names of kUserEventNameLen bytes, then `capacity` records
+    // written as a ring. `written` counts every record ever written, so the oldest live record is
+    // written - min(written, capacity).
+    inline constexpr char kMagic[8] = {'I', 'B', 'T', 'R', 'A', 'C', 'E', '1'};
+    inline constexpr std::uint32_t kVersion = 2;
+    inline constexpr std::uint32_t kMaxUserEvents = 64;
+    inline constexpr std::uint32_t kUserEventNameLen = 32;
+    inline constexpr std::uint16_t kNoUserEvent = 0xFFFF;
+
+    enum Flags : std::uint8_t {
+        kPressed = 1u << 0,
+        kDown = 1u << 1,
+        kUp = 1u << 2,
+        kFrame = 1u << 3,      // frame marker: only `frame` and `dt` are meaningful
+        kSynthetic = 1u << 4,  // injected by the plugin itself; a replay regenerates these
+    };
+
+    struct Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t recordSize;
+        std::uint32_t capacity;
+        std::uint32_t userEventCount;
+        std::uint64_t written;
+        std::uint64_t frames;
+    };
+
+    struct Record {
+        std::uint64_t frame;
+        float dt;
+        float heldDownSecs;
+        std::uint16_t idCode;
+        std::uint16_t userEvent;
+        std::uint8_t device;
+        std::uint8_t flags;
+        std::uint8_t pad[2];
+    };
+    static_assert(sizeof(Record) == 24);
+
+    // Maps `path` and starts recording; `capacity` is the ring size in records. Returns false on failure.
+    bool Open(const std::filesystem::path& path, std::uint32_t capacity);
+    void Close();
+
+    namespace detail {
+        inline bool& EnabledFlag() noexcept {
+            static bool s{false};  // NOSONAR
+            return s;
+        }
+    }
+
+    // Call sites test this before building any record, so a disabled recorder costs one load per event.
+    [[nodiscard]] inline bool Enabled() noexcept { return detail::EnabledFlag(); }
+
+    void RecordFrame(float dt) noexcept;
+    // `userEvent` must be an engine-interned string (BSFixedString data); it is identified by pointer.
+    void RecordButton(int device, int idCode, bool pressed, bool down, bool up, float heldDownSecs,
+                      const char* userEvent, bool synthetic) noexcept;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace BowInput {
+    // Bounded multi-producer / single-consumer ring (Vyukov's sequence-per-cell queue with the consumer side
+    // simplified to a plain index). Producers never block; TryPush fails when the ring is full.
+    template <class T, std::size_t N>
+    class MpscRing {
+        static_assert(std::has_single_bit(N), "MpscRing capacity must be a power of two");
+
+    public:
+        static constexpr std::size_t kCapacity = N;
+
+        MpscRing() noexcept {
+            for (std::size_t i = 0; i < N; ++i) {
+                _cells[i].seq.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        MpscRing(const MpscRing&) = delete;
+        MpscRing& operator=(const MpscRing&) = delete;
+
+        bool TryPush(const T& value) noexcept {
+            std::size_t pos = _tail.load(std::memory_order_relaxed);
+            for (;;) {
+                Cell& cell = _cells[pos & kMask];
+                const std::size_t seq = cell.seq.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+                if (diff == 0) {
+                    if (_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        cell.value = value;
+                        cell.seq.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = _tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // Consumer only. May briefly report nothing while a producer that already claimed a cell is still
+        // writing it; that element is picked up on the next call.
+        bool TryPop(T& out) noexcept {
+            Cell& cell = _cells[_head & kMask];
+            if (cell.seq.load(std::memory_order_acquire) != _head + 1) {
+                return false;
+            }
+
+            out = cell.value;
+            cell.seq.store(_head + N, std::memory_order_release);
+            ++_head;
+            return true;
+        }
+
+        // Consumer only: one relaxed load, cheap enough to call on every poll.
+        [[nodiscard]] bool EmptyRelaxed() const noexcept { return _tail.load(std::memory_order_relaxed) == _head; }
+
+    private:
+        static constexpr std::size_t kMask = N - 1;
+
+        struct Cell {
+            std::atomic<std::size_t> seq{0};
+            T value{};
+        };
+
+        alignas(64) std::atomic<std::size_t> _tail{0};
+        alignas(64) std::size_t _head{0};
+        alignas(64) std::array<Cell, N> _cells{};
+    };
+}
@@ -0,0 +1,91 @@
+#include "StageProfiler.h"
+
+#if defined(INTEGRATEDBOW_STAGE_PROFILER)
+
+    #include <algorithm>
+    #include <array>
+    #include <atomic>
+    #include <bit>
+
+namespace BowInput::Profiler {
+    namespace {
+        constexpr std::size_t kStages = static_cast<std::size_t>(Stage::Count);
+
+        constexpr std::array<const char*, kStages> kNames{"Buttons",      "Menu gate",    "Timers",
+                                                          "Hotkey tick",  "Smart mode",   "Exit pending",
+                                                          "Attack pumps", "Deferred finalize"};
+
+        struct Histogram {
+            std::array<std::atomic<std::uint32_t>, kBuckets> buckets{};
+            std::atomic<std::uint64_t> maxNs{0};
+        };
+
+        std::array<Histogram, kStages>& Histograms() noexcept {
+            static std::array<Histogram, kStages> s{};  // NOSONAR
+            return s;
+        }
+
+        // Only the input thread records, so plain load/store pairs avoid locked adds on the hot path.
+        template <class T>
+        inline void Bump(std::atomic<T>& v) noexcept {
+            v.store(v.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+
+        std::uint64_t BucketUpperNs(std::size_t b) noexcept { return std::uint64_t{1} << b; }
+    }
+
+    void Record(Stage stage, std::uint64_t ns) noexcept {
+        auto& h = Histograms()[static_cast<std::size_t>(stage)];
+        const auto b = std::min<std::size_t>(static_cast<std::size_t>(std::bit_width(ns)), kBuckets - 1);
+
+        Bump(h.buckets[b]);
+        if (ns > h.maxNs.load(std::memory_order_relaxed)) {
+            h.maxNs.store(ns, std::memory_order_relaxed);
+        }
+    }
+
+    StageSummary Summarize(Stage stage) noexcept {
+        const auto& h = Histograms()[static_cast<std::size_t>(stage)];
+
+        std::array<std::uint32_t, kBuckets> snap{};
+        std::uint64_t total = 0;
+        for (std::size_t b = 0; b < kBuckets; ++b) {
+            snap[b] = h.buckets[b].load(std::memory_order_relaxed);
+            total += snap[b];
+        }
+
+        StageSummary s{};
+        s.count = total;
+        s.maxNs = h.maxNs.load(std::memory_order_relaxed);
+        if (total == 0) {
+            return s;
+        }
+
+        const std::uint64_t rank50 = (total + 1) / 2;
+        const std::uint64_t rank99 = total - total / 100;
+        std::uint64_t seen = 0;
+        for (std::size_t b = 0; b < kBuckets; ++b) {
+            seen += snap[b];
+            if (s.p50Ns == 0 && seen >= rank50) s.p50Ns = std::min(BucketUpperNs(b), s.maxNs);
+            if (seen >= rank99) {
+                s.p99Ns = std::min(BucketUpperNs(b), s.maxNs);
+                break;
+            }
+        }
+        return s;
+    }
+
+    const char* Name(Stage stage) noexcept {
+        const auto i = static_cast<std::size_t>(stage);
+        return i < kStages ? kNames[i] : "?";
+    }
+
+    void Reset() noexcept {
+        for (auto& h : Histograms()) {
+            for (auto& b : h.buckets) b.store(0, std::memory_order_relaxed);
+            h.maxNs.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#if defined(INTEGRATEDBOW_STAGE_PROFILER)
+    #include <chrono>
+#endif
+
+// Per-stage timing for the full input frame. Built only with INTEGRATEDBOW_STAGE_PROFILER (CMake option of the
+// same name); otherwise Timed is a plain call and nothing else is compiled in.
+namespace BowInput::Profiler {
+    enum class Stage : std::uint8_t {
+        Buttons,
+        MenuGate,
+        Timers,
+        HotkeyTick,
+        SmartMode,
+        ExitPending,
+        AttackPumps,
+        DeferredFinalize,
+        Count
+    };
+
+    // Bucket b counts samples in [2^(b-1), 2^b) ns; the last bucket takes everything longer.
+    inline constexpr std::size_t kBuckets = 32;
+
+    struct StageSummary {
+        std::uint64_t count{0};
+        std::uint64_t p50Ns{0};
+        std::uint64_t p99Ns{0};
+        std::uint64_t maxNs{0};
+    };
+
+#if defined(INTEGRATEDBOW_STAGE_PROFILER)
+    inline constexpr bool kEnabled = true;
+
+    void Record(Stage stage, std::uint64_t ns) noexcept;
+
+    // Percentiles resolve to the upper bound of their bucket; max is exact.
+    [[nodiscard]] StageSummary Summarize(Stage stage) noexcept;
+    [[nodiscard]] const char* Name(Stage stage) noexcept;
+    void Reset() noexcept;
+
+    template <class Fn>
+    decltype(auto) Timed(Stage stage, Fn&& fn) {
+        using clock = std::chrono::steady_clock;
+
+        struct Scope {
+            Stage stage;
+            clock::time_point start{clock::now()};
+            ~Scope() {
+                const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+                Record(stage, static_cast<std::uint64_t>(ns));
+            }
+        } scope{stage};
+
+        return std::forward<Fn>(fn)();
+    }
+#else
+    inline constexpr bool kEnabled = false;
+
+    template <class Fn>
+    decltype(auto) Timed(Stage, Fn&& fn) {
+        return std::forward<Fn>(fn)();
+    }
+#endif
+}
@@ -0,0 +1,282 @@
+#include "TimerWheel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <mutex>
+
+#include "../PCH.h"
+#include "ArmedState.h"
+#include "FrameClock.h"
+
+namespace BowInput {
+    namespace {
+        constexpr std::uint64_t kSlotMask = TimerWheel::kSlots - 1;
+
+        constexpr std::uint16_t IndexOf(TimerWheel::Handle h) noexcept {
+            return static_cast<std::uint16_t>((h & 0xFFFFu) - 1u);
+        }
+
+        // Bits below the given shift, saturating for the top level's partial width.
+        constexpr std::uint64_t LowMask(std::size_t bits) noexcept {
+            return bits >= 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << bits) - 1;
+        }
+
+        constexpr std::uint16_t GenOf(TimerWheel::Handle h) noexcept { return static_cast<std::uint16_t>(h >> 16); }
+    }
+
+    TimerWheel::TimerWheel(std::uint64_t nowMs) noexcept : _now(nowMs) {
+        for (auto& level : _levels) {
+            level.heads.fill(kNil);
+        }
+        for (std::size_t i = kMaxTimers; i-- > 0;) {
+            _nodes[i].next = _free;
+            _free = static_cast<std::uint16_t>(i);
+        }
+    }
+
+    TimerWheel::Handle TimerWheel::Arm(std::uint64_t deadlineMs, TimerCallback cb, std::uintptr_t ctx) noexcept {
+        if (!cb || _free == kNil) {
+            return kNone;
+        }
+
+        const std::uint16_t idx = _free;
+        Node& n = _nodes[idx];
+        _free = n.next;
+
+        n.deadline = std::max(deadlineMs, _now + 1);
+        n.cb = cb;
+        n.ctx = ctx;
+        n.active = true;
+        ++_pending;
+        Place(idx);
+
+        return (static_cast<Handle>(n.gen) << 16) | (static_cast<Handle>(idx) + 1u);
+    }
+
+    bool TimerWheel::Cancel(Handle& h) noexcept {
+        const bool pending = IsPending(h);
+        if (pending) {
+            const std::uint16_t idx = IndexOf(h);
+            Unlink(idx);
+            Release(idx);
+        }
+        h = kNone;
+        return pending;
+    }
+
+    bool TimerWheel::IsPending(Handle h) const noexcept {
+        if (h == kNone) {
+            return false;
+        }
+        const std::uint16_t idx = IndexOf(h);
+        return idx < kMaxTimers && _nodes[idx].active && _nodes[idx].gen == GenOf(h);
+    }
+
+    std::size_t TimerWheel::Advance(std::uint64_t nowMs) {
+        std::size_t fired = 0;
+        TimerCallback cb = nullptr;
+        std::uintptr_t ctx = 0;
+        while (PopDue(nowMs, cb, ctx)) {
+            cb(ctx);
+            ++fired;
+        }
+        return fired;
+    }
+
+    // One node per call, so callbacks may arm or cancel freely in between, including timers in this same slot.
+    bool TimerWheel::PopDue(std::uint64_t nowMs, TimerCallback& cb, std::uintptr_t& ctx) noexcept {
+        while (true) {
+            // Only a timer due exactly now can share the clock's level-0 slot; later ones sit ahead of it.
+            if (const std::uint16_t idx = _levels[0].heads[static_cast<std::size_t>(_now & kSlotMask)]; idx != kNil) {
+                cb = _nodes[idx].cb;
+                ctx = _nodes[idx].ctx;
+                Unlink(idx);
+                Release(idx);
+                return true;
+            }
+
+            if (_pending == 0 || _now >= nowMs) {
+                break;
+            }
+            const std::uint64_t next = NextEvent();
+            if (next > nowMs) {
+                break;
+            }
+
+            _now = next;
+            // De cima pra baixo: o que desce de um nível pode cair num slot que também vence agora.
+            for (std::size_t level = kLevels - 1; level > 0; --level) {
+                if ((_now & LowMask(kSlotBits * level)) == 0) {
+                    Cascade(level);
+                }
+            }
+        }
+
+        _now = std::max(_now, nowMs);
+        return false;
+    }
+
+    void TimerWheel::Rebase(std::uint64_t nowMs) noexcept {
+        if (_pending == 0) {
+            _now = std::max(_now, nowMs);
+        }
+    }
+
+    void TimerWheel::Place(std::uint16_t idx) noexcept {
+        Node& n = _nodes[idx];
+        const std::uint64_t diff = n.deadline ^ _now;
+        const std::size_t level = diff == 0 ? 0 : (static_cast<std::size_t>(std::bit_width(diff)) - 1) / kSlotBits;
+        const auto slot = static_cast<std::size_t>((n.deadline >> (kSlotBits * level)) & kSlotMask);
+
+        Level& l = _levels[level];
+        n.level = static_cast<std::uint8_t>(level);
+        n.slot = static_cast<std::uint8_t>(slot);
+        n.prev = kNil;
+        n.next = l.heads[slot];
+        if (n.next != kNil) {
+            _nodes[n.next].prev = idx;
+        }
+        l.heads[slot] = idx;
+        l.occupied |= std::uint64_t{1} << slot;
+    }
+
+    void TimerWheel::Unlink(std::uint16_t idx) noexcept {
+        Node& n = _nodes[idx];
+        Level& l = _levels[n.level];
+
+        if (n.prev != kNil) {
+            _nodes[n.prev].next = n.next;
+        } else {
+            l.heads[n.slot] = n.next;
+        }
+        if (n.next != kNil) {
+            _nodes[n.next].prev = n.prev;
+        }
+        if (l.heads[n.slot] == kNil) {
+            l.occupied &= ~(std::uint64_t{1} << n.slot);
+        }
+        n.prev = kNil;
+        n.next = kNil;
+    }
+
+    void TimerWheel::Release(std::uint16_t idx) noexcept {
+        Node& n = _nodes[idx];
+        n.active = false;
+        n.cb = nullptr;
+        ++n.gen;
+        n.next = _free;
+        _free = idx;
+        --_pending;
+    }
+
+    // Earliest tick with work: a level-0 expiry or the boundary where an occupied higher slot cascades. Every
+    // occupied slot sits ahead of the clock's index on its level, so one masked scan per level is enough.
+    std::uint64_t TimerWheel::NextEvent() const noexcept {
+        std::uint64_t best = ~std::uint64_t{0};
+        for (std::size_t level = 0; level < kLevels; ++level) {
+            const std::uint64_t occupied = _levels[level].occupied;
+            if (occupied == 0) {
+                continue;
+            }
+
+            const std::size_t shift = kSlotBits * level;
+            const auto cur = static_cast<unsigned>((_now >> shift) & kSlotMask);
+            const std::uint64_t ahead = cur == kSlotMask ? 0 : occupied & (~std::uint64_t{0} << (cur + 1));
+            if (ahead == 0) {
+                continue;
+            }
+
+            const auto slot = static_cast<std::uint64_t>(std::countr_zero(ahead));
+            const std::uint64_t blockStart = _now & ~LowMask(shift + kSlotBits);
+            best = std::min(best, blockStart | (slot << shift));
+        }
+        return best;
+    }
+
+    void TimerWheel::Cascade(std::size_t level) noexcept {
+        Level& l = _levels[level];
+        const auto slot = static_cast<std::size_t>((_now >> (kSlotBits * level)) & kSlotMask);
+
+        std::uint16_t idx = l.heads[slot];
+        l.heads[slot] = kNil;
+        l.occupied &= ~(std::uint64_t{1} << slot);
+
+        while (idx != kNil) {
+            const std::uint16_t next = _nodes[idx].next;
+            Place(idx);
+            idx = next;
+        }
+    }
+
+    namespace Scheduler {
+        namespace {
+            struct Shared {
+                std::mutex mtx;
+                TimerWheel wheel;
+            };
+
+            Shared& State() noexcept {
+                static Shared s;  // NOSONAR
+                return s;
+            }
+        }
+
+        TimerWheel::Handle After(std::uint64_t delayMs, TimerCallback cb, std::uintptr_t ctx) noexcept {
+            auto& st = State();
+            // Anim events and equip hooks arm timers too, so the deadline cannot lean on the input frame's sample.
+            const std::uint64_t now = FrameClock::SampleMs();
+
+            std::unique_lock lk(st.mtx);
+            st.wheel.Rebase(now);
+
+            const auto h = st.wheel.Arm(std::max(now, st.wheel.Now()) + delayMs, cb, ctx);
+            if (h == TimerWheel::kNone) {
+                const std::size_t pending = st.wheel.Pending();
+                lk.unlock();
+
+                static std::atomic_bool s_warned{false};  // NOSONAR
+                if (!s_warned.exchange(true, std::memory_order_relaxed)) {
+                    spdlog::warn("[INTEGRATEDBOW][Timers] Timer pool exhausted ({} pending)", pending);
+                }
+                return h;
+            }
+
+            // Under the lock, so Advance cannot clear the bit between this Arm and its emptiness check.
+            Armed::Arm(Armed::Bit::Timers);
+            return h;
+        }
+
+        bool Cancel(TimerWheel::Handle& h) noexcept {
+            auto& st = State();
+            std::scoped_lock lk(st.mtx);
+            return st.wheel.Cancel(h);
+        }
+
+        bool IsPending(TimerWheel::Handle h) noexcept {
+            auto& st = State();
+            std::scoped_lock lk(st.mtx);
+            return st.wheel.IsPending(h);
+        }
+
+        // Callbacks run without the lock held: they re-enter After/Cancel, and another thread arming a timer must
+        // never wait on one.
+        void Advance() {
+            auto& st = State();
+            const std::uint64_t now = FrameClock::NowMs();
+
+            TimerCallback cb = nullptr;
+            std::uintptr_t ctx = 0;
+            while (true) {
+                {
+                    std::scoped_lock lk(st.mtx);
+                    if (st.wheel.Empty() || !st.wheel.PopDue(now, cb, ctx)) {
+                        Armed::Set(Armed::Bit::Timers, !st.wheel.Empty());
+                        return;
+                    }
+                }
+                cb(ctx);
+            }
+        }
+    }
+}
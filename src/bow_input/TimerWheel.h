@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace BowInput {
+    using TimerCallback = void (*)(std::uintptr_t ctx);
+
+    // Hierarchical timing wheel with 1 ms ticks: levels of 64 slots covering the whole 64-bit clock, each with an
+    // occupancy word, so Advance only touches slots that actually hold timers and an empty level costs one test.
+    // Nodes come from a fixed pool and are addressed by generation-tagged handles, so cancelling a timer that
+    // already fired (or whose node was reused) is a harmless no-op. Not thread-safe on its own; Scheduler wraps it.
+    class TimerWheel {
+    public:
+        using Handle = std::uint32_t;
+        static constexpr Handle kNone = 0;
+
+        static constexpr std::size_t kSlotBits = 6;
+        static constexpr std::size_t kSlots = std::size_t{1} << kSlotBits;
+        static constexpr std::size_t kLevels = (64 + kSlotBits - 1) / kSlotBits;
+        static constexpr std::size_t kMaxTimers = 64;
+
+        explicit TimerWheel(std::uint64_t nowMs = 0) noexcept;
+
+        // Deadlines at or before the current time fire on the next Advance that moves the clock. Returns kNone if
+        // the pool is empty.
+        Handle Arm(std::uint64_t deadlineMs, TimerCallback cb, std::uintptr_t ctx = 0) noexcept;
+
+        // Clears `h` in every case; returns true if a pending timer was removed.
+        bool Cancel(Handle& h) noexcept;
+
+        [[nodiscard]] bool IsPending(Handle h) const noexcept;
+
+        // Fires everything due up to `nowMs` in deadline order; returns how many callbacks ran.
+        std::size_t Advance(std::uint64_t nowMs);
+
+        // Removes the earliest timer due by `nowMs` and hands back its callback without running it; false once
+        // nothing is due (the clock then sits at `nowMs`). Advance is a loop over this.
+        bool PopDue(std::uint64_t nowMs, TimerCallback& cb, std::uintptr_t& ctx) noexcept;
+
+        // Moves the clock forward without firing anything; only meaningful while the wheel is empty.
+        void Rebase(std::uint64_t nowMs) noexcept;
+
+        [[nodiscard]] bool Empty() const noexcept { return _pending == 0; }
+        [[nodiscard]] std::size_t Pending() const noexcept { return _pending; }
+        [[nodiscard]] std::uint64_t Now() const noexcept { return _now; }
+
+    private:
+        static constexpr std::uint16_t kNil = 0xFFFF;
+
+        struct Node {
+            std::uint64_t deadline{0};
+            TimerCallback cb{nullptr};
+            std::uintptr_t ctx{0};
+            std::uint16_t prev{kNil};
+            std::uint16_t next{kNil};
+            std::uint16_t gen{0};
+            std::uint8_t level{0};
+            std::uint8_t slot{0};
+            bool active{false};
+        };
+
+        struct Level {
+            std::array<std::uint16_t, kSlots> heads{};
+            std::uint64_t occupied{0};
+        };
+
+        void Place(std::uint16_t idx) noexcept;
+        void Unlink(std::uint16_t idx) noexcept;
+        void Release(std::uint16_t idx) noexcept;
+        [[nodiscard]] std::uint64_t NextEvent() const noexcept;
+        void Cascade(std::size_t level) noexcept;
+
+        std::array<Node, kMaxTimers> _nodes{};
+        std::array<Level, kLevels> _levels{};
+        std::uint16_t _free{kNil};
+        std::size_t _pending{0};
+        std::uint64_t _now{0};
+    };
+
+    // The main thread's wheel, on FrameClock time. Advanced once per full input frame; keeps the Timers armed
+    // bit set while anything is pending so the idle fast path does not skip due timers. After/Cancel/IsPending
+    // may be called from any thread (anim events, equip hooks, event sinks); callbacks always run on the input
+    // thread, from Advance, outside the wheel's lock.
+    namespace Scheduler {
+        TimerWheel::Handle After(std::uint64_t delayMs, TimerCallback cb, std::uintptr_t ctx = 0) noexcept;
+        bool Cancel(TimerWheel::Handle& h) noexcept;
+        [[nodiscard]] bool IsPending(TimerWheel::Handle h) noexcept;
+        void Advance();
+    }
+}
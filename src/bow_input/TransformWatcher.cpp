@@ -0,0 +1,94 @@
+#include "TransformWatcher.h"
+
+#include <algorithm>
+#include <atomic>
+#include <unordered_set>
+
+#include "../PCH.h"
+#include "BowInputHandler.h"
+#include "BowState.h"
+
+namespace BowInput::TransformWatcher {
+    namespace {
+        struct PowerIndex {
+            std::unordered_set<const RE::TESForm*> powers;
+            std::atomic_bool scanned{false};
+        };
+
+        PowerIndex& Index() {
+            static PowerIndex s;  // NOSONAR
+            return s;
+        }
+
+        bool HasTransformArchetype(const RE::MagicItem* item) {
+            if (!item) return false;
+
+            using ArchetypeID = RE::EffectArchetypes::ArchetypeID;
+
+            return std::ranges::any_of(item->effects, [](const auto* effect) {
+                if (!effect || !effect->baseEffect) return false;
+                const auto arch = effect->baseEffect->GetArchetype();
+                return arch == ArchetypeID::kWerewolf || arch == ArchetypeID::kVampireLord;
+            });
+        }
+
+        void BuildIndex() {
+            auto& idx = Index();
+            if (idx.scanned.load(std::memory_order_acquire)) return;
+
+            auto* dh = RE::TESDataHandler::GetSingleton();
+            if (!dh) return;
+
+            for (auto* spell : dh->GetFormArray<RE::SpellItem>()) {
+                if (!spell) continue;
+                if (spell->GetSpellType() != RE::MagicSystem::SpellType::kPower) continue;
+                if (HasTransformArchetype(spell)) idx.powers.insert(spell);
+            }
+
+            idx.scanned.store(true, std::memory_order_release);
+            spdlog::info("[INTEGRATEDBOW][TransformWatcher] {} transformation power(s) indexed", idx.powers.size());
+        }
+
+        class RaceSwitchSink final : public RE::BSTEventSink<RE::TESSwitchRaceCompleteEvent> {
+        public:
+            static RaceSwitchSink* GetSingleton() {
+                static RaceSwitchSink s;  // NOSONAR
+                return &s;
+            }
+
+            RE::BSEventNotifyControl ProcessEvent(const RE::TESSwitchRaceCompleteEvent* ev,
+                                                  RE::BSTEventSource<RE::TESSwitchRaceCompleteEvent>*) override {
+                if (!ev || !ev->subject) return RE::BSEventNotifyControl::kContinue;
+
+                auto* player = RE::PlayerCharacter::GetSingleton();
+                if (ev->subject.get() != player) return RE::BSEventNotifyControl::kContinue;
+
+                if (BowState::IsUsingBow() || BowState::IsEquipingBow()) {
+                    ForceExitBowMode();
+                }
+                return RE::BSEventNotifyControl::kContinue;
+            }
+
+        private:
+            RaceSwitchSink() = default;
+        };
+    }
+
+    void Initialize() {
+        BuildIndex();
+
+        if (auto* holder = RE::ScriptEventSourceHolder::GetSingleton()) {
+            holder->AddEventSink<RE::TESSwitchRaceCompleteEvent>(RaceSwitchSink::GetSingleton());
+        }
+    }
+
+    bool IsCurrentTransformPower(RE::Actor* actor) {
+        if (!actor) return false;
+
+        const auto& idx = Index();
+        if (!idx.scanned.load(std::memory_order_acquire) || idx.powers.empty()) return false;
+
+        const auto* selected = actor->GetActorRuntimeData().selectedPower;
+        return selected && idx.powers.contains(selected);
+    }
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+namespace RE {
+    class Actor;
+}
+
+namespace BowInput::TransformWatcher {
+    // kDataLoaded: indexes the werewolf / vampire lord powers once and starts listening for race switches,
+    // which end bow mode on the player without any scan in the input path.
+    void Initialize();
+
+    [[nodiscard]] bool IsCurrentTransformPower(RE::Actor* actor);
+}
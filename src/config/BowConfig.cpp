@@ -2,9 +2,20 @@
 
 #include <SimpleIni.h>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <stop_token>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "BowConfigPath.h"
+#include "ConfigSnapshot.h"
 #include "../PCH.h"
 
 using namespace std::string_literals;
@@ -23,25 +34,263 @@ namespace {
         return v ? std::string{v} : std::string{defVal};
     }
 
+    std::vector<std::string> _splitList(const std::string& s) {
+        std::vector<std::string> out;
+        std::size_t start = 0;
+        while (start <= s.size()) {
+            const auto end = std::min(s.find(',', start), s.size());
+            auto first = s.find_first_not_of(" \t", start);
+            auto last = s.find_last_not_of(" \t", end == 0 ? 0 : end - 1);
+            if (first != std::string::npos && first < end && last != std::string::npos && last >= first) {
+                out.emplace_back(s.substr(first, last - first + 1));
+            }
+            start = end + 1;
+        }
+        return out;
+    }
+
+    std::string _joinList(const std::vector<std::string>& v) {
+        std::string out;
+        for (const auto& s : v) {
+            if (!out.empty()) out += ',';
+            out += s;
+        }
+        return out;
+    }
+
     bool _getBool(CSimpleIniA& ini, const char* sec, const char* k, bool defVal) {
         const char* v = ini.GetValue(sec, k, nullptr);
         if (!v) return defVal;
         return (std::strcmp(v, "true") == 0 || std::strcmp(v, "1") == 0);
     }
+
+    struct IniSnapshot {
+        IntegratedBow::BowMode mode{IntegratedBow::BowMode::Hold};
+        std::array<int, 3> keyboard{};
+        std::array<int, 3> gamepad{};
+        std::string hotkeyPattern;
+        std::optional<std::string> blockingMenus;  // unset while it matches DefaultBlockingMenus()
+        bool autoDrawEnabled{true};
+        float sheathedDelaySeconds{1.0f};
+        bool noLeftBlockPatch{false};
+        bool hideEquippedFromJsonPatch{false};
+        bool blockUnequip{false};
+        bool noChosenTag{false};
+        bool skipEquipBowAnimationPatch{false};
+        bool skipEquipReturnToMeleePatch{false};
+        bool cancelHoldExitDelayOnAttackPatch{false};
+        bool requireExclusiveHotkeyPatch{false};
+        bool inputTrace{false};
+        int inputTraceRecords{65536};
+    };
+
+    // Re-reads the file so keys and comments this plugin does not own survive, then replaces it through a temp file
+    // so a crash mid-write never leaves a truncated INI behind.
+    bool WriteIni(const std::filesystem::path& path, const IniSnapshot& s) {
+        using enum IntegratedBow::BowMode;
+        CSimpleIniA ini;
+        ini.SetUnicode();
+        ini.LoadFile(path.string().c_str());
+
+        const char* modeStr = nullptr;
+        switch (s.mode) {
+            case Press:
+                modeStr = "Press";
+                break;
+            case Smart:
+                modeStr = "Smart";
+                break;
+            case Hold:
+            default:
+                modeStr = "Hold";
+                break;
+        }
+
+        ini.SetValue("Input", "Mode", modeStr);
+        ini.SetLongValue("Input", "KeyboardScanCode1", static_cast<long>(s.keyboard[0]));
+        ini.SetLongValue("Input", "KeyboardScanCode2", static_cast<long>(s.keyboard[1]));
+        ini.SetLongValue("Input", "KeyboardScanCode3", static_cast<long>(s.keyboard[2]));
+        ini.SetLongValue("Input", "GamepadButton1", static_cast<long>(s.gamepad[0]));
+        ini.SetLongValue("Input", "GamepadButton2", static_cast<long>(s.gamepad[1]));
+        ini.SetLongValue("Input", "GamepadButton3", static_cast<long>(s.gamepad[2]));
+        ini.SetValue("Input", "HotkeyPattern", s.hotkeyPattern.c_str());
+        if (s.blockingMenus) {
+            ini.SetValue("Input", "BlockingMenus", s.blockingMenus->c_str());
+        }
+        ini.SetBoolValue("Input", "AutoDrawEnabled", s.autoDrawEnabled);
+        ini.SetDoubleValue("Input", "SheathedDelaySeconds", static_cast<double>(s.sheathedDelaySeconds));
+        ini.SetBoolValue("Patches", "NoLeftBlockPatch", s.noLeftBlockPatch);
+        ini.SetBoolValue("Patches", "HideEquippedFromJsonPatch", s.hideEquippedFromJsonPatch);
+        ini.SetBoolValue("Patches", "BlockPatch", s.blockUnequip);
+        ini.SetBoolValue("Patches", "NoChosenTag", s.noChosenTag);
+        ini.SetBoolValue("Patches", "SkipEquipBowAnimationPatch", s.skipEquipBowAnimationPatch);
+        ini.SetBoolValue("Patches", "SkipEquipReturnToMeleePatch", s.skipEquipReturnToMeleePatch);
+        ini.SetBoolValue("Patches", "CancelHoldExitDelayOnAttackPatch", s.cancelHoldExitDelayOnAttackPatch);
+        ini.SetBoolValue("Patches", "RequireExclusiveHotkeyPatch", s.requireExclusiveHotkeyPatch);
+        ini.SetBoolValue("Debug", "InputTrace", s.inputTrace);
+        ini.SetLongValue("Debug", "InputTraceRecords", static_cast<long>(s.inputTraceRecords));
+
+        std::error_code ec;
+        std::filesystem::create_directories(path.parent_path(), ec);
+
+        auto tmp = path;
+        tmp += ".tmp";
+        if (ini.SaveFile(tmp.string().c_str()) < 0) {
+            spdlog::warn("[INTEGRATEDBOW][Config] Failed to write {}", tmp.string());
+            return false;
+        }
+
+        std::filesystem::rename(tmp, path, ec);
+        if (ec) {
+            spdlog::warn("[INTEGRATEDBOW][Config] Failed to replace {}: {}", path.string(), ec.message());
+            std::filesystem::remove(tmp, ec);
+            return false;
+        }
+        return true;
+    }
+
+    // Save() runs on gameplay paths (equip hook, arrow selection, menu); it only snapshots and hands off. The worker
+    // waits for a quiet window so bursts collapse into one write, capped so a steady stream still lands on disk.
+    class IniWriter {
+    public:
+        static constexpr auto kDebounce = std::chrono::milliseconds(250);
+        static constexpr auto kMaxDelay = std::chrono::seconds(2);
+
+        static IniWriter& Get() {
+            static IniWriter s;  // NOSONAR
+            return s;
+        }
+
+        void Submit(std::filesystem::path path, IniSnapshot snap) {
+            {
+                std::scoped_lock lk(_mtx);
+                if (!_pending) {
+                    _firstRequest = clock::now();
+                }
+                _pending = Pending{std::move(path), std::move(snap)};
+                _lastRequest = clock::now();
+                ++_requested;
+            }
+            _cv.notify_one();
+        }
+
+        // Writes whatever is queued on the calling thread, without waiting for the debounce window.
+        void Flush() {
+            std::scoped_lock io(_io);
+            std::optional<Pending> job;
+            {
+                std::scoped_lock lk(_mtx);
+                job.swap(_pending);
+            }
+            if (job) {
+                Write(*job);
+            }
+        }
+
+        IntegratedBow::BowConfig::SaveCounters Counters() const {
+            std::scoped_lock lk(_mtx);
+            return {_requested, _written};
+        }
+
+        std::filesystem::file_time_type LastWriteTime() const {
+            std::scoped_lock lk(_mtx);
+            return _lastWriteTime;
+        }
+
+        IniWriter(const IniWriter&) = delete;
+        IniWriter& operator=(const IniWriter&) = delete;
+
+    private:
+        using clock = std::chrono::steady_clock;
+
+        struct Pending {
+            std::filesystem::path path;
+            IniSnapshot snap;
+        };
+
+        IniWriter() : _thread([this](std::stop_token st) { Run(st); }) {}
+
+        // The worker is stopped and joined before the mutex and condition variable it waits on go away (at process
+        // exit it has already been terminated and the join returns at once); the last snapshot is then written here.
+        ~IniWriter() {
+            _thread.request_stop();
+            _cv.notify_all();
+            if (_thread.joinable()) {
+                _thread.join();
+            }
+            Flush();
+        }
+
+        void Run(std::stop_token st) {
+            std::unique_lock lk(_mtx);
+            while (!st.stop_requested()) {
+                _cv.wait(lk, st, [this] { return _pending.has_value(); });
+                if (st.stop_requested()) {
+                    return;
+                }
+
+                const auto due = std::min(_lastRequest + kDebounce, _firstRequest + kMaxDelay);
+                if (clock::now() < due) {
+                    _cv.wait_until(lk, st, due, [] { return false; });
+                    continue;
+                }
+
+                lk.unlock();
+                Flush();
+                lk.lock();
+            }
+        }
+
+        void Write(const Pending& job) {
+            if (WriteIni(job.path, job.snap)) {
+                std::error_code ec;
+                const auto stamp = std::filesystem::last_write_time(job.path, ec);
+
+                std::scoped_lock lk(_mtx);
+                ++_written;
+                if (!ec) _lastWriteTime = stamp;
+            }
+        }
+
+        mutable std::mutex _mtx;
+        std::mutex _io;
+        std::condition_variable_any _cv;
+        std::optional<Pending> _pending;
+        clock::time_point _firstRequest{};
+        clock::time_point _lastRequest{};
+        std::uint64_t _requested{0};
+        std::uint64_t _written{0};
+        std::filesystem::file_time_type _lastWriteTime{};
+        std::jthread _thread;
+    };
 }
 
 namespace IntegratedBow {
+    std::vector<std::string> BowConfig::DefaultBlockingMenus() {
+        return {"InventoryMenu",   "MagicMenu",     "StatsMenu",     "MapMenu",
+                "Journal Menu",    "FavoritesMenu", "ContainerMenu", "BarterMenu",
+                "Training Menu",   "Crafting Menu", "GiftMenu",      "Lockpicking Menu",
+                "Sleep/Wait Menu", "Loading Menu",  "Main Menu",     "Console",
+                "Mod Configuration Menu",           "Dialogue Menu", "Dialogue Topic Menu",
+                "OstimSceneMenu",  "Fader Menu"};
+    }
+
     std::filesystem::path BowConfig::IniPath() {
         const auto& base = GetThisDllDir();
         return base / "IntegratedBow.ini";
     }
 
     void BowConfig::Load() {
+        Read();
+        Publish();
+    }
+
+    bool BowConfig::Read() {
         CSimpleIniA ini;
         ini.SetUnicode();
         const auto path = IniPath();
         if (SI_Error rc = ini.LoadFile(path.string().c_str()); rc < 0) {
-            return;
+            return false;
         }
 
         const auto modeStr = _getStr(ini, "Input", "Mode", "Hold");
@@ -69,6 +318,16 @@ namespace IntegratedBow {
         gamepadButton2.store(gp2, std::memory_order_relaxed);
         gamepadButton3.store(gp3, std::memory_order_relaxed);
 
+        {
+            auto pattern = _getStr(ini, "Input", "HotkeyPattern", "");
+            const char* v = ini.GetValue("Input", "BlockingMenus", nullptr);
+            auto menus = v ? _splitList(v) : DefaultBlockingMenus();
+
+            std::scoped_lock lk(textMtx);
+            hotkeyPattern = std::move(pattern);
+            blockingMenus = std::move(menus);
+        }
+
         {
             bool autoDraw = true;
 
@@ -105,10 +364,11 @@ namespace IntegratedBow {
             sheathedDelaySeconds.store(delay, std::memory_order_relaxed);
         }
 
-        noLeftBlockPatch = _getBool(ini, "Patches", "NoLeftBlockPatch", false);
-        hideEquippedFromJsonPatch = _getBool(ini, "Patches", "HideEquippedFromJsonPatch", false);
-        BlockUnequip = _getBool(ini, "Patches", "BlockPatch", false);
-        noChosenTag = _getBool(ini, "Patches", "NoChosenTag", false);
+        noLeftBlockPatch.store(_getBool(ini, "Patches", "NoLeftBlockPatch", false), std::memory_order_relaxed);
+        hideEquippedFromJsonPatch.store(_getBool(ini, "Patches", "HideEquippedFromJsonPatch", false),
+                                        std::memory_order_relaxed);
+        BlockUnequip.store(_getBool(ini, "Patches", "BlockPatch", false), std::memory_order_relaxed);
+        noChosenTag.store(_getBool(ini, "Patches", "NoChosenTag", false), std::memory_order_relaxed);
         skipEquipBowAnimationPatch.store(_getBool(ini, "Patches", "SkipEquipBowAnimationPatch", false),
                                          std::memory_order_relaxed);
         skipEquipReturnToMeleePatch.store(_getBool(ini, "Patches", "SkipEquipReturnToMeleePatch", false),
@@ -117,64 +377,65 @@ namespace IntegratedBow {
                                                std::memory_order_relaxed);
         requireExclusiveHotkeyPatch.store(_getBool(ini, "Patches", "RequireExclusiveHotkeyPatch", false),
                                           std::memory_order_relaxed);
+
+        inputTrace = _getBool(ini, "Debug", "InputTrace", false);
+        inputTraceRecords = _getInt(ini, "Debug", "InputTraceRecords", 65536);
+        return true;
     }
 
-    void BowConfig::Save() const {
-        using enum BowMode;
-        CSimpleIniA ini;
-        ini.SetUnicode();
-        const auto path = IniPath();
-        ini.LoadFile(path.string().c_str());
+    void BowConfig::Publish() const {
+        ConfigSnapshot snap;
+        snap.mode = mode.load(std::memory_order_relaxed);
+        snap.sheathedDelaySeconds = sheathedDelaySeconds.load(std::memory_order_relaxed);
+        snap.autoDrawEnabled = autoDrawEnabled.load(std::memory_order_relaxed);
+        snap.noLeftBlockPatch = noLeftBlockPatch.load(std::memory_order_relaxed);
+        snap.hideEquippedFromJsonPatch = hideEquippedFromJsonPatch.load(std::memory_order_relaxed);
+        snap.blockUnequip = BlockUnequip.load(std::memory_order_relaxed);
+        snap.noChosenTag = noChosenTag.load(std::memory_order_relaxed);
+        snap.skipEquipBowAnimationPatch = skipEquipBowAnimationPatch.load(std::memory_order_relaxed);
+        snap.skipEquipReturnToMeleePatch = skipEquipReturnToMeleePatch.load(std::memory_order_relaxed);
+        snap.cancelHoldExitDelayOnAttackPatch = cancelHoldExitDelayOnAttackPatch.load(std::memory_order_relaxed);
+        snap.requireExclusiveHotkeyPatch = requireExclusiveHotkeyPatch.load(std::memory_order_relaxed);
+        PublishConfig(snap);
+    }
 
-        const auto m = mode.load(std::memory_order_relaxed);
-        const char* modeStr = nullptr;
-        switch (m) {
-            case Press:
-                modeStr = "Press";
-                break;
-            case Smart:
-                modeStr = "Smart";
-                break;
-            case Hold:
-            default:
-                modeStr = "Hold";
-                break;
+    void BowConfig::Save() const {
+        IniSnapshot snap;
+        snap.mode = mode.load(std::memory_order_relaxed);
+        snap.keyboard = {keyboardScanCode1.load(std::memory_order_relaxed),
+                         keyboardScanCode2.load(std::memory_order_relaxed),
+                         keyboardScanCode3.load(std::memory_order_relaxed)};
+        snap.gamepad = {gamepadButton1.load(std::memory_order_relaxed), gamepadButton2.load(std::memory_order_relaxed),
+                        gamepadButton3.load(std::memory_order_relaxed)};
+        {
+            std::scoped_lock lk(textMtx);
+            snap.hotkeyPattern = hotkeyPattern;
+            if (blockingMenus != DefaultBlockingMenus()) {
+                snap.blockingMenus = _joinList(blockingMenus);
+            }
         }
+        snap.autoDrawEnabled = autoDrawEnabled.load(std::memory_order_relaxed);
+        snap.sheathedDelaySeconds = sheathedDelaySeconds.load(std::memory_order_relaxed);
+        snap.noLeftBlockPatch = noLeftBlockPatch.load(std::memory_order_relaxed);
+        snap.hideEquippedFromJsonPatch = hideEquippedFromJsonPatch.load(std::memory_order_relaxed);
+        snap.blockUnequip = BlockUnequip.load(std::memory_order_relaxed);
+        snap.noChosenTag = noChosenTag.load(std::memory_order_relaxed);
+        snap.skipEquipBowAnimationPatch = skipEquipBowAnimationPatch.load(std::memory_order_relaxed);
+        snap.skipEquipReturnToMeleePatch = skipEquipReturnToMeleePatch.load(std::memory_order_relaxed);
+        snap.cancelHoldExitDelayOnAttackPatch = cancelHoldExitDelayOnAttackPatch.load(std::memory_order_relaxed);
+        snap.requireExclusiveHotkeyPatch = requireExclusiveHotkeyPatch.load(std::memory_order_relaxed);
+        snap.inputTrace = inputTrace;
+        snap.inputTraceRecords = inputTraceRecords;
 
-        ini.SetValue("Input", "Mode", modeStr);
-        const int k1 = keyboardScanCode1.load(std::memory_order_relaxed);
-        const int k2 = keyboardScanCode2.load(std::memory_order_relaxed);
-        const int k3 = keyboardScanCode3.load(std::memory_order_relaxed);
-        ini.SetLongValue("Input", "KeyboardScanCode1", static_cast<long>(k1));
-        ini.SetLongValue("Input", "KeyboardScanCode2", static_cast<long>(k2));
-        ini.SetLongValue("Input", "KeyboardScanCode3", static_cast<long>(k3));
-        const int gp1 = gamepadButton1.load(std::memory_order_relaxed);
-        const int gp2 = gamepadButton2.load(std::memory_order_relaxed);
-        const int gp3 = gamepadButton3.load(std::memory_order_relaxed);
-        ini.SetLongValue("Input", "GamepadButton1", static_cast<long>(gp1));
-        ini.SetLongValue("Input", "GamepadButton2", static_cast<long>(gp2));
-        ini.SetLongValue("Input", "GamepadButton3", static_cast<long>(gp3));
-        ini.SetBoolValue("Input", "AutoDrawEnabled", autoDrawEnabled.load(std::memory_order_relaxed));
-        ini.SetDoubleValue("Input", "SheathedDelaySeconds",
-                           static_cast<double>(sheathedDelaySeconds.load(std::memory_order_relaxed)));
-        ini.SetBoolValue("Patches", "NoLeftBlockPatch", noLeftBlockPatch);
-        ini.SetBoolValue("Patches", "HideEquippedFromJsonPatch", hideEquippedFromJsonPatch);
-        ini.SetBoolValue("Patches", "BlockPatch", BlockUnequip);
-        ini.SetBoolValue("Patches", "NoChosenTag", noChosenTag);
-        ini.SetBoolValue("Patches", "SkipEquipBowAnimationPatch",
-                         skipEquipBowAnimationPatch.load(std::memory_order_relaxed));
-        ini.SetBoolValue("Patches", "SkipEquipReturnToMeleePatch",
-                         skipEquipReturnToMeleePatch.load(std::memory_order_relaxed));
-        ini.SetBoolValue("Patches", "CancelHoldExitDelayOnAttackPatch",
-                         cancelHoldExitDelayOnAttackPatch.load(std::memory_order_relaxed));
-        ini.SetBoolValue("Patches", "RequireExclusiveHotkeyPatch",
-                         requireExclusiveHotkeyPatch.load(std::memory_order_relaxed));
-
-        std::error_code ec;
-        std::filesystem::create_directories(path.parent_path(), ec);
-        ini.SaveFile(path.string().c_str());
+        IniWriter::Get().Submit(IniPath(), std::move(snap));
     }
 
+    void BowConfig::FlushSave() { IniWriter::Get().Flush(); }
+
+    BowConfig::SaveCounters BowConfig::GetSaveCounters() { return IniWriter::Get().Counters(); }
+
+    std::filesystem::file_time_type BowConfig::LastSavedWriteTime() { return IniWriter::Get().LastWriteTime(); }
+
     BowConfig& GetBowConfig() {
         static BowConfig g{};  // NOSONAR: Static state
         return g;
@@ -1,6 +1,10 @@
 #pragma once
 #include <atomic>
+#include <cstdint>
 #include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
 
 namespace IntegratedBow {
     enum class BowMode : std::uint32_t {
@@ -20,24 +24,52 @@ namespace IntegratedBow {
         std::atomic<int> gamepadButton2{-1};
         std::atomic<int> gamepadButton3{-1};
 
+        // Guards hotkeyPattern and blockingMenus: the menu's Save copies them on the render thread while the INI
+        // watcher's Apply may be replacing them on the game thread.
+        mutable std::mutex textMtx;
+
+        // Optional chord/sequence pattern (see HotkeyPattern.h); when set it replaces the keys above.
+        std::string hotkeyPattern;
+
         std::atomic<std::uint32_t> chosenBowFormID{0};
+        std::atomic<std::uint32_t> chosenBowUid{0};  // ExtraUniqueID of the chosen instance, 0 when untracked
         std::atomic<std::uint32_t> preferredArrowFormID{0};
 
         std::atomic<bool> autoDrawEnabled{true};
         std::atomic<float> sheathedDelaySeconds{1.0f};
-        bool noLeftBlockPatch = false;
-        bool hideEquippedFromJsonPatch = false;
-        bool BlockUnequip = false;
-        bool noChosenTag = false;
+        std::atomic_bool noLeftBlockPatch{false};
+        std::atomic_bool hideEquippedFromJsonPatch{false};
+        std::atomic_bool BlockUnequip{false};
+        std::atomic_bool noChosenTag{false};
         std::atomic_bool skipEquipBowAnimationPatch{false};
         std::atomic_bool skipEquipReturnToMeleePatch{false};
         std::atomic_bool cancelHoldExitDelayOnAttackPatch{false};
         std::atomic_bool requireExclusiveHotkeyPatch{false};
 
+        // Menus that block the hotkey while open ([Input] BlockingMenus, comma separated).
+        std::vector<std::string> blockingMenus = DefaultBlockingMenus();
+
+        bool inputTrace = false;
+        int inputTraceRecords = 65536;
+
+        struct SaveCounters {
+            std::uint64_t requested{0};
+            std::uint64_t written{0};
+        };
+
         void Load();
+        // Parses IntegratedBow.ini into this object without publishing; false (fields untouched) if it can't be read.
+        bool Read();
+        // Queues a snapshot for the background INI writer; bursts within its debounce window become one write.
         void Save() const;
+        static void FlushSave();
+        // Makes the current values visible to gameplay readers (see ConfigSnapshot.h).
+        void Publish() const;
+        static SaveCounters GetSaveCounters();
+        // Modification time of the file as left by the last successful Save(), so watchers can skip our own writes.
+        static std::filesystem::file_time_type LastSavedWriteTime();
 
-    private:
+        static std::vector<std::string> DefaultBlockingMenus();
         static std::filesystem::path IniPath();
     };
 
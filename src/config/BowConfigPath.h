@@ -1,15 +1,19 @@
 #pragma once
-#include <windows.h>
-#ifdef GetObject
-    #undef GetObject
+#ifdef _WIN32
+    #include <windows.h>
+    #ifdef GetObject
+        #undef GetObject
+    #endif
 #endif
 
+#include <cstdlib>
 #include <filesystem>
 #include <vector>
 
 namespace IntegratedBow {
     inline const std::filesystem::path& GetThisDllDir() {
         static std::filesystem::path cached = []() {  // NOSONAR
+#ifdef _WIN32
             HMODULE hMod = nullptr;
 
             if (!::GetModuleHandleExW(
@@ -31,6 +35,13 @@ namespace IntegratedBow {
 
             std::filesystem::path full{std::wstring{buf.data(), len}};
             return full.parent_path();
+#else
+            // Headless build (tests/): no DLL to sit next to, so the data files go wherever the harness points.
+            if (const char* dir = std::getenv("INTEGRATEDBOW_DATA_DIR"); dir && *dir) {
+                return std::filesystem::path{dir};
+            }
+            return std::filesystem::current_path();
+#endif
         }();
 
         return cached;
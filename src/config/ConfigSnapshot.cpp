@@ -0,0 +1,152 @@
+#include "ConfigSnapshot.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace IntegratedBow {
+    namespace {
+        const ConfigSnapshot kDefaults{};
+
+        constexpr std::size_t kReaderSlots = 64;
+        constexpr std::uint64_t kIdle = ~std::uint64_t{0};
+
+        // One per reading thread. `epoch` is the global epoch seen when its outermost ConfigRef was entered, or kIdle.
+        struct alignas(64) ReaderSlot {
+            std::atomic<std::uint64_t> epoch{kIdle};
+            std::atomic_bool claimed{false};
+        };
+
+        struct Retired {
+            std::unique_ptr<const ConfigSnapshot> snap;
+            std::uint64_t epoch{0};  // readers that entered at or before it may still hold snap
+        };
+
+        struct Domain {
+            std::atomic<const ConfigSnapshot*> current{&kDefaults};
+            std::atomic<std::uint64_t> epoch{0};
+            std::array<ReaderSlot, kReaderSlots> slots{};
+            // Readers on threads that found no free slot; while any is inside, nothing is freed.
+            std::atomic<std::uint32_t> overflowReaders{0};
+
+            std::mutex mtx;
+            std::unique_ptr<const ConfigSnapshot> live;
+            std::vector<Retired> retired;
+            ConfigReclaimCounters counters{};
+        };
+
+        Domain& GetDomain() {
+            static Domain s;  // NOSONAR
+            return s;
+        }
+
+        struct ThreadReader {
+            ReaderSlot* slot{nullptr};
+            std::uint32_t depth{0};
+            bool overflow{false};
+
+            ~ThreadReader() {
+                if (slot) {
+                    slot->epoch.store(kIdle, std::memory_order_release);
+                    slot->claimed.store(false, std::memory_order_release);
+                }
+            }
+        };
+
+        thread_local ThreadReader t_reader;  // NOSONAR
+
+        ReaderSlot* ClaimSlot(Domain& d) noexcept {
+            for (auto& s : d.slots) {
+                bool expected = false;
+                if (!s.claimed.load(std::memory_order_relaxed) &&
+                    s.claimed.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+                    return &s;
+                }
+            }
+            return nullptr;
+        }
+
+        // The announce (seq_cst store) is ordered before the pointer load, and the publisher's pointer swap before its
+        // epoch bump and slot scan: a reader the scan missed is guaranteed to load the new pointer.
+        void Enter(Domain& d) noexcept {
+            auto& r = t_reader;
+            if (r.depth++ != 0) {
+                return;
+            }
+
+            if (!r.slot) {
+                r.slot = ClaimSlot(d);
+            }
+            if (r.slot) {
+                r.slot->epoch.store(d.epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+            } else {
+                r.overflow = true;
+                d.overflowReaders.fetch_add(1, std::memory_order_seq_cst);
+            }
+        }
+
+        void Leave(Domain& d) noexcept {
+            auto& r = t_reader;
+            if (--r.depth != 0) {
+                return;
+            }
+
+            if (r.overflow) {
+                r.overflow = false;
+                d.overflowReaders.fetch_sub(1, std::memory_order_release);
+            } else {
+                r.slot->epoch.store(kIdle, std::memory_order_release);
+            }
+        }
+
+        // Publisher side, under the mutex.
+        void Reclaim(Domain& d) {
+            if (d.overflowReaders.load(std::memory_order_seq_cst) != 0) {
+                return;
+            }
+
+            std::uint64_t oldest = kIdle;
+            for (auto const& s : d.slots) {
+                oldest = std::min(oldest, s.epoch.load(std::memory_order_seq_cst));
+            }
+
+            const auto before = d.retired.size();
+            std::erase_if(d.retired, [oldest](const Retired& r) { return r.epoch < oldest; });
+            d.counters.freed += before - d.retired.size();
+        }
+    }
+
+    ConfigRef::ConfigRef() noexcept {
+        auto& d = GetDomain();
+        Enter(d);
+        _snap = d.current.load(std::memory_order_seq_cst);
+    }
+
+    ConfigRef::~ConfigRef() { Leave(GetDomain()); }
+
+    void PublishConfig(const ConfigSnapshot& snap) {
+        auto next = std::make_unique<const ConfigSnapshot>(snap);
+
+        auto& d = GetDomain();
+        std::scoped_lock lk(d.mtx);
+        d.current.store(next.get(), std::memory_order_seq_cst);
+        const std::uint64_t retiredAt = d.epoch.fetch_add(1, std::memory_order_seq_cst);
+
+        if (d.live) {
+            d.retired.push_back(Retired{std::move(d.live), retiredAt});
+        }
+        d.live = std::move(next);
+        ++d.counters.published;
+
+        Reclaim(d);
+    }
+
+    ConfigReclaimCounters GetConfigReclaimCounters() {
+        auto& d = GetDomain();
+        std::scoped_lock lk(d.mtx);
+        return d.counters;
+    }
+}
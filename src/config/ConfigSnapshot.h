@@ -0,0 +1,54 @@
+#pragma once
+#include <cstdint>
+
+#include "BowConfig.h"
+
+namespace IntegratedBow {
+    // Immutable copy of the settings gameplay code reads, published as a whole by BowConfig::Publish() (Load and the
+    // menu's Apply). A reader takes one reference and sees every field from the same Apply, never a mix.
+    struct alignas(64) ConfigSnapshot {
+        BowMode mode{BowMode::Hold};
+        float sheathedDelaySeconds{1.0f};
+        bool autoDrawEnabled{true};
+        bool noLeftBlockPatch{false};
+        bool hideEquippedFromJsonPatch{false};
+        bool blockUnequip{false};
+        bool noChosenTag{false};
+        bool skipEquipBowAnimationPatch{false};
+        bool skipEquipReturnToMeleePatch{false};
+        bool cancelHoldExitDelayOnAttackPatch{false};
+        bool requireExclusiveHotkeyPatch{false};
+    };
+
+    // Keeps the snapshot it was handed alive for its own lifetime (epoch-based: the thread announces the epoch it
+    // entered in, and a superseded snapshot is freed once no thread is still inside an older one). Entering costs a
+    // thread-local check and one store; nesting on the same thread is free. Hold it for the length of one callback,
+    // never across frames.
+    class ConfigRef {
+    public:
+        ConfigRef() noexcept;
+        ~ConfigRef();
+
+        ConfigRef(const ConfigRef&) = delete;
+        ConfigRef& operator=(const ConfigRef&) = delete;
+
+        [[nodiscard]] const ConfigSnapshot& operator*() const noexcept { return *_snap; }
+        [[nodiscard]] const ConfigSnapshot* operator->() const noexcept { return _snap; }
+        [[nodiscard]] const ConfigSnapshot* get() const noexcept { return _snap; }
+
+    private:
+        const ConfigSnapshot* _snap;
+    };
+
+    [[nodiscard]] inline ConfigRef CurrentConfig() noexcept { return ConfigRef{}; }
+
+    // Swaps the snapshot in and frees the superseded ones no reader can still hold.
+    void PublishConfig(const ConfigSnapshot& snap);
+
+    struct ConfigReclaimCounters {
+        std::uint64_t published{0};
+        std::uint64_t freed{0};
+    };
+
+    [[nodiscard]] ConfigReclaimCounters GetConfigReclaimCounters();
+}
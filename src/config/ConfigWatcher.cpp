@@ -0,0 +1,258 @@
+#include "ConfigWatcher.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "BowConfig.h"
+#include "ConfigSnapshot.h"
+#include "../PCH.h"
+#include "../bow_input/BowInputHandler.h"
+#include "../bow_input/InputGate.h"
+#include "../patchs/HiddenItemsPatch.h"
+#include "../patchs/UnMapBlock.h"
+
+namespace IntegratedBow::ConfigWatcher {
+    namespace {
+        constexpr auto kPollInterval = std::chrono::seconds(1);
+
+        // Stores the file's value in `dst` only when the file itself changed it (`was` is the previous parse), so a
+        // field the menu edited but did not apply keeps the menu's value unless the file moved it too.
+        template <class T>
+        bool Take(std::atomic<T>& dst, const std::atomic<T>& was, const std::atomic<T>& now) noexcept {
+            const T v = now.load(std::memory_order_relaxed);
+            if (was.load(std::memory_order_relaxed) == v) return false;
+            dst.store(v, std::memory_order_relaxed);
+            return true;
+        }
+
+        template <class T>
+        bool Take(T& dst, const T& was, const T& now) {
+            if (was == now) return false;
+            dst = now;
+            return true;
+        }
+
+        void Note(std::string& changed, const char* name) {
+            if (!changed.empty()) changed += ", ";
+            changed += name;
+        }
+
+        // Game thread. `image` is the file as last parsed (or as our own Save left it), `fresh` the file now. Only
+        // what differs between the two is stored, pushed to its consumer and published; the published snapshot is the
+        // current one with those fields replaced, so menu edits that were never applied stay out of it.
+        void Apply(const BowConfig& image, const BowConfig& fresh) {
+            auto& cfg = GetBowConfig();
+            std::string changed;
+            ConfigSnapshot snap = *CurrentConfig();
+            bool publish = false;
+
+            if (Take(cfg.mode, image.mode, fresh.mode)) {
+                snap.mode = fresh.mode.load(std::memory_order_relaxed);
+                publish = true;
+                BowInput::SetMode(std::to_underlying(snap.mode));
+                Note(changed, "Mode");
+            }
+
+            // A group goes to its consumer whole; its members the file left alone read the same in both parses.
+            bool keys = Take(cfg.keyboardScanCode1, image.keyboardScanCode1, fresh.keyboardScanCode1);
+            keys |= Take(cfg.keyboardScanCode2, image.keyboardScanCode2, fresh.keyboardScanCode2);
+            keys |= Take(cfg.keyboardScanCode3, image.keyboardScanCode3, fresh.keyboardScanCode3);
+            if (keys) {
+                BowInput::SetKeyScanCodes(fresh.keyboardScanCode1.load(std::memory_order_relaxed),
+                                          fresh.keyboardScanCode2.load(std::memory_order_relaxed),
+                                          fresh.keyboardScanCode3.load(std::memory_order_relaxed));
+                Note(changed, "KeyboardScanCode");
+            }
+
+            bool buttons = Take(cfg.gamepadButton1, image.gamepadButton1, fresh.gamepadButton1);
+            buttons |= Take(cfg.gamepadButton2, image.gamepadButton2, fresh.gamepadButton2);
+            buttons |= Take(cfg.gamepadButton3, image.gamepadButton3, fresh.gamepadButton3);
+            if (buttons) {
+                BowInput::SetGamepadButtons(fresh.gamepadButton1.load(std::memory_order_relaxed),
+                                            fresh.gamepadButton2.load(std::memory_order_relaxed),
+                                            fresh.gamepadButton3.load(std::memory_order_relaxed));
+                Note(changed, "GamepadButton");
+            }
+
+            bool pattern = false;
+            bool menus = false;
+            {
+                std::scoped_lock lk(cfg.textMtx);
+                pattern = Take(cfg.hotkeyPattern, image.hotkeyPattern, fresh.hotkeyPattern);
+                menus = Take(cfg.blockingMenus, image.blockingMenus, fresh.blockingMenus);
+            }
+
+            if (pattern) {
+                BowInput::SetHotkeyPattern(fresh.hotkeyPattern);
+                Note(changed, "HotkeyPattern");
+            }
+
+            if (menus) {
+                BowInput::InputGate::SetBlockingMenus(fresh.blockingMenus);
+                Note(changed, "BlockingMenus");
+            }
+
+            if (Take(cfg.noLeftBlockPatch, image.noLeftBlockPatch, fresh.noLeftBlockPatch)) {
+                snap.noLeftBlockPatch = fresh.noLeftBlockPatch.load(std::memory_order_relaxed);
+                publish = true;
+                UnMapBlock::SetNoLeftBlockPatch(snap.noLeftBlockPatch);
+                Note(changed, "NoLeftBlockPatch");
+            }
+
+            if (Take(cfg.hideEquippedFromJsonPatch, image.hideEquippedFromJsonPatch, fresh.hideEquippedFromJsonPatch)) {
+                snap.hideEquippedFromJsonPatch = fresh.hideEquippedFromJsonPatch.load(std::memory_order_relaxed);
+                publish = true;
+                HiddenItemsPatch::SetEnabled(snap.hideEquippedFromJsonPatch);
+                Note(changed, "HideEquippedFromJsonPatch");
+            }
+
+            // Read straight from the snapshot by gameplay code; publishing is all they need.
+            const auto flag = [&](const char* name, auto& live, const auto& was, const auto& now, auto& out) {
+                if (!Take(live, was, now)) return;
+                out = now.load(std::memory_order_relaxed);
+                publish = true;
+                Note(changed, name);
+            };
+            flag("AutoDrawEnabled", cfg.autoDrawEnabled, image.autoDrawEnabled, fresh.autoDrawEnabled,
+                 snap.autoDrawEnabled);
+            flag("SheathedDelaySeconds", cfg.sheathedDelaySeconds, image.sheathedDelaySeconds,
+                 fresh.sheathedDelaySeconds, snap.sheathedDelaySeconds);
+            flag("BlockPatch", cfg.BlockUnequip, image.BlockUnequip, fresh.BlockUnequip, snap.blockUnequip);
+            flag("NoChosenTag", cfg.noChosenTag, image.noChosenTag, fresh.noChosenTag, snap.noChosenTag);
+            flag("SkipEquipBowAnimationPatch", cfg.skipEquipBowAnimationPatch, image.skipEquipBowAnimationPatch,
+                 fresh.skipEquipBowAnimationPatch, snap.skipEquipBowAnimationPatch);
+            flag("SkipEquipReturnToMeleePatch", cfg.skipEquipReturnToMeleePatch, image.skipEquipReturnToMeleePatch,
+                 fresh.skipEquipReturnToMeleePatch, snap.skipEquipReturnToMeleePatch);
+            flag("CancelHoldExitDelayOnAttackPatch", cfg.cancelHoldExitDelayOnAttackPatch,
+                 image.cancelHoldExitDelayOnAttackPatch, fresh.cancelHoldExitDelayOnAttackPatch,
+                 snap.cancelHoldExitDelayOnAttackPatch);
+            flag("RequireExclusiveHotkeyPatch", cfg.requireExclusiveHotkeyPatch, image.requireExclusiveHotkeyPatch,
+                 fresh.requireExclusiveHotkeyPatch, snap.requireExclusiveHotkeyPatch);
+
+            if (publish) {
+                PublishConfig(snap);
+            }
+
+            if (changed.empty()) {
+                spdlog::info("[INTEGRATEDBOW][Config] IntegratedBow.ini changed on disk, nothing to apply");
+            } else {
+                spdlog::info("[INTEGRATEDBOW][Config] Reloaded IntegratedBow.ini: {}", changed);
+            }
+        }
+
+        std::optional<std::filesystem::file_time_type> Stamp(const std::filesystem::path& path) {
+            std::error_code ec;
+            const auto t = std::filesystem::last_write_time(path, ec);
+            if (ec) return std::nullopt;
+            return t;
+        }
+
+        class Watcher {
+        public:
+            static Watcher& Get() {
+                static Watcher s;  // NOSONAR
+                return s;
+            }
+
+            void Start() {
+                std::scoped_lock lk(_mtx);
+                if (_thread.joinable()) return;
+                _thread = std::jthread([this](std::stop_token st) { Run(st); });
+            }
+
+            Watcher(const Watcher&) = delete;
+            Watcher& operator=(const Watcher&) = delete;
+
+        private:
+            Watcher() = default;
+
+            // Joined, not detached: Run() waits on _mtx/_cv, which die with this object.
+            ~Watcher() {
+                if (_thread.joinable()) {
+                    _thread.request_stop();
+                    _cv.notify_all();
+                    _thread.join();
+                }
+            }
+
+            // A new stamp is acted on once it holds for a full poll, so an editor still writing the file is not
+            // parsed half way.
+            void Run(std::stop_token st) {
+                const auto path = BowConfig::IniPath();
+                auto applied = Stamp(path);
+                _image = ReadImage();
+                std::optional<std::filesystem::file_time_type> candidate;
+
+                std::unique_lock lk(_mtx);
+                while (!st.stop_requested()) {
+                    _cv.wait_for(lk, st, kPollInterval, [] { return false; });
+                    if (st.stop_requested()) {
+                        return;
+                    }
+
+                    const auto now = Stamp(path);
+                    if (!now || now == applied) {
+                        candidate.reset();
+                        continue;
+                    }
+                    if (now != candidate) {
+                        candidate = now;
+                        continue;
+                    }
+
+                    applied = now;
+                    candidate.reset();
+                    if (*now == BowConfig::LastSavedWriteTime()) {
+                        // Our own write: nothing to apply, but it is what the next edit gets compared against.
+                        lk.unlock();
+                        if (auto image = ReadImage()) _image = std::move(image);
+                        lk.lock();
+                        continue;
+                    }
+
+                    lk.unlock();
+                    Reload();
+                    lk.lock();
+                }
+            }
+
+            // Parsed off the game thread; null if the file cannot be read.
+            static std::shared_ptr<const BowConfig> ReadImage() {
+                auto cfg = std::make_shared<BowConfig>();
+                if (!cfg->Read()) return nullptr;
+                return cfg;
+            }
+
+            void Reload() {
+                auto fresh = ReadImage();
+                if (!fresh) {
+                    return;
+                }
+
+                // No readable file at startup means the live config is still on its defaults.
+                auto image = _image ? std::move(_image) : std::make_shared<const BowConfig>();
+                _image = fresh;
+                if (auto* tasks = SKSE::GetTaskInterface()) {
+                    tasks->AddTask([image, fresh]() { Apply(*image, *fresh); });
+                }
+            }
+
+            std::mutex _mtx;
+            std::condition_variable_any _cv;
+            std::shared_ptr<const BowConfig> _image;  // the file as last parsed; poll thread only
+            std::jthread _thread;
+        };
+    }
+
+    void Start() { Watcher::Get().Start(); }
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+// Hot reload of IntegratedBow.ini. A background thread stats the file once per poll interval; when the modification
+// time moves (and it wasn't our own Save), it re-parses off-thread and queues the result as an SKSE task. On the game
+// thread the fresh parse is diffed field by field against the previous one (or what our own Save wrote), and only the
+// fields the file changed are stored and pushed to their consumer (key bindings, patches, snapshot); menu edits not
+// applied yet are left alone. [Debug] settings stay startup-only.
+namespace IntegratedBow::ConfigWatcher {
+    // Starts the poll thread; call once the task interface is usable (kDataLoaded). Further calls are ignored.
+    void Start();
+}
@@ -1,21 +1,383 @@
 #include "SaveBowDB.h"
 
+#include <algorithm>
+#include <array>
 #include <cctype>
+#include <cstring>
 #include <fstream>
+#include <iterator>
 #include <nlohmann/json.hpp>
+#include <span>
+#include <vector>
 
 #include "BowConfigPath.h"
 #include "../PCH.h"
 
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
 namespace IntegratedBow {
+    namespace {
+        // Journal layout: "IBSJ", u32 version, then records of RecordHeader + key bytes (the normalized save path).
+        // Little-endian, written as-is.
+        constexpr std::array<char, 4> kMagic{'I', 'B', 'S', 'J'};
+        constexpr std::uint32_t kJournalVersion = 1;
+        constexpr std::size_t kFileHeaderSize = kMagic.size() + sizeof(std::uint32_t);
+
+        // Journal records past the index before compaction folds them in; this also bounds the overlay.
+        constexpr std::size_t kCompactMinRecords = 1024;
+
+        constexpr std::uint8_t kTombstone = 1;
+
+        struct RecordHeader {
+            std::uint32_t checksum;  // FNV-1a over the header (this field zeroed) and the key
+            std::uint32_t bow;
+            std::uint32_t arrow;
+            std::uint32_t bowUid;
+            std::uint16_t keyLen;
+            std::uint8_t flags;
+            std::uint8_t reserved;
+        };
+        static_assert(sizeof(RecordHeader) == 20);
+
+        // Index layout: IndexHeader, then `count` IndexEntry sorted by keyHash. It covers the journal up to
+        // journalBytes; the record ending there is recorded so a journal rewritten behind our back is detected.
+        constexpr std::array<char, 4> kIndexMagic{'I', 'B', 'S', 'X'};
+        constexpr std::uint32_t kIndexVersion = 2;  // 2: keyCheck filled in
+
+        struct IndexHeader {
+            std::array<char, 4> magic;
+            std::uint32_t version;
+            std::uint64_t count;
+            std::uint64_t journalBytes;
+            std::uint64_t lastRecordOffset;  // 0 when the covered journal holds no records
+            std::uint32_t lastRecordChecksum;
+            std::uint32_t reserved;
+        };
+        static_assert(sizeof(IndexHeader) == 40);
+
+        struct IndexEntry {
+            std::uint64_t keyHash;
+            std::uint32_t bow;
+            std::uint32_t arrow;
+            std::uint32_t bowUid;
+            std::uint32_t keyCheck;  // KeyCheck of the key; tells apart two keys whose 64-bit hashes collide
+        };
+        static_assert(sizeof(IndexEntry) == 24);
+
+        std::uint32_t Fnv1a(std::uint32_t h, const void* data, std::size_t n) noexcept {
+            const auto* p = static_cast<const unsigned char*>(data);
+            for (std::size_t i = 0; i < n; ++i) {
+                h = (h ^ p[i]) * 16777619u;
+            }
+            return h;
+        }
+
+        std::uint64_t KeyHash(std::string_view key) noexcept {
+            std::uint64_t h = 14695981039346656037ull;
+            for (const char c : key) {
+                h = (h ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+            }
+            return h;
+        }
+
+        // Independent of KeyHash (32-bit FNV-1a, different basis), so a KeyHash collision is caught here.
+        std::uint32_t KeyCheck(std::string_view key) noexcept {
+            return Fnv1a(2166136261u ^ 0x5A17u, key.data(), key.size());
+        }
+
+        std::uint32_t Checksum(RecordHeader h, std::string_view key) noexcept {
+            h.checksum = 0;
+            return Fnv1a(Fnv1a(2166136261u, &h, sizeof(h)), key.data(), key.size());
+        }
+
+        std::uint32_t ReadU32(const char* p) noexcept {
+            std::uint32_t v = 0;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        std::string FileHeader() {
+            std::string out(kMagic.data(), kMagic.size());
+            out.append(reinterpret_cast<const char*>(&kJournalVersion), sizeof(kJournalVersion));  // NOSONAR
+            return out;
+        }
+
+        bool IsJournalHeader(std::string_view bytes) noexcept {
+            return bytes.size() >= kFileHeaderSize && std::memcmp(bytes.data(), kMagic.data(), kMagic.size()) == 0 &&
+                   ReadU32(bytes.data() + kMagic.size()) == kJournalVersion;
+        }
+
+        bool EncodeRecord(std::string& out, std::string_view key, const SaveBowPrefs& prefs, bool tombstone) {
+            if (key.size() > 0xFFFF) return false;
+
+            RecordHeader h{};
+            h.bow = prefs.bow;
+            h.arrow = prefs.arrow;
+            h.bowUid = prefs.bowUid;
+            h.keyLen = static_cast<std::uint16_t>(key.size());
+            h.flags = tombstone ? kTombstone : 0;
+            h.checksum = Checksum(h, key);
+
+            out.append(reinterpret_cast<const char*>(&h), sizeof(h));  // NOSONAR
+            out.append(key);
+            return true;
+        }
+
+        // Walks well-formed records from the start of `bytes`, stopping at the first short or corrupt one. Returns
+        // how many bytes were consumed.
+        template <class Fn>
+        std::size_t ForEachRecord(std::string_view bytes, Fn&& fn) {
+            std::size_t pos = 0;
+            while (bytes.size() - pos >= sizeof(RecordHeader)) {
+                RecordHeader h{};
+                std::memcpy(&h, bytes.data() + pos, sizeof(h));
+                if (bytes.size() - pos - sizeof(h) < h.keyLen) break;
+
+                const std::string_view key = bytes.substr(pos + sizeof(h), h.keyLen);
+                if (Checksum(h, key) != h.checksum) break;
+
+                fn(key, SaveBowPrefs{h.bow, h.arrow, h.bowUid}, (h.flags & kTombstone) != 0);
+                pos += sizeof(h) + h.keyLen;
+            }
+            return pos;
+        }
+
+        bool ReadFile(const std::filesystem::path& path, std::uint64_t offset, std::uint64_t maxBytes,
+                      std::string& out) {
+            std::ifstream f(path, std::ios::binary);
+            if (!f.is_open()) return false;
+
+            f.seekg(0, std::ios::end);
+            const auto size = static_cast<std::uint64_t>(f.tellg());
+            if (offset > size) return false;
+
+            out.resize(static_cast<std::size_t>(std::min(size - offset, maxBytes)));
+            f.seekg(static_cast<std::streamoff>(offset));
+            f.read(out.data(), static_cast<std::streamsize>(out.size()));
+            return !f.fail();
+        }
+
+        bool WriteFile(const std::filesystem::path& path, std::string_view bytes) {
+            std::ofstream f(path, std::ios::binary | std::ios::trunc);
+            f.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+            f.close();
+            return !f.fail();
+        }
+
+        // SaveBows.json is still written for external tools and older builds, but only from compaction.
+        void ExportJson(const std::vector<std::pair<std::string, SaveBowPrefs>>& entries,
+                        std::filesystem::file_time_type stamp) {
+            nlohmann::json saves = nlohmann::json::object();
+            for (auto const& [k, v] : entries) {
+                saves[k] = nlohmann::json{
+                    {"bow", v.bow},
+                    {"arrow", v.arrow},
+                    {"bowUid", v.bowUid},
+                };
+            }
+
+            nlohmann::json j;
+            j["version"] = 2;
+            j["saves"] = std::move(saves);
+
+            const auto path = SaveBowDB::JsonPath();
+            auto tmp = path;
+            tmp += ".tmp";
+            {
+                std::ofstream f(tmp);
+                if (!f.is_open()) {
+                    return;
+                }
+                f << j.dump(2);
+            }
+
+            // Stamped with the journal's time so that only an outside edit leaves it newer (see ImportNewerJson).
+            std::error_code ec;
+            if (stamp != std::filesystem::file_time_type::min()) {
+                std::filesystem::last_write_time(tmp, stamp, ec);
+            }
+            std::filesystem::rename(tmp, path, ec);
+            if (ec) {
+                spdlog::warn("[INTEGRATEDBOW][SaveBowDB] Failed to replace {}: {}", path.string(), ec.message());
+                std::filesystem::remove(tmp, ec);
+            }
+        }
+
+        // Entries of SaveBows.json, keys normalized. False (already logged) if the file exists but does not parse.
+        bool ReadJson(std::vector<std::pair<std::string, SaveBowPrefs>>& out) {
+            std::ifstream f(SaveBowDB::JsonPath());
+            if (!f.is_open()) {
+                return true;
+            }
+
+            nlohmann::json j;
+            try {
+                f >> j;
+            } catch (const std::exception& e) {
+                spdlog::error("[INTEGRATEDBOW][SaveBowDB] Failed to parse {}: {}", SaveBowDB::JsonPath().string(),
+                              e.what());
+                return false;
+            } catch (...) {
+                spdlog::error("[INTEGRATEDBOW][SaveBowDB] Failed to parse {}: unknown exception",
+                              SaveBowDB::JsonPath().string());
+                return false;
+            }
+
+            auto parseEntry = [&](std::string_view key, const nlohmann::json& val) {
+                SaveBowPrefs prefs{};
+
+                if (val.is_object()) {
+                    if (auto it = val.find("bow"); it != val.end() && it->is_number_unsigned()) {
+                        prefs.bow = it->get<std::uint32_t>();
+                    } else if (auto it2 = val.find("bow"); it2 != val.end() && it2->is_number_integer()) {
+                        prefs.bow = static_cast<std::uint32_t>(it2->get<std::int64_t>());
+                    }
+
+                    if (auto it = val.find("arrow"); it != val.end() && it->is_number_unsigned()) {
+                        prefs.arrow = it->get<std::uint32_t>();
+                    } else if (auto it2 = val.find("arrow"); it2 != val.end() && it2->is_number_integer()) {
+                        prefs.arrow = static_cast<std::uint32_t>(it2->get<std::int64_t>());
+                    }
+
+                    if (auto it = val.find("bowUid"); it != val.end() && it->is_number_unsigned()) {
+                        prefs.bowUid = it->get<std::uint32_t>();
+                    }
+                } else if (val.is_number()) {
+                    prefs.bow = val.get<std::uint32_t>();
+                    prefs.arrow = 0;
+                } else {
+                    return;
+                }
+
+                out.emplace_back(SaveBowDB::NormalizeKey(std::string{key}), prefs);
+            };
+
+            if (auto itSaves = j.find("saves"); itSaves != j.end() && itSaves->is_object()) {
+                for (auto it = itSaves->begin(); it != itSaves->end(); ++it) {
+                    parseEntry(it.key(), it.value());
+                }
+                return true;
+            }
+
+            if (j.is_object()) {
+                for (auto it = j.begin(); it != j.end(); ++it) {
+                    parseEntry(it.key(), it.value());
+                }
+            }
+            return true;
+        }
+    }
+
+    // Read-only view of SaveBows.index. The file stays mapped for the session, so a lookup touches only the pages
+    // its binary search lands on.
+    struct SaveBowDB::MappedIndex {
+#ifdef _WIN32
+        HANDLE file{INVALID_HANDLE_VALUE};
+        HANDLE mapping{nullptr};
+#else
+        int fd{-1};
+        std::size_t mappedBytes{0};
+#endif
+        const void* view{nullptr};
+        const IndexHeader* header{nullptr};
+        std::span<const IndexEntry> entries;
+
+        static std::unique_ptr<MappedIndex> Open(const std::filesystem::path& path) {
+            auto m = std::make_unique<MappedIndex>();
+#ifdef _WIN32
+            m->file = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+            if (m->file == INVALID_HANDLE_VALUE) return nullptr;
+
+            LARGE_INTEGER size{};
+            if (!::GetFileSizeEx(m->file, &size) || static_cast<std::uint64_t>(size.QuadPart) < sizeof(IndexHeader)) {
+                return nullptr;
+            }
+            const auto bytes = static_cast<std::uint64_t>(size.QuadPart);
+
+            m->mapping = ::CreateFileMappingW(m->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!m->mapping) return nullptr;
+
+            m->view = ::MapViewOfFile(m->mapping, FILE_MAP_READ, 0, 0, 0);
+            if (!m->view) return nullptr;
+#else
+            m->fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (m->fd < 0) return nullptr;
+
+            struct stat st{};
+            if (::fstat(m->fd, &st) != 0 || static_cast<std::uint64_t>(st.st_size) < sizeof(IndexHeader)) {
+                return nullptr;
+            }
+            const auto bytes = static_cast<std::uint64_t>(st.st_size);
+
+            void* view = ::mmap(nullptr, static_cast<std::size_t>(bytes), PROT_READ, MAP_SHARED, m->fd, 0);
+            if (view == MAP_FAILED) return nullptr;
+            m->view = view;
+            m->mappedBytes = static_cast<std::size_t>(bytes);
+            ::madvise(view, m->mappedBytes, MADV_RANDOM);
+#endif
+
+            // Mapped views are page aligned and every field sits on its natural boundary.
+            m->header = static_cast<const IndexHeader*>(m->view);
+            const auto& h = *m->header;
+            if (h.magic != kIndexMagic || h.version != kIndexVersion ||
+                (bytes - sizeof(IndexHeader)) % sizeof(IndexEntry) != 0 ||
+                h.count != (bytes - sizeof(IndexHeader)) / sizeof(IndexEntry)) {
+                return nullptr;
+            }
+
+            const auto* first = reinterpret_cast<const IndexEntry*>(m->header + 1);  // NOSONAR
+            m->entries = {first, static_cast<std::size_t>(h.count)};
+            return m;
+        }
+
+        const IndexEntry* Find(std::string_view key) const noexcept {
+            const auto hash = KeyHash(key);
+            const auto check = KeyCheck(key);
+            for (auto it = std::ranges::lower_bound(entries, hash, {}, &IndexEntry::keyHash);
+                 it != entries.end() && it->keyHash == hash; ++it) {
+                if (it->keyCheck == check) return &*it;
+            }
+            return nullptr;
+        }
+
+        ~MappedIndex() {
+#ifdef _WIN32
+            if (view) ::UnmapViewOfFile(view);
+            if (mapping) ::CloseHandle(mapping);
+            if (file != INVALID_HANDLE_VALUE) ::CloseHandle(file);
+#else
+            if (view) ::munmap(const_cast<void*>(view), mappedBytes);  // NOSONAR - munmap não aceita const
+            if (fd >= 0) ::close(fd);
+#endif
+        }
+    };
+
+    SaveBowDB::SaveBowDB() = default;
 
     SaveBowDB& SaveBowDB::Get() {
         static SaveBowDB inst;  // NOSONAR
         return inst;
     }
 
+    // The compactor works on this object's members, so it is joined before they go away.
+    SaveBowDB::~SaveBowDB() {
+        if (_compactor.joinable()) {
+            _compactor.join();
+        }
+    }
+
     std::filesystem::path SaveBowDB::JsonPath() { return GetThisDllDir() / "SaveBows.json"; }
 
+    std::filesystem::path SaveBowDB::JournalPath() { return GetThisDllDir() / "SaveBows.journal"; }
+
+    std::filesystem::path SaveBowDB::IndexPath() { return GetThisDllDir() / "SaveBows.index"; }
+
     std::string SaveBowDB::NormalizeKey(std::string key) {
         for (char& c : key) {
             if (c == '/') c = '\\';
@@ -28,103 +390,340 @@ namespace IntegratedBow {
 
     void SaveBowDB::LoadFromDisk() {
         std::scoped_lock lk(_mtx);
-        _bySave.clear();
+        _pending.clear();
+        _pendingRecords = 0;
+        LoadLocked();
+        if (_loadOK && _journalBytes > 0) {
+            ImportNewerJson();
+        }
+
+        if (_loadOK && !_index && _journalBytes > 0 && !_compacting) {
+            StartCompaction();
+        }
+    }
+
+    void SaveBowDB::LoadLocked() {
+        // The file may have been replaced or removed since it was opened; appends reopen whatever is there now.
+        _journal.close();
+        _journal.clear();
+        _index.reset();
+        _overlay.clear();
         _loadOK = true;
+        _journalBytes = 0;
+        _tailRecords = 0;
 
-        std::ifstream f(JsonPath());
-        if (!f.is_open()) {
+        std::error_code ec;
+        if (!std::filesystem::exists(JournalPath(), ec)) {
+            // Sem journal ainda: importa o JSON e deixa tudo na fila, o primeiro SaveToDisk() cria o journal.
+            std::vector<std::pair<std::string, SaveBowPrefs>> entries;
+            _loadOK = ReadJson(entries);
+            if (_loadOK) {
+                for (auto& [k, v] : entries) {
+                    if (auto [it, inserted] = _overlay.try_emplace(std::move(k), OverlayEntry{v, false}); inserted) {
+                        Append(it->first, v, false);
+                    }
+                }
+            }
             return;
         }
 
-        nlohmann::json j;
-        try {
-            f >> j;
-        } catch (const std::exception& e) {
-            _loadOK = false;
-            spdlog::error("[INTEGRATEDBOW][SaveBowDB] Failed to parse {}: {}", JsonPath().string(), e.what());
-            return;
-        } catch (...) {
-            _loadOK = false;
-            spdlog::error("[INTEGRATEDBOW][SaveBowDB] Failed to parse {}: unknown exception", JsonPath().string());
+        _index = MappedIndex::Open(IndexPath());
+        if (_index && LoadJournalTail()) {
             return;
         }
 
-        auto parseEntry = [&](std::string_view key, const nlohmann::json& val) {
-            SaveBowPrefs prefs{};
+        _index.reset();
+        _overlay.clear();
+        _tailRecords = 0;
+        LoadJournalTail();
+    }
 
-            if (val.is_object()) {
-                if (auto it = val.find("bow"); it != val.end() && it->is_number_unsigned()) {
-                    prefs.bow = it->get<std::uint32_t>();
-                } else if (auto it2 = val.find("bow"); it2 != val.end() && it2->is_number_integer()) {
-                    prefs.bow = static_cast<std::uint32_t>(it2->get<std::int64_t>());
-                }
+    // Replays the journal past what the index covers (all of it without an index) into the overlay. Returns false
+    // if the index does not match the journal it claims to cover.
+    bool SaveBowDB::LoadJournalTail() {
+        std::string head;
+        if (!ReadFile(JournalPath(), 0, kFileHeaderSize, head) || !IsJournalHeader(head)) {
+            _loadOK = false;
+            spdlog::error("[INTEGRATEDBOW][SaveBowDB] {} is not a journal this version can read",
+                          JournalPath().string());
+            return true;
+        }
+
+        std::uint64_t from = kFileHeaderSize;
+        std::string bytes;
+        if (_index) {
+            const auto& h = *_index->header;
+            from = h.lastRecordOffset != 0 ? h.lastRecordOffset : h.journalBytes;
+            if (from < kFileHeaderSize || !ReadFile(JournalPath(), from, ~std::uint64_t{0}, bytes)) {
+                return false;
+            }
 
-                if (auto it = val.find("arrow"); it != val.end() && it->is_number_unsigned()) {
-                    prefs.arrow = it->get<std::uint32_t>();
-                } else if (auto it2 = val.find("arrow"); it2 != val.end() && it2->is_number_integer()) {
-                    prefs.arrow = static_cast<std::uint32_t>(it2->get<std::int64_t>());
+            if (h.lastRecordOffset != 0) {
+                RecordHeader last{};
+                if (bytes.size() < sizeof(last)) return false;
+                std::memcpy(&last, bytes.data(), sizeof(last));
+                if (last.checksum != h.lastRecordChecksum ||
+                    h.lastRecordOffset + sizeof(last) + last.keyLen != h.journalBytes ||
+                    bytes.size() < h.journalBytes - from) {
+                    return false;
                 }
-            } else if (val.is_number()) {
-                prefs.bow = val.get<std::uint32_t>();
-                prefs.arrow = 0;
-            } else {
-                return;
+                bytes.erase(0, static_cast<std::size_t>(h.journalBytes - from));
+                from = h.journalBytes;
             }
+        } else if (!ReadFile(JournalPath(), from, ~std::uint64_t{0}, bytes)) {
+            _loadOK = false;
+            spdlog::error("[INTEGRATEDBOW][SaveBowDB] Failed to read {}", JournalPath().string());
+            return true;
+        }
 
-            _bySave.try_emplace(NormalizeKey(std::string{key}), prefs);
+        const auto toOverlay = [this](std::string_view key, const SaveBowPrefs& prefs, bool tombstone) {
+            _overlay.insert_or_assign(std::string{key}, OverlayEntry{prefs, tombstone});
+            ++_tailRecords;
         };
+        const std::size_t used = ForEachRecord(bytes, toOverlay);
+        _journalBytes = from + used;
 
-        if (auto itSaves = j.find("saves"); itSaves != j.end() && itSaves->is_object()) {
-            for (auto it = itSaves->begin(); it != itSaves->end(); ++it) {
-                parseEntry(it.key(), it.value());
-            }
+        if (used == bytes.size()) {
+            return true;
+        }
+
+        // Torn or corrupt tail (crash mid-append): everything before it is intact, so cut it off and keep going.
+        spdlog::warn("[INTEGRATEDBOW][SaveBowDB] Dropping {} trailing bytes of {}", bytes.size() - used,
+                     JournalPath().string());
+        std::error_code ec;
+        std::filesystem::resize_file(JournalPath(), _journalBytes, ec);
+        if (ec) {
+            _loadOK = false;
+            spdlog::error("[INTEGRATEDBOW][SaveBowDB] Failed to truncate {}: {}", JournalPath().string(),
+                          ec.message());
+        }
+        return true;
+    }
+
+    // SaveBows.json is normally just the export of the last compaction, stamped with the journal's time. If it is
+    // newer than the journal it was edited from outside (a tool, a restored backup): its entries that differ from
+    // what the journal holds are taken as changes and go out with the next save.
+    void SaveBowDB::ImportNewerJson() {
+        std::error_code ec;
+        const auto jsonTime = std::filesystem::last_write_time(JsonPath(), ec);
+        if (ec) return;
+        const auto journalTime = std::filesystem::last_write_time(JournalPath(), ec);
+        if (ec || jsonTime <= journalTime) return;
+
+        std::vector<std::pair<std::string, SaveBowPrefs>> entries;
+        if (!ReadJson(entries)) {
+            spdlog::warn("[INTEGRATEDBOW][SaveBowDB] {} is newer than {} but unreadable, ignoring it",
+                         JsonPath().string(), JournalPath().string());
             return;
         }
 
-        if (j.is_object()) {
-            for (auto it = j.begin(); it != j.end(); ++it) {
-                parseEntry(it.key(), it.value());
-            }
+        std::size_t imported = 0;
+        for (auto& [k, v] : entries) {
+            if (SaveBowPrefs cur{}; FindLocked(k, cur) && cur == v) continue;
+            Append(k, v, false);
+            _overlay.insert_or_assign(std::move(k), OverlayEntry{v, false});
+            ++imported;
         }
+        spdlog::info("[INTEGRATEDBOW][SaveBowDB] {} is newer than {}, imported {} changed saves", JsonPath().string(),
+                     JournalPath().string(), imported);
     }
 
     void SaveBowDB::SaveToDisk() {
-        nlohmann::json j;
-        {
-            std::scoped_lock lk(_mtx);
-            if (!_loadOK) {
-                spdlog::warn(
-                    "[INTEGRATEDBOW][SaveBowDB] Not saving SaveBows.json because last LoadFromDisk() failed. "
-                    "Fix/restore the file to avoid data loss.");
+        std::scoped_lock lk(_mtx);
+        if (!_loadOK) {
+            spdlog::warn(
+                "[INTEGRATEDBOW][SaveBowDB] Not saving SaveBows.journal because last LoadFromDisk() failed. "
+                "Fix/restore the file to avoid data loss.");
+            return;
+        }
+        if (_pending.empty()) {
+            return;
+        }
+
+        if (!_journal.is_open()) {
+            _journal.open(JournalPath(), std::ios::binary | std::ios::app);
+            if (!_journal.is_open()) {
+                spdlog::warn("[INTEGRATEDBOW][SaveBowDB] Failed to open {}", JournalPath().string());
                 return;
             }
+            if (_journalBytes == 0) {
+                const auto header = FileHeader();
+                _journal.write(header.data(), static_cast<std::streamsize>(header.size()));
+                _journalBytes = header.size();
+            }
         }
+
+        _journal.write(_pending.data(), static_cast<std::streamsize>(_pending.size()));
+        _journal.flush();
+        if (!_journal) {
+            // The tail may now hold part of a record. Compaction rebuilds from the intact prefix and carries these
+            // records over, after which appends resume on a clean file.
+            spdlog::warn("[INTEGRATEDBOW][SaveBowDB] Failed to append to {}, rewriting it", JournalPath().string());
+            _journal.close();
+            _journal.clear();
+            if (!_compacting) StartCompaction();
+            _sinceSnapshot += _pending;
+            _sinceSnapshotRecords += _pendingRecords;
+            _pending.clear();
+            _pendingRecords = 0;
+            return;
+        }
+
+        if (_compacting) {
+            _sinceSnapshot += _pending;
+            _sinceSnapshotRecords += _pendingRecords;
+        }
+        _journalBytes += _pending.size();
+        _tailRecords += _pendingRecords;
+        _pending.clear();
+        _pendingRecords = 0;
+
+        if (!_compacting && (!_index || _tailRecords >= kCompactMinRecords)) {
+            StartCompaction();
+        }
+    }
+
+    // Caller holds _mtx. Everything up to the current end of the journal is folded by the background thread, which
+    // re-reads the file itself, so nothing is copied here.
+    void SaveBowDB::StartCompaction() {
+        _compacting = true;
+        _sinceSnapshot.clear();
+        _sinceSnapshotRecords = 0;
+        _compactor = std::jthread([this, coverEnd = _journalBytes]() { Compact(coverEnd); });
+    }
+
+    // Folds the journal prefix into a fresh journal and index, then under the lock adds whatever was appended
+    // meanwhile and swaps both in. Those late records become the new overlay.
+    void SaveBowDB::Compact(std::uint64_t coverEnd) {
+        const auto journalTmp = std::filesystem::path{JournalPath()} += ".tmp";
+        const auto indexTmp = std::filesystem::path{IndexPath()} += ".tmp";
+
+        bool ok = true;
+        std::uint64_t compactedBytes = 0;
         {
-            std::scoped_lock lk(_mtx);
+            std::string old;
+            if (coverEnd > 0) {
+                ok = ReadFile(JournalPath(), 0, coverEnd, old) && old.size() == coverEnd && IsJournalHeader(old);
+            }
 
-            nlohmann::json saves = nlohmann::json::object();
-            for (auto const& [k, v] : _bySave) {
-                saves[k] = nlohmann::json{
-                    {"bow", v.bow},
-                    {"arrow", v.arrow},
-                };
+            std::unordered_map<std::string, SaveBowPrefs, TransparentSaveKeyHash, std::equal_to<>> live;
+            if (ok && !old.empty()) {
+                ForEachRecord(std::string_view{old}.substr(kFileHeaderSize),
+                              [&live](std::string_view key, const SaveBowPrefs& prefs, bool tombstone) {
+                                  if (tombstone) {
+                                      if (auto it = live.find(key); it != live.end()) live.erase(it);
+                                  } else {
+                                      live.insert_or_assign(std::string{key}, prefs);
+                                  }
+                              });
             }
+            old = {};
 
-            j["version"] = 2;
-            j["saves"] = std::move(saves);
+            std::vector<std::pair<std::string, SaveBowPrefs>> entries(std::make_move_iterator(live.begin()),
+                                                                       std::make_move_iterator(live.end()));
+            live = {};
+
+            std::string journal = FileHeader();
+            IndexHeader header{kIndexMagic, kIndexVersion, 0, 0, 0, 0, 0};
+            std::vector<IndexEntry> index;
+            index.reserve(entries.size());
+            for (auto const& [k, v] : entries) {
+                const auto at = journal.size();
+                if (!EncodeRecord(journal, k, v, false)) continue;
+
+                header.lastRecordOffset = at;
+                header.lastRecordChecksum = ReadU32(journal.data() + at);
+                index.push_back({KeyHash(k), v.bow, v.arrow, v.bowUid, KeyCheck(k)});
+            }
+            std::ranges::sort(index, {}, &IndexEntry::keyHash);
+            header.count = index.size();
+            header.journalBytes = journal.size();
+            compactedBytes = journal.size();
+
+            std::string indexBytes(reinterpret_cast<const char*>(&header), sizeof(header));  // NOSONAR
+            indexBytes.append(reinterpret_cast<const char*>(index.data()),                  // NOSONAR
+                              index.size() * sizeof(IndexEntry));
+
+            ok = ok && WriteFile(journalTmp, journal) && WriteFile(indexTmp, indexBytes);
+            if (ok) {
+                std::error_code ec;
+                ExportJson(entries, std::filesystem::last_write_time(journalTmp, ec));
+            }
         }
 
-        std::ofstream f(JsonPath());
-        if (!f.is_open()) {
-            return;
+        std::scoped_lock lk(_mtx);
+        const auto toOverlay = [this](std::string_view key, const SaveBowPrefs& prefs, bool tombstone) {
+            _overlay.insert_or_assign(std::string{key}, OverlayEntry{prefs, tombstone});
+        };
+
+        if (ok && !_sinceSnapshot.empty()) {
+            std::ofstream f(journalTmp, std::ios::binary | std::ios::app);
+            f.write(_sinceSnapshot.data(), static_cast<std::streamsize>(_sinceSnapshot.size()));
+            f.close();
+            ok = !f.fail();
+        }
+
+        std::error_code ec;
+        if (ok) {
+            // Windows refuses to replace a mapped file, so the index is dropped first.
+            _journal.close();
+            _journal.clear();
+            _index.reset();
+            std::filesystem::rename(journalTmp, JournalPath(), ec);
+            if (!ec) std::filesystem::rename(indexTmp, IndexPath(), ec);
+            ok = !ec;
+        }
+
+        if (ok) {
+            _index = MappedIndex::Open(IndexPath());
+            _overlay.clear();
+            ForEachRecord(_sinceSnapshot, toOverlay);
+            _journalBytes = compactedBytes + _sinceSnapshot.size();
+            _tailRecords = _sinceSnapshotRecords;
+            spdlog::info("[INTEGRATEDBOW][SaveBowDB] Compacted {} ({} saves)", JournalPath().string(),
+                         _index ? _index->entries.size() : 0);
+        } else {
+            spdlog::warn("[INTEGRATEDBOW][SaveBowDB] Failed to compact {}", JournalPath().string());
+            std::filesystem::remove(journalTmp, ec);
+            std::filesystem::remove(indexTmp, ec);
+        }
+
+        // Anything short of both files in place leaves the overlay out of step with disk; start over from the files.
+        if (!_index) {
+            LoadLocked();
         }
-        f << j.dump(2);
+        // Changes not saved yet are in neither file.
+        ForEachRecord(_pending, toOverlay);
+
+        _sinceSnapshot.clear();
+        _sinceSnapshotRecords = 0;
+        _compacting = false;
+    }
+
+    bool SaveBowDB::FindLocked(std::string_view normalizedKey, SaveBowPrefs& outPrefs) const {
+        if (auto it = _overlay.find(normalizedKey); it != _overlay.end()) {
+            if (it->second.erased) return false;
+            outPrefs = it->second.prefs;
+            return true;
+        }
+
+        if (!_index) return false;
+
+        const auto* e = _index->Find(normalizedKey);
+        if (!e) return false;
+
+        outPrefs = SaveBowPrefs{e->bow, e->arrow, e->bowUid};
+        return true;
     }
 
     void SaveBowDB::Upsert(std::string_view saveKey, const SaveBowPrefs& prefs) {
         const std::string norm = NormalizeKeyCopy(saveKey);
         std::scoped_lock lk(_mtx);
-        _bySave[norm] = prefs;
+        if (SaveBowPrefs cur{}; FindLocked(norm, cur) && cur == prefs) {
+            return;
+        }
+        _overlay.insert_or_assign(norm, OverlayEntry{prefs, false});
+        Append(norm, prefs, false);
     }
 
     bool SaveBowDB::TryGet(std::string_view saveKey, SaveBowPrefs& outPrefs) const {
@@ -134,14 +733,7 @@ namespace IntegratedBow {
 
     bool SaveBowDB::TryGetNormalized(std::string_view normalizedKey, SaveBowPrefs& outPrefs) const {
         std::scoped_lock lk(_mtx);
-
-        auto it = _bySave.find(normalizedKey);
-        if (it == _bySave.end()) {
-            return false;
-        }
-
-        outPrefs = it->second;
-        return true;
+        return FindLocked(normalizedKey, outPrefs);
     }
 
     void SaveBowDB::Erase(std::string_view saveKey) {
@@ -151,11 +743,32 @@ namespace IntegratedBow {
 
     void SaveBowDB::EraseNormalized(std::string_view normalizedKey) {
         std::scoped_lock lk(_mtx);
-        _bySave.erase(normalizedKey);
+        if (SaveBowPrefs cur{}; !FindLocked(normalizedKey, cur)) {
+            return;
+        }
+        _overlay.insert_or_assign(std::string{normalizedKey}, OverlayEntry{SaveBowPrefs{}, true});
+        Append(normalizedKey, SaveBowPrefs{}, true);
+    }
+
+    void SaveBowDB::Append(std::string_view normalizedKey, const SaveBowPrefs& prefs, bool tombstone) {
+        if (EncodeRecord(_pending, normalizedKey, prefs, tombstone)) {
+            ++_pendingRecords;
+        }
+    }
+
+    void SaveBowDB::WaitForCompaction() {
+        std::jthread compactor;
+        {
+            std::scoped_lock lk(_mtx);
+            compactor = std::move(_compactor);
+        }
+        if (compactor.joinable()) {
+            compactor.join();
+        }
     }
 
     bool SaveBowDB::IsLoadOK() const {
         std::scoped_lock lk(_mtx);
         return _loadOK;
     }
-}
\ No newline at end of file
+}
@@ -1,11 +1,15 @@
 #pragma once
 #include <cstdint>
 #include <filesystem>
+#include <fstream>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <unordered_map>
+#include <utility>
 
 namespace IntegratedBow {
 
@@ -19,8 +23,20 @@ namespace IntegratedBow {
     struct SaveBowPrefs {
         std::uint32_t bow{0};
         std::uint32_t arrow{0};
+        std::uint32_t bowUid{0};
+
+        bool operator==(const SaveBowPrefs&) const = default;
     };
 
+    // Per-save bow/arrow choices. On disk this is an append-only journal (SaveBows.journal): every Upsert/Erase
+    // queues one record and SaveToDisk() appends just those, so a save costs the same with ten tracked saves or ten
+    // thousand. Compaction runs on a background thread and writes the live set three ways: a fresh journal, a
+    // hash-sorted table (SaveBows.index) and the SaveBows.json export. A SaveBows.json without a journal next to it,
+    // or one edited after the journal was last written, is imported on load.
+    //
+    // Lookups never parse the journal up front: the index is mapped and binary-searched in place, and only the
+    // journal records written after it (this session's changes included) live in memory, as an overlay keyed by
+    // path. A missing or stale index means a full replay into the overlay plus an immediate compaction.
     class SaveBowDB {
     public:
         static SaveBowDB& Get();
@@ -30,6 +46,9 @@ namespace IntegratedBow {
 
         bool IsLoadOK() const;
 
+        // Blocks until a running compaction has swapped its files in. The game never needs to; benchmarks do.
+        void WaitForCompaction();
+
         void Upsert(std::string_view saveKey, const SaveBowPrefs& prefs);
         bool TryGet(std::string_view saveKey, SaveBowPrefs& outPrefs) const;
         void Erase(std::string_view saveKey);
@@ -39,15 +58,44 @@ namespace IntegratedBow {
 
         static std::string NormalizeKeyCopy(std::string_view key);
         static std::filesystem::path JsonPath();
+        static std::filesystem::path JournalPath();
+        static std::filesystem::path IndexPath();
         static std::string NormalizeKey(std::string key);
 
     private:
-        SaveBowDB() = default;
+        struct MappedIndex;
+
+        struct OverlayEntry {
+            SaveBowPrefs prefs;
+            bool erased{false};
+        };
+
+        SaveBowDB();
+        ~SaveBowDB();
+
+        void LoadLocked();
+        bool LoadJournalTail();
+        void ImportNewerJson();
+        bool FindLocked(std::string_view normalizedKey, SaveBowPrefs& outPrefs) const;
+        void Append(std::string_view normalizedKey, const SaveBowPrefs& prefs, bool tombstone);
+        void StartCompaction();
+        void Compact(std::uint64_t coverEnd);
 
         bool _loadOK{true};
 
         mutable std::mutex _mtx;
-        std::unordered_map<std::string, SaveBowPrefs, TransparentSaveKeyHash, std::equal_to<>> _bySave;
+        std::unique_ptr<MappedIndex> _index;  // null when missing or stale
+        std::unordered_map<std::string, OverlayEntry, TransparentSaveKeyHash, std::equal_to<>> _overlay;
+
+        std::string _pending;  // encoded records not yet on disk
+        std::size_t _pendingRecords{0};
+        std::ofstream _journal;          // opened on first append, closed around compaction
+        std::uint64_t _journalBytes{0};  // file size, header included
+        std::size_t _tailRecords{0};     // journal records past the index
+        std::string _sinceSnapshot;      // records appended while a compaction is running
+        std::size_t _sinceSnapshotRecords{0};
+        bool _compacting{false};
+        std::jthread _compactor;
     };
 
 }
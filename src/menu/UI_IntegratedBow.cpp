@@ -3,7 +3,9 @@
 #include <array>
 
 #include "../config/BowConfig.h"
+#include "../bow_input/AnimTags.h"
 #include "../bow_input/BowInputHandler.h"
+#include "../bow_input/StageProfiler.h"
 #include "BowStrings.h"
 #include "../PCH.h"
 #include "SKSEMenuFramework.h"
@@ -188,6 +190,7 @@ namespace {
         }
 
         cfg.Save();
+        cfg.Publish();
 
         BowInput::SetMode(std::to_underlying(cfg.mode.load(std::memory_order_relaxed)));
 
@@ -199,8 +202,8 @@ namespace {
                                     cfg.gamepadButton2.load(std::memory_order_relaxed),
                                     cfg.gamepadButton3.load(std::memory_order_relaxed));
 
-        UnMapBlock::SetNoLeftBlockPatch(cfg.noLeftBlockPatch);
-        HiddenItemsPatch::SetEnabled(cfg.hideEquippedFromJsonPatch);
+        UnMapBlock::SetNoLeftBlockPatch(cfg.noLeftBlockPatch.load(std::memory_order_relaxed));
+        HiddenItemsPatch::SetEnabled(cfg.hideEquippedFromJsonPatch.load(std::memory_order_relaxed));
 
         g_pending = false;
 
@@ -246,10 +249,10 @@ namespace {
     }
 
     void DrawPatchesSection(IntegratedBow::BowConfig& cfg, bool& dirty) {
-        bool noLeftBlock = cfg.noLeftBlockPatch;
-        bool hideFromJson = cfg.hideEquippedFromJsonPatch;
-        bool blockUnequip = cfg.BlockUnequip;
-        bool noChosenTag = cfg.noChosenTag;
+        bool noLeftBlock = cfg.noLeftBlockPatch.load(std::memory_order_relaxed);
+        bool hideFromJson = cfg.hideEquippedFromJsonPatch.load(std::memory_order_relaxed);
+        bool blockUnequip = cfg.BlockUnequip.load(std::memory_order_relaxed);
+        bool noChosenTag = cfg.noChosenTag.load(std::memory_order_relaxed);
         bool skipEquipBowAnim = cfg.skipEquipBowAnimationPatch.load(std::memory_order_relaxed);
         bool skipReturn = cfg.skipEquipReturnToMeleePatch.load(std::memory_order_relaxed);
         bool cancelExitDelayOnAttack = cfg.cancelHoldExitDelayOnAttackPatch.load(std::memory_order_relaxed);
@@ -262,7 +265,7 @@ namespace {
             "Use this if another mod provides a separate block key and you want to use LT only as the bow hotkey.");
 
         if (ImGui::Checkbox(lbl.c_str(), &noLeftBlock)) {
-            cfg.noLeftBlockPatch = noLeftBlock;
+            cfg.noLeftBlockPatch.store(noLeftBlock, std::memory_order_relaxed);
             dirty = true;
         }
 
@@ -279,7 +282,7 @@ namespace {
                                         "will be unequipped while the bow is active and re-equipped on exit.");
 
         if (ImGui::Checkbox(lblJson.c_str(), &hideFromJson)) {
-            cfg.hideEquippedFromJsonPatch = hideFromJson;
+            cfg.hideEquippedFromJsonPatch.store(hideFromJson, std::memory_order_relaxed);
             dirty = true;
         }
 
@@ -296,7 +299,7 @@ namespace {
             "entering bow mode. This can mitigate external interference that forces the bow to be unequipped.");
 
         if (ImGui::Checkbox(lblBlockUnequip.c_str(), &blockUnequip)) {
-            cfg.BlockUnequip = blockUnequip;
+            cfg.BlockUnequip.store(blockUnequip, std::memory_order_relaxed);
             dirty = true;
         }
 
@@ -313,7 +316,7 @@ namespace {
             "Use this if you don't want the marker/rename or if another mod expects the original instance metadata.");
 
         if (ImGui::Checkbox(lblNoChosenTag.c_str(), &noChosenTag)) {
-            cfg.noChosenTag = noChosenTag;
+            cfg.noChosenTag.store(noChosenTag, std::memory_order_relaxed);
             dirty = true;
         }
 
@@ -443,6 +446,81 @@ void __stdcall IntegratedBow_UI::DrawPatchesTab() {
     DrawPendingAndApplySection(cfg);
 }
 
+#if defined(INTEGRATEDBOW_STAGE_PROFILER)
+void __stdcall IntegratedBow_UI::DrawDiagnosticsTab() {
+    using BowInput::Profiler::Stage;
+
+    const auto& title = IntegratedBow::Strings::Get("MenuTitle_Diagnostics", "Integrated Bow - Diagnostics");
+    ImGui::TextUnformatted(title.c_str());
+    ImGui::Separator();
+
+    const auto& frames = BowInput::GetFrameCounters();
+    ImGui::Text("%s: %llu / %llu", IntegratedBow::Strings::Get("Item_DiagFrames", "Frames (fast / full)").c_str(),
+                static_cast<unsigned long long>(frames.fastPath.load(std::memory_order_relaxed)),
+                static_cast<unsigned long long>(frames.fullPath.load(std::memory_order_relaxed)));
+
+    const auto saves = IntegratedBow::BowConfig::GetSaveCounters();
+    ImGui::Text("%s: %llu / %llu",
+                IntegratedBow::Strings::Get("Item_DiagIniWrites", "INI saves (requested / written)").c_str(),
+                static_cast<unsigned long long>(saves.requested), static_cast<unsigned long long>(saves.written));
+
+    constexpr int kTableFlags = ImGuiMCP::ImGuiTableFlags_Borders | ImGuiMCP::ImGuiTableFlags_RowBg;
+    if (ImGui::BeginTable("IntegratedBowStages", 5, kTableFlags)) {
+        ImGui::TableSetupColumn(IntegratedBow::Strings::Get("Item_DiagStage", "Stage").c_str());
+        ImGui::TableSetupColumn(IntegratedBow::Strings::Get("Item_DiagSamples", "Samples").c_str());
+        ImGui::TableSetupColumn("p50 (us)");
+        ImGui::TableSetupColumn("p99 (us)");
+        ImGui::TableSetupColumn("max (us)");
+        ImGui::TableHeadersRow();
+
+        for (std::size_t i = 0; i < static_cast<std::size_t>(Stage::Count); ++i) {
+            const auto stage = static_cast<Stage>(i);
+            const auto sum = BowInput::Profiler::Summarize(stage);
+
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(BowInput::Profiler::Name(stage));
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(sum.count));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", static_cast<double>(sum.p50Ns) / 1000.0);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", static_cast<double>(sum.p99Ns) / 1000.0);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", static_cast<double>(sum.maxNs) / 1000.0);
+        }
+        ImGui::EndTable();
+    }
+
+    // Graph events bow mode reacts to, as counted for the player; every other tag is dropped before it is counted.
+    if (ImGui::BeginTable("IntegratedBowAnimTags", 2, kTableFlags)) {
+        ImGui::TableSetupColumn(IntegratedBow::Strings::Get("Item_DiagAnimTag", "Animation event").c_str());
+        ImGui::TableSetupColumn(IntegratedBow::Strings::Get("Item_DiagHits", "Hits").c_str());
+        ImGui::TableHeadersRow();
+
+        const auto& hits = BowInput::AnimTags::Hits();
+        for (std::size_t i = 1; i < static_cast<std::size_t>(BowInput::AnimTag::Count); ++i) {
+            const auto name = BowInput::AnimTags::Name(static_cast<BowInput::AnimTag>(i));
+
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::Text("%.*s", static_cast<int>(name.size()), name.data());
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(hits[i].load(std::memory_order_relaxed)));
+        }
+        ImGui::EndTable();
+    }
+
+    if (ImGui::Button(IntegratedBow::Strings::Get("Item_DiagReset", "Reset").c_str())) {
+        BowInput::Profiler::Reset();
+    }
+    ImGui::SameLine();
+    ImGui::TextDisabled("%s", IntegratedBow::Strings::Get("Item_DiagTip",
+                                                          "Percentiles are rounded up to a power-of-two bucket.")
+                                  .c_str());
+}
+#endif
+
 void IntegratedBow_UI::Register() {
     if (!SKSEMenuFramework::IsInstalled()) return;
 
@@ -456,4 +534,9 @@ void IntegratedBow_UI::Register() {
 
     SKSEMenuFramework::AddSectionItem(IntegratedBow::Strings::Get("SectionItem_Patches", "Patches"),
                                       IntegratedBow_UI::DrawPatchesTab);
+
+#if defined(INTEGRATEDBOW_STAGE_PROFILER)
+    SKSEMenuFramework::AddSectionItem(IntegratedBow::Strings::Get("SectionItem_Diagnostics", "Diagnostics"),
+                                      IntegratedBow_UI::DrawDiagnosticsTab);
+#endif
 }
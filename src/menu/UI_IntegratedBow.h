@@ -4,5 +4,8 @@ namespace IntegratedBow_UI {
     void __stdcall DrawInputTab();
     void __stdcall DrawBowTab();
     void __stdcall DrawPatchesTab();
+#if defined(INTEGRATEDBOW_STAGE_PROFILER)
+    void __stdcall DrawDiagnosticsTab();
+#endif
     void Register();
 }
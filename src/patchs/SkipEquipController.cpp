@@ -1,15 +1,14 @@
 #include "SkipEquipController.h"
 
-#include <chrono>
 #include <cstdint>
 
 #include "RE/B/BSFixedString.h"
 #include "RE/P/PlayerCharacter.h"
+#include "../bow_input/TimerWheel.h"
 
 namespace {
     struct State {
-        std::uint64_t disableAtMs{0};
-        std::uint64_t token{0};
+        BowInput::TimerWheel::Handle disableTimer{BowInput::TimerWheel::kNone};
     };
 
     State& GetState() {
@@ -17,13 +16,6 @@ namespace {
         return s;
     }
 
-    std::atomic<std::uint64_t> g_skipToken{0};  // NOSONAR
-
-    std::uint64_t NowMs() {
-        using namespace std::chrono;
-        return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
-    }
-
     constexpr const char* kVarSkipEquip = "SkipEquipAnimation";
     constexpr const char* kVarLoadDelay = "LoadBoundObjectDelay";
     constexpr const char* kVarSkip3D = "Skip3DLoading";
@@ -42,54 +34,31 @@ namespace {
         }
     }
 
+    void OnDisableDue(std::uintptr_t) {
+        GetState().disableTimer = BowInput::TimerWheel::kNone;
+        SetSkipVars(RE::PlayerCharacter::GetSingleton(), false, 0, false);
+    }
 }
 
 namespace IntegratedBow::SkipEquipController {
     void Enable(RE::PlayerCharacter* pc, int loadDelayMs, bool skip3D) { SetSkipVars(pc, true, loadDelayMs, skip3D); }
     void Disable(RE::PlayerCharacter* pc) { SetSkipVars(pc, false, 0, false); }
     void EnableAndArmDisable(RE::PlayerCharacter* pc, int loadDelayMs, bool skip3D, std::uint64_t delayMs) {
-        const auto token = g_skipToken.fetch_add(1, std::memory_order_relaxed) + 1;
         auto& st = GetState();
-        st.token = token;
-        st.disableAtMs = NowMs() + delayMs;
+        BowInput::Scheduler::Cancel(st.disableTimer);
+        st.disableTimer = BowInput::Scheduler::After(delayMs, &OnDisableDue);
 
         Enable(pc, loadDelayMs, skip3D);
     }
 
     void ArmDisable(std::uint64_t delayMs) {
         auto& st = GetState();
-        if (st.token == 0) {
+        if (!BowInput::Scheduler::IsPending(st.disableTimer)) {
             return;
         }
-        st.disableAtMs = NowMs() + delayMs;
-    }
-
-    void Cancel() {
-        auto& st = GetState();
-        st.disableAtMs = 0;
-        st.token = 0;
-        g_skipToken.fetch_add(1, std::memory_order_relaxed);
+        BowInput::Scheduler::Cancel(st.disableTimer);
+        st.disableTimer = BowInput::Scheduler::After(delayMs, &OnDisableDue);
     }
 
-    void Tick() {
-        auto& st = GetState();
-        if (st.disableAtMs == 0) {
-            return;
-        }
-
-        if (const auto now = NowMs(); now < st.disableAtMs) {
-            return;
-        }
-
-        const auto token = st.token;
-        st.disableAtMs = 0;
-        st.token = 0;
-
-        if (g_skipToken.load(std::memory_order_relaxed) != token) {
-            return;
-        }
-
-        auto* pc = RE::PlayerCharacter::GetSingleton();
-        Disable(pc);
-    }
+    void Cancel() { BowInput::Scheduler::Cancel(GetState().disableTimer); }
 }
@@ -1,5 +1,4 @@
 #pragma once
-#include <atomic>
 #include <cstdint>
 
 namespace RE {
@@ -15,6 +14,4 @@ namespace IntegratedBow::SkipEquipController {
     void ArmDisable(std::uint64_t delayMs);
 
     void Cancel();
-
-    void Tick();
 }
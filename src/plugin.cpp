@@ -8,9 +8,15 @@
 
 #include "BowState.h"
 #include "Hooks.h"
+#include "InventoryIndex.h"
 #include "PCH.h"
 #include "bow_input/BowInputHandler.h"
+#include "bow_input/InputGate.h"
+#include "bow_input/InputTrace.h"
+#include "bow_input/TransformWatcher.h"
 #include "config/BowConfig.h"
+#include "config/ConfigSnapshot.h"
+#include "config/ConfigWatcher.h"
 #include "config/SaveBowDB.h"
 #include "menu/BowStrings.h"
 #include "menu/UI_IntegratedBow.h"
@@ -37,6 +43,7 @@ namespace {
         auto& cfg = IntegratedBow::GetBowConfig();
         cfg.chosenBowFormID.store(p.bow, std::memory_order_relaxed);
         cfg.preferredArrowFormID.store(p.arrow, std::memory_order_relaxed);
+        cfg.chosenBowUid.store(p.bowUid, std::memory_order_relaxed);
     }
 
     IntegratedBow::SaveBowPrefs ReadPrefsFromConfig() {
@@ -44,6 +51,7 @@ namespace {
         IntegratedBow::SaveBowPrefs p{};
         p.bow = cfg.chosenBowFormID.load(std::memory_order_relaxed);
         p.arrow = cfg.preferredArrowFormID.load(std::memory_order_relaxed);
+        p.bowUid = cfg.chosenBowUid.load(std::memory_order_relaxed);
         return p;
     }
 
@@ -99,28 +107,33 @@ namespace {
 
             case SKSE::MessagingInterface::kDataLoaded: {
                 Hooks::Install_Hooks();
+                BowInput::TransformWatcher::Initialize();
                 IntegratedBow_UI::Register();
                 HiddenItemsPatch::LoadConfigFile();
+                BowState::Inventory::Register();
+                IntegratedBow::ConfigWatcher::Start();
                 break;
             }
 
             case SKSE::MessagingInterface::kNewGame: {
+                BowState::Inventory::Invalidate();
                 g_pendingEssPath.clear();
                 g_currentEssPath.clear();
 
                 ApplyPrefsToConfig(IntegratedBow::SaveBowPrefs{});
 
-                auto const& cfg = IntegratedBow::GetBowConfig();
-                UnMapBlock::SetNoLeftBlockPatch(cfg.noLeftBlockPatch);
-                HiddenItemsPatch::SetEnabled(cfg.hideEquippedFromJsonPatch);
+                const auto cfg = IntegratedBow::CurrentConfig();
+                UnMapBlock::SetNoLeftBlockPatch(cfg->noLeftBlockPatch);
+                HiddenItemsPatch::SetEnabled(cfg->hideEquippedFromJsonPatch);
                 break;
             }
 
             case SKSE::MessagingInterface::kPostLoadGame: {
+                BowState::Inventory::Invalidate();
                 {
-                    auto const& cfg = IntegratedBow::GetBowConfig();
-                    UnMapBlock::SetNoLeftBlockPatch(cfg.noLeftBlockPatch);
-                    HiddenItemsPatch::SetEnabled(cfg.hideEquippedFromJsonPatch);
+                    const auto cfg = IntegratedBow::CurrentConfig();
+                    UnMapBlock::SetNoLeftBlockPatch(cfg->noLeftBlockPatch);
+                    HiddenItemsPatch::SetEnabled(cfg->hideEquippedFromJsonPatch);
                 }
 
                 if (message->data == nullptr || g_pendingEssPath.empty()) {
@@ -143,6 +156,7 @@ namespace {
             }
 
             case SKSE::MessagingInterface::kSaveGame: {
+                IntegratedBow::BowConfig::FlushSave();
                 EnsureSaveBowDBLoaded();
 
                 std::string key = GetSaveKeyFromMsg(message);
@@ -203,6 +217,19 @@ extern "C" DLLEXPORT bool SKSEAPI SKSEPlugin_Load(const SKSE::LoadInterface* sks
                                 cfg.gamepadButton2.load(std::memory_order_relaxed),
                                 cfg.gamepadButton3.load(std::memory_order_relaxed));
 
+    {
+        std::scoped_lock lk(cfg.textMtx);
+        BowInput::SetHotkeyPattern(cfg.hotkeyPattern);
+        BowInput::InputGate::SetBlockingMenus(cfg.blockingMenus);
+    }
+
+    if (cfg.inputTrace && cfg.inputTraceRecords > 0) {
+        if (auto path = SKSE::log::log_directory()) {
+            *path /= "IntegratedBoW.trace";
+            BowInput::InputTrace::Open(*path, static_cast<std::uint32_t>(cfg.inputTraceRecords));
+        }
+    }
+
     SKSE::AllocTrampoline(1 << 14);
 
     if (const auto mi = SKSE::GetMessagingInterface()) {
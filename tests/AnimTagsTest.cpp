@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include "World.h"
+#include "bow_input/AnimTags.h"
+#include "bow_input/BowInputHandler.h"
+
+using BowInput::AnimTag;
+using BowInput::AnimTags;
+
+namespace {
+    std::uint64_t HitsOf(AnimTag tag) {
+        return AnimTags::Hits()[static_cast<std::size_t>(tag)].load(std::memory_order_relaxed);
+    }
+
+    void Send(const RE::TESObjectREFR* holder, const RE::BSFixedString& tag, int times) {
+        const RE::BSAnimationGraphEvent ev{tag, holder, {}};
+        for (int i = 0; i < times; ++i) BowInput::HandleAnimEvent(&ev, nullptr);
+    }
+}
+
+TEST(AnimTags, KnownTagsClassifyByNameAndEverythingElseIsNone) {
+    for (std::size_t i = 1; i < static_cast<std::size_t>(AnimTag::Count); ++i) {
+        const auto tag = static_cast<AnimTag>(i);
+        EXPECT_EQ(AnimTags::Classify(RE::BSFixedString{AnimTags::Name(tag)}), tag) << AnimTags::Name(tag);
+    }
+    EXPECT_EQ(AnimTags::Classify(RE::BSFixedString{"SoundPlay"}), AnimTag::None);
+    EXPECT_EQ(AnimTags::Classify(RE::BSFixedString{}), AnimTag::None);
+}
+
+TEST(AnimTags, HandleAnimEventCountsOnlyThePlayersKnownTags) {
+    Headless::World w;
+    std::array<std::uint64_t, static_cast<std::size_t>(AnimTag::Count)> before{};
+    for (std::size_t i = 0; i < before.size(); ++i) before[i] = HitsOf(static_cast<AnimTag>(i));
+
+    // Built at run time, so the match is by the pooled string rather than by one literal's address.
+    const std::string bumper = std::string{"Enable"} + "Bumper";
+    Send(&w.Player(), RE::BSFixedString{bumper}, 3);
+    Send(&w.Player(), RE::BSFixedString{"bowReset"}, 1);
+    Send(&w.Player(), RE::BSFixedString{"arrowAttach"}, 2);
+    Send(&w.Player(), RE::BSFixedString{"SoundPlay"}, 5);
+
+    const RE::Actor bystander{0x0005A1B2, "Guard"};
+    Send(&bystander, RE::BSFixedString{"WeaponSheathe"}, 4);
+
+    EXPECT_EQ(HitsOf(AnimTag::EnableBumper) - before[static_cast<std::size_t>(AnimTag::EnableBumper)], 3u);
+    EXPECT_EQ(HitsOf(AnimTag::BowReset) - before[static_cast<std::size_t>(AnimTag::BowReset)], 1u);
+    EXPECT_EQ(HitsOf(AnimTag::ArrowAttach) - before[static_cast<std::size_t>(AnimTag::ArrowAttach)], 2u);
+    EXPECT_EQ(HitsOf(AnimTag::WeaponSheathe) - before[static_cast<std::size_t>(AnimTag::WeaponSheathe)], 0u);
+    EXPECT_EQ(HitsOf(AnimTag::None) - before[static_cast<std::size_t>(AnimTag::None)], 0u);
+}
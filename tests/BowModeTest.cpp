@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include "BowState.h"
+#include "World.h"
+#include "bow_input/BowInputHandler.h"
+
+using Headless::World;
+namespace Keys = Headless::Keys;
+
+namespace {
+    class BowModeTest : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            BowState::SetChosenBow(w.Bow(), w.ExtrasOf(w.Bow()).front());
+            BowState::SetPreferredArrow(w.IronArrow());
+        }
+
+        World w;
+    };
+}
+
+TEST_F(BowModeTest, HoldEquipsTheChosenBowAndPutsTheSwordBack) {
+    ASSERT_EQ(w.RightHand(), w.Sword());
+
+    w.Press(Keys::kHotkey);
+    w.Run(600);
+    EXPECT_TRUE(BowState::IsUsingBow());
+    EXPECT_EQ(w.RightHand(), w.Bow());
+    EXPECT_TRUE(w.IsWorn(w.IronArrow()));
+    EXPECT_TRUE(w.IsDrawn());
+
+    w.Release(Keys::kHotkey);
+    w.Run(3000);
+    EXPECT_FALSE(BowState::IsUsingBow());
+    EXPECT_EQ(w.RightHand(), w.Sword());
+}
+
+TEST_F(BowModeTest, PressModeTogglesOnEachTap) {
+    BowInput::SetMode(1);
+
+    w.Tap(Keys::kHotkey);
+    w.Run(600);
+    EXPECT_TRUE(BowState::IsUsingBow());
+    EXPECT_EQ(w.RightHand(), w.Bow());
+
+    w.Tap(Keys::kHotkey);
+    w.Run(3000);
+    EXPECT_FALSE(BowState::IsUsingBow());
+    EXPECT_EQ(w.RightHand(), w.Sword());
+}
+
+TEST_F(BowModeTest, BlockingMenuSwallowsTheHotkey) {
+    w.SetMenuOpen("InventoryMenu", true);
+    w.Press(Keys::kHotkey);
+    w.Run(600);
+    EXPECT_FALSE(BowState::IsUsingBow());
+    EXPECT_EQ(w.RightHand(), w.Sword());
+}
+
+TEST_F(BowModeTest, IdleFramesStayOnTheFastPath) {
+    const auto& fc = BowInput::GetFrameCounters();
+    w.Run(200);
+    const auto full = fc.fullPath.load();
+    w.Press(Keys::kForward);
+    w.Run(1000);
+    w.Release(Keys::kForward);
+    w.Run(1000);
+    EXPECT_EQ(fc.fullPath.load(), full);
+}
@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <barrier>
+#include <thread>
+#include <vector>
+
+#include "config/ConfigSnapshot.h"
+
+using namespace IntegratedBow;
+
+namespace {
+    // Every field derived from one generation number, so a reader can tell a torn or freed snapshot from a whole one.
+    ConfigSnapshot Generation(std::uint32_t gen) {
+        ConfigSnapshot s{};
+        const bool odd = (gen & 1u) != 0;
+        s.mode = static_cast<BowMode>(gen % 3);
+        s.sheathedDelaySeconds = static_cast<float>(gen);
+        s.autoDrawEnabled = odd;
+        s.noLeftBlockPatch = odd;
+        s.hideEquippedFromJsonPatch = odd;
+        s.blockUnequip = odd;
+        s.noChosenTag = odd;
+        s.skipEquipBowAnimationPatch = odd;
+        s.skipEquipReturnToMeleePatch = odd;
+        s.cancelHoldExitDelayOnAttackPatch = odd;
+        s.requireExclusiveHotkeyPatch = odd;
+        return s;
+    }
+
+    bool Whole(const ConfigSnapshot& s, std::uint32_t& gen) {
+        gen = static_cast<std::uint32_t>(s.sheathedDelaySeconds);
+        const ConfigSnapshot expect = Generation(gen);
+        return s.mode == expect.mode && s.autoDrawEnabled == expect.autoDrawEnabled &&
+               s.noLeftBlockPatch == expect.noLeftBlockPatch &&
+               s.hideEquippedFromJsonPatch == expect.hideEquippedFromJsonPatch &&
+               s.blockUnequip == expect.blockUnequip && s.noChosenTag == expect.noChosenTag &&
+               s.skipEquipBowAnimationPatch == expect.skipEquipBowAnimationPatch &&
+               s.skipEquipReturnToMeleePatch == expect.skipEquipReturnToMeleePatch &&
+               s.cancelHoldExitDelayOnAttackPatch == expect.cancelHoldExitDelayOnAttackPatch &&
+               s.requireExclusiveHotkeyPatch == expect.requireExclusiveHotkeyPatch;
+    }
+}
+
+TEST(ConfigSnapshot, ReadersSeeTheLatestPublish) {
+    PublishConfig(Generation(7));
+    {
+        const ConfigRef ref;
+        std::uint32_t gen = 0;
+        ASSERT_TRUE(Whole(*ref, gen));
+        EXPECT_EQ(gen, 7u);
+
+        // A reference keeps its snapshot even after a newer one is published.
+        PublishConfig(Generation(8));
+        EXPECT_EQ(ref->sheathedDelaySeconds, 7.0f);
+
+        const ConfigRef nested;
+        EXPECT_EQ(nested->sheathedDelaySeconds, 8.0f);
+    }
+    EXPECT_EQ(CurrentConfig()->sheathedDelaySeconds, 8.0f);
+}
+
+TEST(ConfigSnapshot, SupersededSnapshotsAreFreedOnceUnread) {
+    const auto before = GetConfigReclaimCounters();
+    for (std::uint32_t g = 1; g <= 100; ++g) PublishConfig(Generation(g));
+    const auto after = GetConfigReclaimCounters();
+
+    EXPECT_EQ(after.published - before.published, 100u);
+    // Nothing reads in between, so all but the live one (and the one retired by the last publish) are gone.
+    EXPECT_GE(after.freed, after.published - 2);
+}
+
+TEST(ConfigSnapshot, AHeldReferenceBlocksOnlyItsOwnReclaim) {
+    PublishConfig(Generation(1));
+    std::atomic_bool held{false};
+    std::atomic_bool release{false};
+    std::thread reader([&] {
+        const ConfigRef ref;
+        held.store(true);
+        while (!release.load()) std::this_thread::yield();
+        std::uint32_t gen = 0;
+        EXPECT_TRUE(Whole(*ref, gen));
+        EXPECT_EQ(gen, 1u);
+    });
+    while (!held.load()) std::this_thread::yield();
+
+    const auto freed0 = GetConfigReclaimCounters().freed;
+    for (std::uint32_t g = 2; g <= 20; ++g) PublishConfig(Generation(g));
+    EXPECT_EQ(GetConfigReclaimCounters().freed, freed0);  // everything since the reader entered is pinned
+
+    release.store(true);
+    reader.join();
+    PublishConfig(Generation(21));
+    EXPECT_GE(GetConfigReclaimCounters().freed, freed0 + 19);
+}
+
+// One writer publishing as fast as it can against readers that hold each snapshot for a while: every snapshot a
+// reader sees is whole, generations never go backwards on a thread, and the retired list stays bounded.
+TEST(ConfigSnapshot, StressReadersAgainstAWriter) {
+    constexpr int kReaders = 6;
+    constexpr std::uint32_t kPublishes = 20'000;
+    PublishConfig(Generation(0));
+
+    std::atomic_bool stop{false};
+    std::atomic<std::uint64_t> reads{0};
+    std::atomic<int> failures{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < kReaders; ++r) {
+        readers.emplace_back([&] {
+            std::uint32_t last = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                const ConfigRef ref;
+                std::uint32_t gen = 0;
+                if (!Whole(*ref, gen) || gen < last) failures.fetch_add(1);
+                last = gen;
+                std::this_thread::yield();
+                std::uint32_t again = 0;
+                if (!Whole(*ref, again) || again != gen) failures.fetch_add(1);
+                reads.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    for (std::uint32_t g = 1; g <= kPublishes; ++g) {
+        PublishConfig(Generation(g));
+        if (g % 64 == 0) std::this_thread::yield();
+    }
+    stop.store(true);
+    for (auto& t : readers) t.join();
+
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_GT(reads.load(), 0u);
+
+    PublishConfig(Generation(kPublishes + 1));
+    const auto c = GetConfigReclaimCounters();
+    EXPECT_GE(c.freed, c.published - 2);
+}
+
+// More reading threads than reader slots: the overflow readers are counted instead, and reclaim waits for them.
+TEST(ConfigSnapshot, OverflowReadersAreSafe) {
+    constexpr int kThreads = 80;
+    PublishConfig(Generation(1));
+
+    std::barrier inside(kThreads + 1);
+    std::barrier done(kThreads + 1);
+    std::atomic<int> failures{0};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < kThreads; ++i) {
+        readers.emplace_back([&] {
+            const ConfigRef ref;
+            inside.arrive_and_wait();
+            done.arrive_and_wait();
+            std::uint32_t gen = 0;
+            if (!Whole(*ref, gen) || gen != 1) failures.fetch_add(1);
+        });
+    }
+
+    inside.arrive_and_wait();
+    const auto freed0 = GetConfigReclaimCounters().freed;
+    for (std::uint32_t g = 2; g <= 10; ++g) PublishConfig(Generation(g));
+    EXPECT_EQ(GetConfigReclaimCounters().freed, freed0);
+    done.arrive_and_wait();
+    for (auto& t : readers) t.join();
+
+    EXPECT_EQ(failures.load(), 0);
+    PublishConfig(Generation(11));
+    EXPECT_GE(GetConfigReclaimCounters().freed, freed0 + 9);
+}
@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "AllocCounter.h"
+#include "BowState.h"
+#include "bow_input/EventPool.h"
+
+using BowInput::EventPool;
+
+namespace {
+    struct FakeEvent {
+        int built{0};
+        std::atomic<int> owner{-1};
+    };
+
+    template <std::size_t N>
+    struct Factory {
+        std::vector<std::unique_ptr<FakeEvent>> made;
+        FakeEvent* operator()() { return made.emplace_back(std::make_unique<FakeEvent>()).get(); }
+    };
+}
+
+TEST(EventPool, BuildsLazilyAndReusesReleasedSlots) {
+    EventPool<FakeEvent, 4> pool;
+    Factory<4> make;
+
+    auto* a = pool.Acquire(std::ref(make));
+    ASSERT_NE(a, nullptr);
+    EXPECT_EQ(make.made.size(), 1u);
+
+    EXPECT_TRUE(pool.Release(a));
+    EXPECT_EQ(pool.Acquire(std::ref(make)), a);
+    EXPECT_EQ(make.made.size(), 1u);
+
+    auto* b = pool.Acquire(std::ref(make));
+    EXPECT_NE(b, a);
+    EXPECT_EQ(make.made.size(), 2u);
+    EXPECT_EQ(pool.Stats().inUse, 2u);
+}
+
+TEST(EventPool, ExhaustionIsCountedAndReportedAsNull) {
+    EventPool<FakeEvent, 2> pool;
+    Factory<2> make;
+    auto* a = pool.Acquire(std::ref(make));
+    auto* b = pool.Acquire(std::ref(make));
+    ASSERT_TRUE(a && b);
+
+    EXPECT_EQ(pool.Acquire(std::ref(make)), nullptr);
+    const auto s = pool.Stats();
+    EXPECT_EQ(s.capacity, 2u);
+    EXPECT_EQ(s.inUse, 2u);
+    EXPECT_EQ(s.highWater, 2u);
+    EXPECT_EQ(s.acquired, 2u);
+    EXPECT_EQ(s.exhausted, 1u);
+
+    pool.Release(b);
+    EXPECT_EQ(pool.Acquire(std::ref(make)), b);
+}
+
+TEST(EventPool, ForeignPointersAreNotReleased) {
+    EventPool<FakeEvent, 2> pool;
+    Factory<2> make;
+    FakeEvent stranger;
+    auto* a = pool.Acquire(std::ref(make));
+
+    EXPECT_FALSE(pool.Release(&stranger));
+    EXPECT_FALSE(pool.Release(nullptr));
+    EXPECT_EQ(pool.Stats().inUse, 1u);
+    EXPECT_TRUE(pool.Release(a));
+    EXPECT_EQ(pool.Stats().inUse, 0u);
+}
+
+TEST(EventPool, AFailedFactoryGivesTheSlotBack) {
+    EventPool<FakeEvent, 1> pool;
+    EXPECT_EQ(pool.Acquire([] { return static_cast<FakeEvent*>(nullptr); }), nullptr);
+    EXPECT_EQ(pool.Stats().inUse, 0u);
+
+    Factory<1> make;
+    EXPECT_NE(pool.Acquire(std::ref(make)), nullptr);
+}
+
+TEST(EventPool, HighWaterKeepsThePeak) {
+    EventPool<FakeEvent, 8> pool;
+    Factory<8> make;
+    std::vector<FakeEvent*> held;
+    for (int i = 0; i < 5; ++i) held.push_back(pool.Acquire(std::ref(make)));
+    for (auto* e : held) pool.Release(e);
+    pool.Release(pool.Acquire(std::ref(make)));
+    EXPECT_EQ(pool.Stats().highWater, 5u);
+    EXPECT_EQ(pool.Stats().inUse, 0u);
+}
+
+// Several threads acquiring and releasing at once: a slot is never handed to two holders.
+TEST(EventPool, ConcurrentHoldersNeverShareASlot) {
+    constexpr int kThreads = 4;
+    constexpr int kIterations = 50'000;
+    EventPool<FakeEvent, 8> pool;
+    std::vector<std::unique_ptr<FakeEvent>> slots;
+    for (int i = 0; i < 8; ++i) slots.push_back(std::make_unique<FakeEvent>());
+    std::atomic<int> next{0};
+    auto make = [&] { return slots[static_cast<std::size_t>(next.fetch_add(1))].get(); };
+
+    std::atomic<int> collisions{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < kIterations; ++i) {
+                auto* ev = pool.Acquire(make);
+                if (!ev) continue;
+                int expected = -1;
+                if (!ev->owner.compare_exchange_strong(expected, t)) collisions.fetch_add(1);
+                std::this_thread::yield();
+                ev->owner.store(-1);
+                pool.Release(ev);
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    EXPECT_EQ(collisions.load(), 0);
+    EXPECT_LE(next.load(), 8);
+    EXPECT_EQ(pool.Stats().inUse, 0u);
+}
+
+TEST(AttackEventPool, HoldFramesStopAllocatingOnceWarm) {
+    using namespace BowState::detail;
+    EXPECT_EQ(GetAttackUserEvent().data(), GetAttackUserEvent().data());
+
+    auto frame = [](float held) {
+        EnqueueSyntheticAttack(MakeAttackButtonEvent(1.0f, held));
+        FlushSyntheticInput(nullptr);
+        RecycleDeliveredSyntheticInput();
+    };
+    frame(0.0f);
+
+    const Headless::Allocs::Scope allocs;
+    for (int i = 1; i <= 1000; ++i) frame(0.016f * static_cast<float>(i));
+    EXPECT_EQ(allocs.Count(), 0u);
+    EXPECT_EQ(GetAttackEventPool().Stats().inUse, 0u);
+    EXPECT_EQ(GetAttackEventPool().Stats().exhausted, 0u);
+}
+
+// More than the pool in flight at once (a poll that was not recycled yet): the rest are one-off events and the queue
+// still never holds more than the in-flight limit.
+TEST(AttackEventPool, OverflowFallsBackToOneOffEvents) {
+    using namespace BowState::detail;
+    std::vector<RE::ButtonEvent*> evs;
+    for (std::size_t i = 0; i < kAttackEventPoolSize + 4; ++i) evs.push_back(MakeAttackButtonEvent(1.0f, 0.0f));
+    for (auto* ev : evs) ASSERT_NE(ev, nullptr);
+    EXPECT_EQ(GetAttackEventPool().Stats().exhausted, 4u);
+
+    for (auto* ev : evs) EnqueueSyntheticAttack(ev);
+    std::size_t n = 0;
+    for (auto* e = FlushSyntheticInput(nullptr); e; e = e->next) ++n;
+    EXPECT_EQ(n, evs.size());
+    EXPECT_LE(GetSyntheticInputState().inFlightCount, kSyntheticInputCapacity);
+    RecycleDeliveredSyntheticInput();
+    EXPECT_EQ(GetAttackEventPool().Stats().inUse, 0u);
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+
+#include <bit>
+#include <memory>
+
+#include "bow_input/HotkeyDetector.h"
+
+using namespace BowInput;
+using RE::INPUT_DEVICE;
+
+namespace {
+    constexpr int kDIK_LShift = 0x2A;
+    constexpr int kDIK_V = 0x2F;
+    constexpr int kDIK_E = 0x12;
+    constexpr int kPadLB = 0x0100;
+
+    struct Callbacks final : IHotkeyCallbacks {
+        int pressed{0};
+        int released{0};
+        void OnHotkeyAcceptedPressed(RE::PlayerCharacter*, bool) override { ++pressed; }
+        void OnHotkeyAcceptedReleased(RE::PlayerCharacter*, bool) override { ++released; }
+    };
+
+    class HotkeyDetectorTest : public ::testing::Test {
+    protected:
+        void Bind(int k1, int k2 = -1, int k3 = -1) {
+            hk.bowKeyScanCodes = {k1, k2, k3};
+            HotkeyDetector::CompileKeyboard(hk);
+        }
+
+        void Down(int code) { inputs->OnButton(INPUT_DEVICE::kKeyboard, code, true, true, false); }
+        void Up(int code) { inputs->OnButton(INPUT_DEVICE::kKeyboard, code, false, false, true); }
+
+        void Tick(float dt = 0.016f, bool exclusive = false) {
+            nowMs += static_cast<std::uint64_t>(dt * 1000.0f);
+            HotkeyDetector::Tick(&player, dt, nowMs, hk, *inputs, exclusive, false, hotkeyDown, rt, cb);
+        }
+
+        RE::PlayerCharacter player;
+        HotkeyConfig hk{};
+        HotkeyRuntime rt{};
+        std::unique_ptr<InputState> inputs = std::make_unique<InputState>();
+        Callbacks cb;
+        bool hotkeyDown{false};
+        std::uint64_t nowMs{1000};
+    };
+
+    int Popcount(const KeyboardMatcher& m) {
+        int n = 0;
+        for (auto w : m.combo) n += std::popcount(w);
+        return n;
+    }
+}
+
+TEST_F(HotkeyDetectorTest, CompileDropsUnusedAndDuplicateKeys) {
+    Bind(kDIK_V, -1, kDIK_V);
+    EXPECT_TRUE(hk.kbMatcher.enabled);
+    EXPECT_EQ(Popcount(hk.kbMatcher), 1);
+    EXPECT_TRUE(HotkeyDetector::IsComboKey(hk, INPUT_DEVICE::kKeyboard, kDIK_V));
+    EXPECT_FALSE(HotkeyDetector::IsComboKey(hk, INPUT_DEVICE::kKeyboard, kDIK_E));
+}
+
+TEST_F(HotkeyDetectorTest, CompileNormalizesCapturedPadCodes) {
+    // The capture path stores gamepad codes as -code - 1.
+    hk.bowPadButtons = {InputUtil::EncodeCapture(INPUT_DEVICE::kGamepad, kPadLB), -1, -1};
+    HotkeyDetector::CompileGamepad(hk);
+    EXPECT_TRUE(hk.gpMatcher.enabled);
+    EXPECT_TRUE(HotkeyDetector::IsComboKey(hk, INPUT_DEVICE::kGamepad, kPadLB));
+}
+
+TEST_F(HotkeyDetectorTest, AKeyTheDeviceCannotReportDisablesTheCombo) {
+    Bind(kDIK_V, 0x300);
+    EXPECT_FALSE(hk.kbMatcher.enabled);
+    EXPECT_FALSE(HotkeyDetector::IsComboKey(hk, INPUT_DEVICE::kKeyboard, kDIK_V));
+}
+
+TEST_F(HotkeyDetectorTest, ChordIsAcceptedOnlyWithEveryKeyDown) {
+    Bind(kDIK_LShift, kDIK_V);
+
+    Down(kDIK_LShift);
+    Tick();
+    EXPECT_EQ(cb.pressed, 0);
+
+    Down(kDIK_V);
+    Tick();
+    EXPECT_EQ(cb.pressed, 1);
+    EXPECT_TRUE(hotkeyDown);
+
+    Tick();
+    EXPECT_EQ(cb.pressed, 1);
+
+    Up(kDIK_LShift);
+    Tick();
+    EXPECT_EQ(cb.released, 1);
+    EXPECT_FALSE(hotkeyDown);
+}
+
+TEST_F(HotkeyDetectorTest, ExclusiveWaitsForTheConfirmDelay) {
+    Bind(kDIK_V);
+    Down(kDIK_V);
+    Tick(0.05f, true);
+    EXPECT_EQ(cb.pressed, 0);
+    Tick(0.05f, true);
+    Tick(0.05f, true);
+    EXPECT_EQ(cb.pressed, 1);
+}
+
+TEST_F(HotkeyDetectorTest, ExclusiveToleratesMovementButNotOtherKeys) {
+    Bind(kDIK_V);
+    Down(kDIK_W);
+    Down(kDIK_V);
+    for (int i = 0; i < 10; ++i) Tick(0.05f, true);
+    EXPECT_EQ(cb.pressed, 1);
+
+    Up(kDIK_V);
+    Up(kDIK_W);
+    Tick(0.05f, true);
+    EXPECT_EQ(cb.released, 1);
+
+    Down(kDIK_E);
+    Down(kDIK_V);
+    for (int i = 0; i < 10; ++i) Tick(0.05f, true);
+    EXPECT_EQ(cb.pressed, 1);
+}
+
+TEST_F(HotkeyDetectorTest, ExclusiveTapReleasedBeforeTheDelayStillCounts) {
+    Bind(kDIK_V);
+    Down(kDIK_V);
+    Tick(0.016f, true);
+    Up(kDIK_V);
+    Tick(0.016f, true);
+    EXPECT_EQ(cb.pressed, 1);
+    Tick(0.016f, true);
+    EXPECT_EQ(cb.released, 1);
+}
+
+TEST_F(HotkeyDetectorTest, SuppressHoldsUntilTheChordIsReleased) {
+    Bind(kDIK_V);
+    rt.suppressUntilReleased = true;
+
+    Down(kDIK_V);
+    Tick();
+    Tick();
+    EXPECT_EQ(cb.pressed, 0);
+
+    Up(kDIK_V);
+    Tick();
+    EXPECT_FALSE(rt.suppressUntilReleased);
+
+    Down(kDIK_V);
+    Tick();
+    EXPECT_EQ(cb.pressed, 1);
+}
@@ -0,0 +1,244 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "bow_input/HotkeyPattern.h"
+
+using namespace BowInput;
+using RE::INPUT_DEVICE;
+
+namespace {
+    constexpr int kDIK_LShift = 0x2A;
+    constexpr int kDIK_V = 0x2F;
+    constexpr int kDIK_E = 0x12;
+    constexpr int kPadLB = 0x0100;
+    constexpr int kPadRT = 0x000A;
+
+    class PatternTest : public ::testing::Test {
+    protected:
+        void Compile(std::string_view text) {
+            std::string error;
+            ASSERT_TRUE(HotkeyPattern::Compile(text, p, error)) << error;
+        }
+
+        void Down(INPUT_DEVICE dev, int code) {
+            PatternEngine::OnButton(p, rt, dev, code, true, true, false, nowMs, requireExclusive);
+        }
+        void Up(INPUT_DEVICE dev, int code) {
+            PatternEngine::OnButton(p, rt, dev, code, false, false, true, nowMs, requireExclusive);
+        }
+        void Key(int code, bool down) {
+            down ? Down(INPUT_DEVICE::kKeyboard, code) : Up(INPUT_DEVICE::kKeyboard, code);
+        }
+        void Wait(std::uint64_t ms) {
+            nowMs += ms;
+            PatternEngine::Expire(p, rt, nowMs);
+        }
+        [[nodiscard]] bool Accepted() const { return PatternEngine::Accepted(p, rt); }
+
+        HotkeyPattern p{};
+        PatternRuntime rt{};
+        std::uint64_t nowMs{10'000};
+        bool requireExclusive{false};
+    };
+
+    bool Rejects(std::string_view text) {
+        HotkeyPattern p{};
+        std::string error;
+        const bool ok = HotkeyPattern::Compile(text, p, error);
+        return !ok && !error.empty() && p.Empty();
+    }
+}
+
+TEST(HotkeyPatternCompile, RejectsMalformedText) {
+    EXPECT_TRUE(Rejects(""));
+    EXPECT_TRUE(Rejects("X:1"));
+    EXPECT_TRUE(Rejects("K:"));
+    EXPECT_TRUE(Rejects("K:0x300"));  // no keyboard slot
+    EXPECT_TRUE(Rejects("G:0x300"));  // two pad buttons in one mask
+    EXPECT_TRUE(Rejects("tap K:0x2F"));
+    EXPECT_TRUE(Rejects("K:0x2F | within=0"));
+    EXPECT_TRUE(Rejects("K:0x2F | bogus"));
+    EXPECT_TRUE(Rejects("K:1>K:2>K:3>K:4>K:5>K:6>K:7>K:8>K:9"));
+}
+
+TEST(HotkeyPatternCompile, ParsesStepsAndAttributes) {
+    HotkeyPattern p{};
+    std::string error;
+    ASSERT_TRUE(HotkeyPattern::Compile("tap G:0x100 > G:10 | within=150 | tap=90 | exclusive | nosuppress", p, error))
+        << error;
+    ASSERT_EQ(p.steps.size(), 2u);
+    EXPECT_TRUE(p.steps[0].tap);
+    EXPECT_FALSE(p.steps[1].tap);
+    EXPECT_EQ(p.withinMs, 150u);
+    EXPECT_EQ(p.tapMs, 90u);
+    EXPECT_TRUE(p.exclusive);
+    EXPECT_FALSE(p.suppress);
+    EXPECT_TRUE(PatternEngine::IsKey(p, INPUT_DEVICE::kGamepad, kPadLB));
+    EXPECT_TRUE(PatternEngine::IsKey(p, INPUT_DEVICE::kGamepad, kPadRT));
+    EXPECT_FALSE(PatternEngine::IsKey(p, INPUT_DEVICE::kKeyboard, kPadRT));
+}
+
+TEST_F(PatternTest, ChordStepNeedsEveryKey) {
+    Compile("K:0x2A + K:0x2F");
+    Key(kDIK_V, true);
+    EXPECT_FALSE(Accepted());
+    Key(kDIK_LShift, true);
+    EXPECT_TRUE(Accepted());
+    Key(kDIK_V, false);
+    EXPECT_FALSE(Accepted());
+}
+
+TEST_F(PatternTest, SequenceWithinTheWindow) {
+    Compile("G:0x100 > G:0xA | within=150");
+    Down(INPUT_DEVICE::kGamepad, kPadLB);
+    Wait(60);
+    Up(INPUT_DEVICE::kGamepad, kPadLB);
+    Wait(60);
+    Down(INPUT_DEVICE::kGamepad, kPadRT);
+    EXPECT_TRUE(Accepted());
+    Up(INPUT_DEVICE::kGamepad, kPadRT);
+    EXPECT_FALSE(Accepted());
+}
+
+TEST_F(PatternTest, SequenceTooSlowStartsOver) {
+    Compile("G:0x100 > G:0xA | within=150");
+    Down(INPUT_DEVICE::kGamepad, kPadLB);
+    Up(INPUT_DEVICE::kGamepad, kPadLB);
+    Wait(200);
+    Down(INPUT_DEVICE::kGamepad, kPadRT);
+    EXPECT_FALSE(Accepted());
+}
+
+TEST_F(PatternTest, TapThenHold) {
+    Compile("tap K:0x2F > K:0x2F");
+    Key(kDIK_V, true);
+    Wait(80);
+    Key(kDIK_V, false);
+    Wait(80);
+    Key(kDIK_V, true);
+    EXPECT_TRUE(Accepted());
+    Wait(5000);
+    EXPECT_TRUE(Accepted());  // the held step has no timer
+}
+
+TEST_F(PatternTest, TapHeldTooLongIsNotATap) {
+    Compile("tap K:0x2F > K:0x2F | tap=100");
+    Key(kDIK_V, true);
+    Wait(150);
+    Key(kDIK_V, false);
+    Key(kDIK_V, true);
+    EXPECT_FALSE(Accepted());
+}
+
+TEST_F(PatternTest, DoubleTapThenHold) {
+    Compile("tap K:0x2F > tap K:0x2F > K:0x2F | within=600");
+    for (int i = 0; i < 2; ++i) {
+        Key(kDIK_V, true);
+        Wait(50);
+        Key(kDIK_V, false);
+        Wait(50);
+    }
+    EXPECT_FALSE(Accepted());
+    Key(kDIK_V, true);
+    EXPECT_TRUE(Accepted());
+}
+
+TEST_F(PatternTest, OtherKeysOnlyMatterWhenExclusive) {
+    Compile("K:0x2A > K:0x2F");
+    Key(kDIK_LShift, true);
+    Key(kDIK_E, true);
+    Key(kDIK_V, true);
+    EXPECT_TRUE(Accepted());
+
+    Compile("K:0x2A > K:0x2F | exclusive");
+    rt = {};
+    Key(kDIK_LShift, true);
+    Key(kDIK_E, true);
+    Key(kDIK_V, true);
+    EXPECT_FALSE(Accepted());
+}
+
+TEST_F(PatternTest, GlobalRequireExclusiveActsLikeTheAttribute) {
+    Compile("K:0x2A > K:0x2F");
+    requireExclusive = true;
+    Key(kDIK_LShift, true);
+    Key(kDIK_E, true);
+    Key(kDIK_V, true);
+    EXPECT_FALSE(Accepted());
+}
+
+TEST_F(PatternTest, ExclusiveToleratesMovement) {
+    Compile("K:0x2F | exclusive");
+    Key(0x11, true);  // W
+    Key(kDIK_V, true);
+    EXPECT_TRUE(Accepted());
+}
+
+TEST_F(PatternTest, SuppressWaitsForEveryPatternKeyToBeReleased) {
+    Compile("K:0x2A + K:0x2F");
+    Key(kDIK_LShift, true);
+    Key(kDIK_V, true);
+    ASSERT_TRUE(Accepted());
+
+    PatternEngine::Suppress(p, rt, nowMs);
+    EXPECT_FALSE(Accepted());
+    EXPECT_EQ(rt.state, p.SuppressedState());
+
+    Key(kDIK_V, false);
+    Key(kDIK_V, true);
+    EXPECT_FALSE(Accepted());
+    Key(kDIK_V, false);
+    Key(kDIK_LShift, false);
+    EXPECT_EQ(rt.state, 0);
+
+    Key(kDIK_LShift, true);
+    Key(kDIK_V, true);
+    EXPECT_TRUE(Accepted());
+}
+
+TEST_F(PatternTest, NoSuppressGoesStraightBackToWaiting) {
+    Compile("K:0x2F | nosuppress");
+    Key(kDIK_V, true);
+    PatternEngine::Suppress(p, rt, nowMs);
+    EXPECT_EQ(rt.state, 0);
+}
+
+// Thousands of random edge sequences: the state stays inside the table, and the pattern is only ever accepted while
+// its held step is physically down.
+TEST_F(PatternTest, RandomEdgeSequencesKeepTheInvariants) {
+    const char* patterns[] = {"K:0x2F", "K:0x2A + K:0x2F", "tap K:0x2F > K:0x2F | tap=120 | within=400",
+                              "G:0x100 > G:0xA | within=150 | exclusive", "K:0x2A > tap K:0x12 > K:0x2F+K:0x11"};
+    const std::pair<INPUT_DEVICE, int> keys[] = {
+        {INPUT_DEVICE::kKeyboard, kDIK_V},  {INPUT_DEVICE::kKeyboard, kDIK_LShift},
+        {INPUT_DEVICE::kKeyboard, kDIK_E},  {INPUT_DEVICE::kKeyboard, 0x11},
+        {INPUT_DEVICE::kGamepad, kPadLB},   {INPUT_DEVICE::kGamepad, kPadRT},
+        {INPUT_DEVICE::kKeyboard, 0x3B}};
+
+    std::mt19937 rng(42);
+    for (const char* text : patterns) {
+        Compile(text);
+        const auto& held = p.steps.back().chord;
+        for (int seq = 0; seq < 2000; ++seq) {
+            rt = {};
+            bool down[std::size(keys)]{};
+            for (int e = 0; e < 24; ++e) {
+                const auto k = rng() % std::size(keys);
+                nowMs += rng() % 200;
+                requireExclusive = (rng() % 8) == 0;
+                if (rng() % 16 == 0) PatternEngine::Suppress(p, rt, nowMs);
+                PatternEngine::Expire(p, rt, nowMs);
+
+                down[k] = !down[k];
+                down[k] ? Down(keys[k].first, keys[k].second) : Up(keys[k].first, keys[k].second);
+
+                ASSERT_LE(rt.state, p.SuppressedState()) << text;
+                if (Accepted()) {
+                    for (std::size_t w = 0; w < kPatternWords; ++w) {
+                        ASSERT_EQ(rt.pressed[w] & held[w], held[w]) << text;
+                    }
+                }
+            }
+        }
+    }
+}
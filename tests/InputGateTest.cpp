@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+
+#include "bow_input/InputGate.h"
+
+using BowInput::InputGate;
+using BowInput::UserEventKind;
+
+TEST(InputGate, ClassifiesTheEventsTheHandlerCaresAbout) {
+    EXPECT_EQ(InputGate::ClassifyUserEvent(RE::BSFixedString{"Shout"}), UserEventKind::Shout);
+    EXPECT_EQ(InputGate::ClassifyUserEvent(RE::BSFixedString{"Ready Weapon"}), UserEventKind::ReadyWeapon);
+    EXPECT_EQ(InputGate::ClassifyUserEvent(RE::BSFixedString{"Right Attack/Block"}), UserEventKind::Attack);
+    EXPECT_EQ(InputGate::ClassifyUserEvent(RE::BSFixedString{"Left Attack Attack/Block"}), UserEventKind::Attack);
+}
+
+TEST(InputGate, EverythingElseIsOther) {
+    EXPECT_EQ(InputGate::ClassifyUserEvent(RE::BSFixedString{}), UserEventKind::Other);
+    EXPECT_EQ(InputGate::ClassifyUserEvent(RE::BSFixedString{""}), UserEventKind::Other);
+    EXPECT_EQ(InputGate::ClassifyUserEvent(RE::BSFixedString{"Forward"}), UserEventKind::Other);
+    EXPECT_EQ(InputGate::ClassifyUserEvent(RE::BSFixedString{"Shout "}), UserEventKind::Other);
+    EXPECT_EQ(InputGate::ClassifyUserEvent(RE::BSFixedString{"Right Attack"}), UserEventKind::Other);
+}
+
+TEST(InputGate, IdentityNotSpellingDecides) {
+    // Two handles to the same pooled string classify alike, however they were made.
+    const std::string text = "Ready Weapon";
+    const RE::BSFixedString a{text};
+    const RE::BSFixedString b{std::string_view{text}};
+    ASSERT_EQ(a.data(), b.data());
+    EXPECT_EQ(InputGate::ClassifyUserEvent(a), InputGate::ClassifyUserEvent(b));
+}
+
+TEST(InputGate, IsAttackEventMatchesTheClassifier) {
+    EXPECT_TRUE(InputGate::IsAttackEvent(RE::BSFixedString{"Right Attack/Block"}));
+    EXPECT_TRUE(InputGate::IsAttackEvent(RE::BSFixedString{"Left Attack Attack/Block"}));
+    EXPECT_FALSE(InputGate::IsAttackEvent(RE::BSFixedString{"Shout"}));
+}
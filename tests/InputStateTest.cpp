@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+
+#include "bow_input/InputState.h"
+
+using BowInput::InputState;
+using RE::INPUT_DEVICE;
+
+namespace {
+    constexpr int kDIK_Q = 0x10;
+    constexpr int kDIK_E = 0x12;
+    constexpr int kDIK_R = 0x13;
+
+    void Down(InputState& s, INPUT_DEVICE dev, int code) { s.OnButton(dev, code, true, true, false); }
+    void Held(InputState& s, INPUT_DEVICE dev, int code) { s.OnButton(dev, code, true, false, false); }
+    void Up(InputState& s, INPUT_DEVICE dev, int code) { s.OnButton(dev, code, false, false, true); }
+
+    bool Listed(const InputState& s, INPUT_DEVICE dev, int code) {
+        const auto list = s.DownList(dev);
+        return std::ranges::find(list, code) != list.end();
+    }
+}
+
+TEST(InputState, DownAndUpEdgesMaintainTheList) {
+    auto s = std::make_unique<InputState>();
+
+    Down(*s, INPUT_DEVICE::kKeyboard, kDIK_Q);
+    EXPECT_TRUE(s->IsDown(INPUT_DEVICE::kKeyboard, kDIK_Q));
+    EXPECT_TRUE(Listed(*s, INPUT_DEVICE::kKeyboard, kDIK_Q));
+
+    Held(*s, INPUT_DEVICE::kKeyboard, kDIK_Q);
+    EXPECT_EQ(s->DownList(INPUT_DEVICE::kKeyboard).size(), 1u);
+
+    Up(*s, INPUT_DEVICE::kKeyboard, kDIK_Q);
+    EXPECT_FALSE(s->IsDown(INPUT_DEVICE::kKeyboard, kDIK_Q));
+    EXPECT_TRUE(s->DownList(INPUT_DEVICE::kKeyboard).empty());
+}
+
+TEST(InputState, RepeatedDownEdgesListACodeOnce) {
+    auto s = std::make_unique<InputState>();
+    Down(*s, INPUT_DEVICE::kKeyboard, kDIK_Q);
+    Down(*s, INPUT_DEVICE::kKeyboard, kDIK_Q);
+    EXPECT_EQ(s->DownList(INPUT_DEVICE::kKeyboard).size(), 1u);
+}
+
+TEST(InputState, RemovingFromTheMiddleKeepsTheOthers) {
+    auto s = std::make_unique<InputState>();
+    Down(*s, INPUT_DEVICE::kKeyboard, kDIK_Q);
+    Down(*s, INPUT_DEVICE::kKeyboard, kDIK_E);
+    Down(*s, INPUT_DEVICE::kKeyboard, kDIK_R);
+
+    Up(*s, INPUT_DEVICE::kKeyboard, kDIK_Q);
+    ASSERT_EQ(s->DownList(INPUT_DEVICE::kKeyboard).size(), 2u);
+    EXPECT_TRUE(Listed(*s, INPUT_DEVICE::kKeyboard, kDIK_E));
+    EXPECT_TRUE(Listed(*s, INPUT_DEVICE::kKeyboard, kDIK_R));
+
+    // The swapped entry must still be removable through its own slot.
+    Up(*s, INPUT_DEVICE::kKeyboard, kDIK_R);
+    ASSERT_EQ(s->DownList(INPUT_DEVICE::kKeyboard).size(), 1u);
+    EXPECT_TRUE(Listed(*s, INPUT_DEVICE::kKeyboard, kDIK_E));
+}
+
+TEST(InputState, GamepadMasksAndTriggersFoldIntoSlots) {
+    auto s = std::make_unique<InputState>();
+    constexpr int kLeftShoulder = 0x0100;
+    constexpr int kY = 0x8000;
+    constexpr int kLeftTrigger = 0x9;
+
+    Down(*s, INPUT_DEVICE::kGamepad, kLeftShoulder);
+    Down(*s, INPUT_DEVICE::kGamepad, kY);
+    Down(*s, INPUT_DEVICE::kGamepad, kLeftTrigger);
+    EXPECT_TRUE(s->IsDown(INPUT_DEVICE::kGamepad, kLeftShoulder));
+    EXPECT_TRUE(s->IsDown(INPUT_DEVICE::kGamepad, kY));
+    EXPECT_TRUE(s->IsDown(INPUT_DEVICE::kGamepad, kLeftTrigger));
+    EXPECT_EQ(s->DownList(INPUT_DEVICE::kGamepad).size(), 3u);
+
+    // Keyboard and gamepad codes live in separate sets.
+    EXPECT_FALSE(s->IsDown(INPUT_DEVICE::kKeyboard, kLeftTrigger));
+    EXPECT_TRUE(s->DownList(INPUT_DEVICE::kKeyboard).empty());
+}
+
+TEST(InputState, CodesWithoutASlotAreIgnored) {
+    auto s = std::make_unique<InputState>();
+    Down(*s, INPUT_DEVICE::kGamepad, 0x0300);  // two buttons in one mask
+    Down(*s, INPUT_DEVICE::kKeyboard, 0x1FF);
+    Down(*s, INPUT_DEVICE::kKeyboard, -1);
+    Down(*s, INPUT_DEVICE::kKeyboard, BowInput::kMaxCode);
+
+    EXPECT_TRUE(s->DownList(INPUT_DEVICE::kGamepad).empty());
+    EXPECT_TRUE(s->DownList(INPUT_DEVICE::kKeyboard).empty());
+    EXPECT_FALSE(s->IsDown(INPUT_DEVICE::kGamepad, 0x0300));
+}
+
+TEST(InputState, ClearDropsEverything) {
+    auto s = std::make_unique<InputState>();
+    Down(*s, INPUT_DEVICE::kKeyboard, kDIK_Q);
+    Down(*s, INPUT_DEVICE::kGamepad, 0x1000);
+    s->Clear();
+
+    EXPECT_FALSE(s->IsDown(INPUT_DEVICE::kKeyboard, kDIK_Q));
+    EXPECT_FALSE(s->IsDown(INPUT_DEVICE::kGamepad, 0x1000));
+    EXPECT_TRUE(s->DownList(INPUT_DEVICE::kKeyboard).empty());
+    EXPECT_TRUE(s->DownList(INPUT_DEVICE::kGamepad).empty());
+
+    // The sparse set starts over cleanly.
+    Down(*s, INPUT_DEVICE::kKeyboard, kDIK_E);
+    EXPECT_EQ(s->DownList(INPUT_DEVICE::kKeyboard).size(), 1u);
+}
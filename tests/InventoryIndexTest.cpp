@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include "AllocCounter.h"
+#include "InventoryIndex.h"
+#include "World.h"
+
+using Headless::World;
+namespace Inventory = BowState::Inventory;
+
+TEST(InventoryIndex, FindsTheLoadoutWithItsExtras) {
+    World w;
+    auto const* bow = Inventory::Find(w.Bow());
+    ASSERT_NE(bow, nullptr);
+    EXPECT_EQ(bow->count, 1);
+    EXPECT_EQ(bow->extras, w.ExtrasOf(w.Bow()));
+
+    auto const* arrows = Inventory::Find(w.IronArrow());
+    ASSERT_NE(arrows, nullptr);
+    EXPECT_EQ(arrows->count, 50);
+    EXPECT_EQ(Inventory::Find(w.SteelArrow()), nullptr);
+    EXPECT_EQ(Inventory::Armor().size(), 3u);
+}
+
+TEST(InventoryIndex, PickupsAndDropsShowUpOnTheNextQuery) {
+    World w;
+    ASSERT_NE(Inventory::Find(w.IronArrow()), nullptr);
+
+    w.Give(w.IronArrow(), 10, false);
+    EXPECT_EQ(Inventory::Find(w.IronArrow())->count, 60);
+
+    auto* extra = w.Give(w.SteelArrow(), 5);
+    ASSERT_NE(Inventory::Find(w.SteelArrow()), nullptr);
+    EXPECT_TRUE(Inventory::IsLive(w.SteelArrow(), extra));
+
+    w.Take(w.SteelArrow(), extra);
+    EXPECT_FALSE(Inventory::IsLive(w.SteelArrow(), extra));
+    EXPECT_EQ(Inventory::Find(w.SteelArrow())->count, 4);
+}
+
+TEST(InventoryIndex, UniqueIdsResolveToLiveInstances) {
+    World w;
+    auto* extra = w.ExtrasOf(w.Bow()).front();
+    w.Player().GetInventoryChanges()->SetUniqueID(extra, w.Bow(), w.Bow());
+    const auto uid = extra->GetByType<RE::ExtraUniqueID>()->uniqueID;
+    Inventory::Invalidate();
+
+    EXPECT_EQ(Inventory::FindUnique(w.Bow(), uid), extra);
+    EXPECT_EQ(Inventory::FindUnique(w.LongBow(), uid), nullptr);
+
+    w.Take(w.Bow(), extra);
+    EXPECT_EQ(Inventory::FindUnique(w.Bow(), uid), nullptr);
+}
+
+TEST(InventoryIndex, ClutterPickupsDoNotRebuild) {
+    World w;
+    RE::TESBoundObject cheese{0x00064B31, RE::FormType::None, "Cheese Wheel"};
+    ASSERT_NE(Inventory::Find(w.Bow()), nullptr);
+
+    {
+        w.Give(&cheese, 3, false);
+        const Headless::Allocs::Scope allocs;
+        EXPECT_NE(Inventory::Find(w.Bow()), nullptr);
+        EXPECT_EQ(allocs.Count(), 0u);
+    }
+    {
+        w.Give(w.IronArrow(), 1, false);
+        const Headless::Allocs::Scope allocs;
+        EXPECT_EQ(Inventory::Find(w.IronArrow())->count, 51);
+        EXPECT_GT(allocs.Count(), 0u);  // rebuilt
+    }
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "bow_input/MpscRing.h"
+
+using BowInput::MpscRing;
+
+TEST(MpscRing, PopsInPushOrder) {
+    MpscRing<int, 8> ring;
+    EXPECT_TRUE(ring.EmptyRelaxed());
+    for (int i = 0; i < 5; ++i) ASSERT_TRUE(ring.TryPush(i));
+    EXPECT_FALSE(ring.EmptyRelaxed());
+
+    int v = -1;
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(ring.TryPop(v));
+        EXPECT_EQ(v, i);
+    }
+    EXPECT_FALSE(ring.TryPop(v));
+    EXPECT_TRUE(ring.EmptyRelaxed());
+}
+
+TEST(MpscRing, FullRingRefusesAndRecoversAfterAPop) {
+    MpscRing<int, 4> ring;
+    for (int i = 0; i < 4; ++i) ASSERT_TRUE(ring.TryPush(i));
+    EXPECT_FALSE(ring.TryPush(99));
+
+    int v = -1;
+    ASSERT_TRUE(ring.TryPop(v));
+    EXPECT_EQ(v, 0);
+    EXPECT_TRUE(ring.TryPush(4));
+    EXPECT_FALSE(ring.TryPush(5));
+}
+
+TEST(MpscRing, WrapsManyTimes) {
+    MpscRing<int, 4> ring;
+    int v = -1;
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(ring.TryPush(i));
+        ASSERT_TRUE(ring.TryPush(i + 1));
+        ASSERT_TRUE(ring.TryPop(v));
+        ASSERT_EQ(v, i);
+        ASSERT_TRUE(ring.TryPop(v));
+        ASSERT_EQ(v, i + 1);
+    }
+}
+
+// Producers race on a small ring while one consumer drains it: nothing is lost or duplicated, and each producer's
+// values come out in the order it pushed them.
+TEST(MpscRing, ManyProducersOneConsumer) {
+    constexpr std::uint64_t kProducers = 4;
+    constexpr std::uint64_t kPerProducer = 200'000;
+    MpscRing<std::uint64_t, 64> ring;
+
+    std::vector<std::thread> producers;
+    for (std::uint64_t p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&ring, p] {
+            for (std::uint64_t i = 0; i < kPerProducer; ++i) {
+                while (!ring.TryPush((p << 32) | i)) std::this_thread::yield();
+            }
+        });
+    }
+
+    std::vector<std::uint64_t> next(kProducers, 0);
+    std::uint64_t received = 0;
+    std::uint64_t v = 0;
+    while (received < kProducers * kPerProducer) {
+        if (!ring.TryPop(v)) {
+            std::this_thread::yield();
+            continue;
+        }
+        const auto p = v >> 32;
+        ASSERT_LT(p, kProducers);
+        ASSERT_EQ(v & 0xFFFFFFFFu, next[p]) << "producer " << p;
+        ++next[p];
+        ++received;
+    }
+    for (auto& t : producers) t.join();
+
+    EXPECT_FALSE(ring.TryPop(v));
+    for (auto n : next) EXPECT_EQ(n, kPerProducer);
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BowState.h"
+#include "LegacyNameRewrite.h"
+
+using namespace BowState::detail;
+
+namespace {
+    // What the plugin does with a display name before tagging it (see ApplyChosenTagToInstance).
+    std::string BaseName(std::string_view name) {
+        std::array<char, 512> scratch;
+        const auto cleaned = RemoveChosenTags(name, scratch);
+        return std::string{cleaned.substr(0, BaseNameLength(cleaned))};
+    }
+
+    // Weapon names from popular bow and weapon mods and their translations, plus the odd shapes parentheses and
+    // spacing take in user-renamed items.
+    const std::vector<std::string>& Corpus() {
+        static const std::vector<std::string> s = [] {  // NOSONAR
+            std::vector<std::string> v{
+                "Hunting Bow",
+                "Daedric Bow of the Inferno",
+                "Nordic Hero Bow",
+                "Auriel's Bow",
+                "Zephyr",
+                "Bow of Shadows (Nightingale)",
+                "Longbow (Replica)",
+                "Elven Bow (Sun)",
+                "Glass Bow of Debilitation",
+                "Lucky Bow ( )",
+                "Bow )",
+                "( Bow",
+                "(Fine)",
+                "(chosen)",
+                "Bow(Fine)",
+                "Bow  (fine)x",
+                "Bow (Fine",
+                "Arco Élfico",
+                "Лук охотника",
+                "Лук (Легендарный)",
+                "精灵弓",
+                "Bogen der Jägerin",
+                "Łuk myśliwego",
+                "Arc d’Auriel",
+                "🏹 Emoji Bow",
+                "Dwarven Crossbow (Enhanced)",
+                "Bow (chosen) of Doom",
+                " (cho (chosen)sen)",
+                "",
+                " ",
+            };
+            v.push_back(std::string(300, 'x') + " Bow");
+            v.push_back("Supreme " + std::string(440, 'y'));
+            return v;
+        }();
+        return s;
+    }
+
+    constexpr std::array<std::string_view, 14> kSuffixes{
+        " (chosen)", " (Fine)",  " (SUPERIOR)", " (exquisite)", " (Flawless)", " (Epic)", " (legendary)",
+        " (LeGeNdArY)", " ",    "  ",          " (Chosen)",    " (Fine",      "(fine)",  " (Élite)",
+    };
+}
+
+TEST(NameRewrite, TemperingTagsFoldCase) {
+    for (auto tag : {"fine", "Fine", "SUPERIOR", "Exquisite", "flawLess", "EPIC", "Legendary"}) {
+        EXPECT_TRUE(IsTemperingTag(tag)) << tag;
+    }
+    for (auto tag : {"", "fin", "finer", "chosen", "legendary ", "Fïne", "legendaryy", "épic"}) {
+        EXPECT_FALSE(IsTemperingTag(tag)) << tag;
+    }
+}
+
+TEST(NameRewrite, PeelsSuffixesRightToLeft) {
+    EXPECT_EQ(BaseName("Iron Sword (Fine)"), "Iron Sword");
+    EXPECT_EQ(BaseName("Hunting Bow (Legendary) (chosen)"), "Hunting Bow");
+    EXPECT_EQ(BaseName("Hunting Bow (chosen) (Epic)  "), "Hunting Bow");
+    EXPECT_EQ(BaseName("Hunting Bow (Replica) (Fine)"), "Hunting Bow (Replica)");
+    EXPECT_EQ(BaseName("Hunting Bow (Fine) Replica"), "Hunting Bow (Fine) Replica");
+    EXPECT_EQ(BaseName("Bow(Fine)"), "Bow(Fine)");
+    EXPECT_EQ(BaseName("(Fine)"), "(Fine)");
+    EXPECT_EQ(BaseName("(chosen)"), "(chosen)");
+}
+
+TEST(NameRewrite, ChosenTagsComeOutWhereverTheyAre) {
+    std::array<char, 64> scratch;
+    EXPECT_EQ(RemoveChosenTags("Bow (chosen) of Doom (chosen)", scratch), "Bow of Doom");
+    EXPECT_EQ(RemoveChosenTags(" (cho (chosen)sen)", scratch), "");  // removing one forms another across the gap
+
+    const std::string_view untouched{"Hunting Bow (Fine)"};
+    EXPECT_EQ(RemoveChosenTags(untouched, scratch).data(), untouched.data());
+}
+
+TEST(NameRewrite, NamesPastTheScratchBufferAreLeftAlone) {
+    std::array<char, 16> scratch;
+    const std::string_view longName{"A rather long bow name (chosen)"};
+    EXPECT_EQ(RemoveChosenTags(longName, scratch).data(), longName.data());
+    EXPECT_EQ(BaseNameLength(longName), std::string_view{"A rather long bow name"}.size());
+}
+
+// Every corpus name with random runs of tags, spaces and near-misses appended: the single-pass helpers agree with the
+// heap-string version they replaced, their result is a fixed point, and no chosen tag survives.
+TEST(NameRewrite, MatchesTheLegacyRewriteOverTheCorpus) {
+    std::mt19937 rng(20);
+    std::size_t checked = 0;
+    for (auto const& base : Corpus()) {
+        for (int round = 0; round < 500; ++round) {
+            std::string name = base;
+            const auto pieces = rng() % 5;
+            for (std::size_t i = 0; i < pieces; ++i) name += kSuffixes[rng() % kSuffixes.size()];
+            if (name.size() >= 512) continue;
+
+            const auto got = BaseName(name);
+            ASSERT_EQ(got, Headless::LegacyNames::BaseName(name)) << '"' << name << '"';
+            ASSERT_EQ(BaseName(got), got) << '"' << name << '"';
+            ASSERT_EQ(got.find(" (chosen)"), std::string::npos) << '"' << name << '"';
+            ++checked;
+        }
+    }
+    EXPECT_GT(checked, 10'000u);
+}
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+
+#include "SaveBowFiles.h"
+
+using IntegratedBow::SaveBowDB;
+using IntegratedBow::SaveBowPrefs;
+namespace SB = Headless::SaveBows;
+
+TEST(SaveBowDB, EntriesSurviveAReloadThroughTheIndex) {
+    SB::Fill(2'000);
+    auto& db = SaveBowDB::Get();
+    ASSERT_TRUE(std::filesystem::exists(SaveBowDB::IndexPath()));
+
+    db.Erase(SB::Key(7));
+    db.Upsert(SB::Key(8), SB::Prefs(9'000));
+    db.SaveToDisk();
+    db.WaitForCompaction();
+    db.LoadFromDisk();
+
+    SaveBowPrefs p{};
+    EXPECT_FALSE(db.TryGetNormalized(SB::Key(7), p));
+    ASSERT_TRUE(db.TryGetNormalized(SB::Key(8), p));
+    EXPECT_EQ(p, SB::Prefs(9'000));
+    for (std::size_t i : {0u, 1u, 999u, 1'999u}) {
+        ASSERT_TRUE(db.TryGetNormalized(SB::Key(i), p)) << i;
+        EXPECT_EQ(p, SB::Prefs(i));
+    }
+    EXPECT_FALSE(db.TryGetNormalized(SB::Key(2'000), p));
+}
+
+TEST(SaveBowDB, TheJsonExportReadsBackWithTheOldLoader) {
+    SB::Fill(500);
+    const auto bySave = SB::LegacyLoad(SaveBowDB::JsonPath());
+    ASSERT_EQ(bySave.size(), 500u);
+    EXPECT_EQ(bySave.at(SB::Key(42)), SB::Prefs(42));
+}
+
+// A journal removed or replaced while the game runs: the next load must not keep appending to the old file.
+TEST(SaveBowDB, ReloadAfterTheFilesAreRemovedStartsAFreshJournal) {
+    SB::Fill(10);
+    auto& db = SaveBowDB::Get();
+    db.Upsert(SB::Key(1), SB::Prefs(50));
+    db.SaveToDisk();
+    db.WaitForCompaction();
+
+    SB::RemoveFiles();
+    db.LoadFromDisk();
+    db.Upsert(SB::Key(2), SB::Prefs(60));
+    db.SaveToDisk();
+    db.WaitForCompaction();
+    ASSERT_TRUE(std::filesystem::exists(SaveBowDB::JournalPath()));
+
+    db.LoadFromDisk();
+    ASSERT_TRUE(db.IsLoadOK());
+    SaveBowPrefs p{};
+    ASSERT_TRUE(db.TryGetNormalized(SB::Key(2), p));
+    EXPECT_EQ(p, SB::Prefs(60));
+    EXPECT_FALSE(db.TryGetNormalized(SB::Key(1), p));
+}
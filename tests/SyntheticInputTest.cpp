@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "BowState.h"
+
+using namespace BowState::detail;
+
+namespace {
+    RE::ButtonEvent* Attack(float value, float held) { return MakeAttackButtonEvent(value, held); }
+
+    std::vector<const RE::ButtonEvent*> Walk(RE::InputEvent* head) {
+        std::vector<const RE::ButtonEvent*> out;
+        for (auto* e = head; e; e = e->next) out.push_back(e->AsButtonEvent());
+        return out;
+    }
+
+    class SyntheticInputTest : public ::testing::Test {
+    protected:
+        void TearDown() override {
+            RE::ButtonEvent sentinel{};
+            FlushSyntheticInput(&sentinel);
+            RecycleDeliveredSyntheticInput();
+        }
+    };
+}
+
+TEST_F(SyntheticInputTest, EmptyQueueLeavesThePollAlone) {
+    RE::ButtonEvent real{};
+    EXPECT_FALSE(HasPendingSyntheticInput());
+    EXPECT_EQ(FlushSyntheticInput(&real), &real);
+    EXPECT_FALSE(IsSyntheticInput(&real));
+}
+
+TEST_F(SyntheticInputTest, QueuedEventsGoFirstInQueueOrder) {
+    auto* down = Attack(1.0f, 0.0f);
+    auto* up = Attack(0.0f, 0.4f);
+    EnqueueSyntheticAttack(down);
+    EnqueueSyntheticAttack(up);
+    ASSERT_TRUE(HasPendingSyntheticInput());
+
+    RE::ButtonEvent real{};
+    const auto list = Walk(FlushSyntheticInput(&real));
+    ASSERT_EQ(list.size(), 3u);
+    EXPECT_EQ(list[0], down);
+    EXPECT_EQ(list[1], up);
+    EXPECT_EQ(list[2], &real);
+    EXPECT_TRUE(IsSyntheticInput(down));
+    EXPECT_FALSE(HasPendingSyntheticInput());
+}
+
+TEST_F(SyntheticInputTest, HoldFramesCoalesceToTheLatest) {
+    EnqueueSyntheticAttack(Attack(1.0f, 0.0f));
+    for (int i = 1; i <= 5; ++i) EnqueueSyntheticAttack(Attack(1.0f, 0.1f * static_cast<float>(i)));
+
+    const auto list = Walk(FlushSyntheticInput(nullptr));
+    ASSERT_EQ(list.size(), 2u);
+    EXPECT_TRUE(list[0]->IsDown());
+    EXPECT_TRUE(list[1]->IsHeld());
+    EXPECT_FLOAT_EQ(list[1]->HeldDuration(), 0.5f);
+
+    // The merged-away holds went straight back to the pool; the two delivered ones follow after the poll.
+    EXPECT_EQ(GetAttackEventPool().Stats().inUse, 2u);
+    RecycleDeliveredSyntheticInput();
+    EXPECT_EQ(GetAttackEventPool().Stats().inUse, 0u);
+    EXPECT_FALSE(IsSyntheticInput(list[0]));
+}
+
+TEST_F(SyntheticInputTest, AReleaseBreaksTheHoldRun) {
+    EnqueueSyntheticAttack(Attack(1.0f, 0.1f));
+    EnqueueSyntheticAttack(Attack(0.0f, 0.2f));
+    EnqueueSyntheticAttack(Attack(1.0f, 0.0f));
+    EnqueueSyntheticAttack(Attack(1.0f, 0.1f));
+
+    const auto list = Walk(FlushSyntheticInput(nullptr));
+    ASSERT_EQ(list.size(), 4u);
+    EXPECT_TRUE(list[1]->IsUp());
+    EXPECT_TRUE(list[2]->IsDown());
+}
+
+TEST_F(SyntheticInputTest, AFullQueueDropsTheOverflow) {
+    for (std::size_t i = 0; i < kSyntheticInputCapacity + 8; ++i) EnqueueSyntheticAttack(Attack(1.0f, 0.0f));
+
+    const auto list = Walk(FlushSyntheticInput(nullptr));
+    EXPECT_EQ(list.size(), kSyntheticInputCapacity);
+    EXPECT_FALSE(HasPendingSyntheticInput());
+}
+
+// Producers on other threads (the task queue, the mode controller) while the poll hook drains every "frame".
+TEST_F(SyntheticInputTest, ConcurrentProducersLoseNothingBelowCapacity) {
+    constexpr int kProducers = 4;
+    constexpr int kRounds = 2000;
+    constexpr int kPerRound = 4;  // 16 per round in total, well below the ring
+
+    std::atomic<int> round{0};
+    std::atomic<int> done{0};
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&] {
+            for (int r = 0; r < kRounds; ++r) {
+                while (round.load(std::memory_order_acquire) < r) std::this_thread::yield();
+                for (int i = 0; i < kPerRound; ++i) EnqueueSyntheticAttack(Attack(1.0f, 0.0f));
+                done.fetch_add(1, std::memory_order_acq_rel);
+            }
+        });
+    }
+
+    std::size_t delivered = 0;
+    for (int r = 0; r < kRounds; ++r) {
+        while (done.load(std::memory_order_acquire) < (r + 1) * kProducers) std::this_thread::yield();
+        delivered += Walk(FlushSyntheticInput(nullptr)).size();
+        RecycleDeliveredSyntheticInput();
+        round.store(r + 1, std::memory_order_release);
+    }
+    for (auto& t : producers) t.join();
+
+    EXPECT_EQ(delivered, std::size_t{kProducers} * kRounds * kPerRound);
+}
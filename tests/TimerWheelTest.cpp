@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "bow_input/FrameClock.h"
+#include "bow_input/TimerWheel.h"
+
+using BowInput::TimerWheel;
+
+namespace {
+    // Callbacks log their ctx here, so a test can check what fired and in which order.
+    std::vector<std::uintptr_t>& Fired() {
+        static std::vector<std::uintptr_t> s;  // NOSONAR
+        return s;
+    }
+
+    void Record(std::uintptr_t ctx) { Fired().push_back(ctx); }
+
+    class TimerWheelTest : public ::testing::Test {
+    protected:
+        void SetUp() override { Fired().clear(); }
+
+        TimerWheel wheel{1000};
+    };
+}
+
+TEST_F(TimerWheelTest, FiresOnItsDeadlineTickAndNotBefore) {
+    auto h = wheel.Arm(1010, &Record, 1);
+    ASSERT_NE(h, TimerWheel::kNone);
+    EXPECT_TRUE(wheel.IsPending(h));
+
+    EXPECT_EQ(wheel.Advance(1009), 0u);
+    EXPECT_TRUE(Fired().empty());
+    EXPECT_EQ(wheel.Now(), 1009u);
+
+    EXPECT_EQ(wheel.Advance(1010), 1u);
+    EXPECT_EQ(Fired(), std::vector<std::uintptr_t>{1});
+    EXPECT_FALSE(wheel.IsPending(h));
+    EXPECT_TRUE(wheel.Empty());
+}
+
+TEST_F(TimerWheelTest, ADeadlineInThePastFiresOnTheNextAdvance) {
+    wheel.Arm(500, &Record, 1);
+    EXPECT_EQ(wheel.Advance(1000), 0u);  // the clock did not move
+    EXPECT_EQ(wheel.Advance(1001), 1u);
+}
+
+TEST_F(TimerWheelTest, CancelBeforeTheDeadlineSuppressesTheCallback) {
+    auto h = wheel.Arm(1020, &Record, 1);
+    EXPECT_TRUE(wheel.Cancel(h));
+    EXPECT_EQ(h, TimerWheel::kNone);
+    EXPECT_TRUE(wheel.Empty());
+
+    EXPECT_EQ(wheel.Advance(2000), 0u);
+    EXPECT_TRUE(Fired().empty());
+}
+
+TEST_F(TimerWheelTest, StaleHandlesAreHarmless) {
+    auto fired = wheel.Arm(1005, &Record, 1);
+    wheel.Advance(1005);
+    auto copy = fired;
+    EXPECT_FALSE(wheel.IsPending(fired));
+    EXPECT_FALSE(wheel.Cancel(fired));
+    EXPECT_EQ(fired, TimerWheel::kNone);
+
+    // The freed node is reused by the next Arm; the old handle's generation no longer matches it.
+    auto reused = wheel.Arm(1010, &Record, 2);
+    ASSERT_NE(reused, copy);
+    EXPECT_FALSE(wheel.IsPending(copy));
+    EXPECT_FALSE(wheel.Cancel(copy));
+    EXPECT_TRUE(wheel.IsPending(reused));
+
+    wheel.Advance(1010);
+    EXPECT_EQ(Fired(), (std::vector<std::uintptr_t>{1, 2}));
+}
+
+// Deadlines far enough out to start on level 1 or 2 cascade down on their boundary tick and fire on that same tick.
+TEST_F(TimerWheelTest, CascadedTimersFireOnTheirOwnTick) {
+    TimerWheel w{0};
+    w.Arm(64, &Record, 1);         // level 1, due at its cascade boundary
+    w.Arm(64 * 3 + 5, &Record, 2);  // level 1, cascades into a later level-0 slot
+    w.Arm(4096, &Record, 3);        // level 2, down through level 1 into level 0 on one tick
+    w.Arm(4096 + 64 + 1, &Record, 4);
+
+    EXPECT_EQ(w.Advance(63), 0u);
+    EXPECT_EQ(w.Advance(64), 1u);
+    EXPECT_EQ(w.Advance(64 * 3 + 4), 0u);
+    EXPECT_EQ(w.Advance(64 * 3 + 5), 1u);
+    EXPECT_EQ(w.Advance(4095), 0u);
+    EXPECT_EQ(w.Advance(4096), 1u);
+    EXPECT_EQ(w.Advance(4096 + 64), 0u);
+    EXPECT_EQ(w.Advance(4096 + 64 + 1), 1u);
+    EXPECT_EQ(Fired(), (std::vector<std::uintptr_t>{1, 2, 3, 4}));
+}
+
+TEST_F(TimerWheelTest, OneAdvanceFiresInDeadlineOrder) {
+    wheel.Arm(1300, &Record, 4);
+    wheel.Arm(1003, &Record, 1);
+    wheel.Arm(5000, &Record, 5);
+    wheel.Arm(1070, &Record, 3);
+    wheel.Arm(1040, &Record, 2);
+
+    EXPECT_EQ(wheel.Advance(6000), 5u);
+    EXPECT_EQ(Fired(), (std::vector<std::uintptr_t>{1, 2, 3, 4, 5}));
+}
+
+TEST_F(TimerWheelTest, AnExhaustedPoolRefusesUntilANodeIsFreed) {
+    std::vector<TimerWheel::Handle> handles;
+    for (std::size_t i = 0; i < TimerWheel::kMaxTimers; ++i) {
+        handles.push_back(wheel.Arm(2000 + i, &Record, i));
+        ASSERT_NE(handles.back(), TimerWheel::kNone) << i;
+    }
+    EXPECT_EQ(wheel.Pending(), TimerWheel::kMaxTimers);
+    EXPECT_EQ(wheel.Arm(3000, &Record, 99), TimerWheel::kNone);
+
+    EXPECT_TRUE(wheel.Cancel(handles[10]));
+    EXPECT_NE(wheel.Arm(3000, &Record, 99), TimerWheel::kNone);
+    EXPECT_EQ(wheel.Arm(3001, &Record, 100), TimerWheel::kNone);
+
+    EXPECT_EQ(wheel.Advance(4000), TimerWheel::kMaxTimers);
+    EXPECT_TRUE(wheel.Empty());
+}
+
+namespace {
+    // A callback that re-arms itself until its count runs out and cancels a sibling the first time it runs.
+    struct Rearming {
+        TimerWheel* wheel{nullptr};
+        int remaining{0};
+        TimerWheel::Handle sibling{TimerWheel::kNone};
+        std::vector<std::uint64_t> at;
+
+        static void Fire(std::uintptr_t ctx) {
+            auto& self = *reinterpret_cast<Rearming*>(ctx);  // NOSONAR
+            self.at.push_back(self.wheel->Now());
+            self.wheel->Cancel(self.sibling);
+            if (--self.remaining > 0) self.wheel->Arm(self.wheel->Now() + 10, &Fire, ctx);
+        }
+    };
+}
+
+TEST_F(TimerWheelTest, CallbacksMayArmAndCancelFromInsideAdvance) {
+    // Same slot: a slot pops newest first, so the sibling is still linked when the first callback runs.
+    Rearming r{&wheel, 3};
+    r.sibling = wheel.Arm(1010, &Record, 7);
+    wheel.Arm(1010, &Rearming::Fire, reinterpret_cast<std::uintptr_t>(&r));  // NOSONAR
+
+    EXPECT_EQ(wheel.Advance(1100), 3u);
+    EXPECT_EQ(r.at, (std::vector<std::uint64_t>{1010, 1020, 1030}));
+    EXPECT_TRUE(Fired().empty());
+    EXPECT_TRUE(wheel.Empty());
+}
+
+namespace {
+    std::uint64_t g_us = 0;
+    std::uint64_t VirtualUs() noexcept { return g_us; }
+
+    void Tick(std::uint64_t ms) {
+        g_us += ms * 1000;
+        BowInput::FrameClock::BeginFrame();
+    }
+
+    TimerWheel::Handle g_victim = TimerWheel::kNone;
+
+    // Runs from Scheduler::Advance: re-entering the scheduler would deadlock if Advance still held its lock.
+    void ReenterScheduler(std::uintptr_t ctx) {
+        Record(ctx);
+        BowInput::Scheduler::Cancel(g_victim);
+        if (ctx < 3) BowInput::Scheduler::After(5, &ReenterScheduler, ctx + 1);
+    }
+}
+
+TEST_F(TimerWheelTest, SchedulerCallbacksReenterWithoutTheLock) {
+    g_us = 1'000'000;
+    BowInput::FrameClock::SetSource(&VirtualUs);
+    BowInput::FrameClock::BeginFrame();
+
+    BowInput::Scheduler::After(10, &ReenterScheduler, 1);
+    g_victim = BowInput::Scheduler::After(12, &Record, 99);
+    ASSERT_TRUE(BowInput::Scheduler::IsPending(g_victim));
+
+    Tick(10);
+    BowInput::Scheduler::Advance();
+    EXPECT_EQ(Fired(), std::vector<std::uintptr_t>{1});
+    EXPECT_EQ(g_victim, TimerWheel::kNone);
+
+    Tick(5);
+    BowInput::Scheduler::Advance();
+    Tick(5);
+    BowInput::Scheduler::Advance();
+    EXPECT_EQ(Fired(), (std::vector<std::uintptr_t>{1, 2, 3}));
+
+    BowInput::FrameClock::SetSource(nullptr);
+}
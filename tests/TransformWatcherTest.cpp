@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include "BowState.h"
+#include "World.h"
+#include "bow_input/TransformWatcher.h"
+
+using Headless::World;
+namespace Keys = Headless::Keys;
+using RE::EffectArchetypes::ArchetypeID;
+using RE::MagicSystem::SpellType;
+
+namespace {
+    // The power index is built once, by the first World (kDataLoaded), so the spells must exist before it.
+    class TransformWatcherTest : public ::testing::Test {
+    protected:
+        TransformWatcherTest()
+            : werewolf(MakeSpell(0x00092C48, "Beast Form", SpellType::kPower, ArchetypeID::kWerewolf)),
+              vampireLord(MakeSpell(0x0200283B, "Vampire Lord", SpellType::kPower, ArchetypeID::kVampireLord)),
+              greybeard(MakeSpell(0x000CF7A4, "Voice of the Sky", SpellType::kPower, ArchetypeID::kScript)),
+              lesser(MakeSpell(0x0200F00D, "Lesser Beast", SpellType::kLesserPower, ArchetypeID::kWerewolf)) {}
+
+        RE::SpellItem* MakeSpell(RE::FormID id, const char* name, SpellType type, ArchetypeID arch) {
+            auto& mgef = _mgefs.emplace_back(std::make_unique<RE::EffectSetting>(id | 0x00F00000, arch));
+            auto& effect = _effects.emplace_back(std::make_unique<RE::Effect>());
+            effect->baseEffect = mgef.get();
+            auto& spell = _spells.emplace_back(std::make_unique<RE::SpellItem>(id, name, type));
+            spell->effects.push_back(effect.get());
+            return spell.get();
+        }
+
+        void Select(RE::SpellItem* power) { w.Player().GetActorRuntimeData().selectedPower = power; }
+
+        void EnterBowMode() {
+            BowState::SetChosenBow(w.Bow(), w.ExtrasOf(w.Bow()).front());
+            BowState::SetPreferredArrow(w.IronArrow());
+            w.Press(Keys::kHotkey);
+            w.Run(600);
+            ASSERT_TRUE(BowState::IsUsingBow());
+        }
+
+    private:
+        std::vector<std::unique_ptr<RE::EffectSetting>> _mgefs;
+        std::vector<std::unique_ptr<RE::Effect>> _effects;
+        std::vector<std::unique_ptr<RE::SpellItem>> _spells;
+
+    protected:
+        RE::SpellItem* werewolf;
+        RE::SpellItem* vampireLord;
+        RE::SpellItem* greybeard;
+        RE::SpellItem* lesser;
+        World w;
+    };
+}
+
+TEST_F(TransformWatcherTest, OnlyTransformationPowersCount) {
+    auto* player = &w.Player();
+    EXPECT_FALSE(BowInput::TransformWatcher::IsCurrentTransformPower(player));
+
+    Select(werewolf);
+    EXPECT_TRUE(BowInput::TransformWatcher::IsCurrentTransformPower(player));
+    Select(vampireLord);
+    EXPECT_TRUE(BowInput::TransformWatcher::IsCurrentTransformPower(player));
+    Select(greybeard);
+    EXPECT_FALSE(BowInput::TransformWatcher::IsCurrentTransformPower(player));
+    Select(lesser);
+    EXPECT_FALSE(BowInput::TransformWatcher::IsCurrentTransformPower(player));
+
+    EXPECT_FALSE(BowInput::TransformWatcher::IsCurrentTransformPower(nullptr));
+}
+
+TEST_F(TransformWatcherTest, ShoutingATransformationEndsBowMode) {
+    EnterBowMode();
+    Select(werewolf);
+    w.Tap(Keys::kShout);
+    w.Run(100);
+    EXPECT_FALSE(BowState::IsUsingBow());
+}
+
+TEST_F(TransformWatcherTest, AnOrdinaryShoutKeepsBowMode) {
+    EnterBowMode();
+    Select(greybeard);
+    w.Tap(Keys::kShout);
+    w.Run(100);
+    EXPECT_TRUE(BowState::IsUsingBow());
+}
+
+TEST_F(TransformWatcherTest, PlayerRaceSwitchEndsBowMode) {
+    EnterBowMode();
+
+    RE::Actor npc{0x000A2C94, "Lydia"};
+    const RE::TESSwitchRaceCompleteEvent other{&npc};
+    RE::ScriptEventSourceHolder::GetSingleton()->SendEvent(&other);
+    EXPECT_TRUE(BowState::IsUsingBow());
+
+    const RE::TESSwitchRaceCompleteEvent self{&w.Player()};
+    RE::ScriptEventSourceHolder::GetSingleton()->SendEvent(&self);
+    EXPECT_FALSE(BowState::IsUsingBow());
+}
+
+// No transformation in the load order at all: the answer is a flag check, not a rescan.
+TEST(TransformWatcherEmpty, NoPowersMeansNoTransform) {
+    World w;
+    RE::SpellItem healing{0x00012FCC, "Healing", SpellType::kSpell};
+    w.Player().GetActorRuntimeData().selectedPower = &healing;
+    EXPECT_FALSE(BowInput::TransformWatcher::IsCurrentTransformPower(&w.Player()));
+}
@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+
+#include "AllocCounter.h"
+#include "BowState.h"
+
+namespace {
+    using namespace BowState::detail;
+
+    // The event side of one attack-hold frame: the pumped event is taken from the pool and handed back once the
+    // poll delivered it. The queue in between is BM_SyntheticQueue's business.
+    void PooledFrame(float held) {
+        auto* ev = MakeAttackButtonEvent(1.0f, held);
+        benchmark::DoNotOptimize(ev);
+        GetAttackEventPool().Release(ev);
+    }
+
+    // What the pump did before the pool: a fresh ButtonEvent and a user-event string copy per frame, freed by the
+    // engine once delivered.
+    void LegacyFrame(float held) {
+        const RE::BSFixedString userEvent{GetAttackUserEvent()};
+        auto* ev = RE::ButtonEvent::Create(RE::INPUT_DEVICE::kMouse, userEvent, kAttackMouseIdCode, 1.0f, held);
+        benchmark::DoNotOptimize(ev);
+        delete ev;  // NOSONAR
+    }
+
+    template <void (*Frame)(float)>
+    void RunHold(benchmark::State& state) {
+        Frame(0.0f);
+        float held = 0.0f;
+        const Headless::Allocs::Scope allocs;
+        for (auto _ : state) {
+            held += 0.016f;
+            Frame(held);
+        }
+        state.counters["allocs_per_frame"] =
+            static_cast<double>(allocs.Count()) / static_cast<double>(std::max<std::int64_t>(state.iterations(), 1));
+    }
+}
+
+static void BM_AttackEventPool_HoldFrame(benchmark::State& state) { RunHold<PooledFrame>(state); }
+BENCHMARK(BM_AttackEventPool_HoldFrame);
+
+static void BM_LegacyAttackEventPool_HoldFrame(benchmark::State& state) { RunHold<LegacyFrame>(state); }
+BENCHMARK(BM_LegacyAttackEventPool_HoldFrame);
+
+// A burst of in-flight events up to the synthetic input limit (64), beyond what the pool holds (16). Events past the
+// pool are one-off allocations.
+static void BM_AttackEventPool_Burst(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto exhausted0 = GetAttackEventPool().Stats().exhausted;
+    const Headless::Allocs::Scope allocs;
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < n; ++i) EnqueueSyntheticAttack(MakeAttackButtonEvent(1.0f, 0.0f));
+        benchmark::DoNotOptimize(FlushSyntheticInput(nullptr));
+        RecycleDeliveredSyntheticInput();
+    }
+    const auto bursts = static_cast<double>(std::max<std::int64_t>(state.iterations(), 1));
+    state.counters["allocs_per_burst"] = static_cast<double>(allocs.Count()) / bursts;
+    state.counters["exhausted_per_burst"] =
+        static_cast<double>(GetAttackEventPool().Stats().exhausted - exhausted0) / bursts;
+}
+BENCHMARK(BM_AttackEventPool_Burst)->Arg(4)->Arg(16)->Arg(64);
@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+
+#include "config/ConfigSnapshot.h"
+
+namespace {
+    // The fields a frame read before the snapshot: one relaxed atomic each, loaded independently.
+    struct LegacyConfig {
+        std::atomic<int> mode{0};
+        std::atomic<float> sheathedDelaySeconds{1.0f};
+        std::atomic_bool autoDrawEnabled{true};
+        std::atomic_bool cancelHoldExitDelayOnAttackPatch{false};
+        std::atomic_bool requireExclusiveHotkeyPatch{false};
+    };
+
+    LegacyConfig& Legacy() {
+        static LegacyConfig s;  // NOSONAR
+        return s;
+    }
+}
+
+// One frame's reads: pin the snapshot, read the handful of fields the input path uses.
+static void BM_ConfigSnapshot_FrameRead(benchmark::State& state) {
+    IntegratedBow::PublishConfig(IntegratedBow::ConfigSnapshot{});
+    for (auto _ : state) {
+        const IntegratedBow::ConfigRef cfg;
+        benchmark::DoNotOptimize(cfg->mode);
+        benchmark::DoNotOptimize(cfg->sheathedDelaySeconds);
+        benchmark::DoNotOptimize(cfg->autoDrawEnabled);
+        benchmark::DoNotOptimize(cfg->cancelHoldExitDelayOnAttackPatch);
+        benchmark::DoNotOptimize(cfg->requireExclusiveHotkeyPatch);
+    }
+}
+BENCHMARK(BM_ConfigSnapshot_FrameRead);
+
+// A callback inside the frame taking its own reference: the nested case is a thread-local counter.
+static void BM_ConfigSnapshot_NestedRead(benchmark::State& state) {
+    const IntegratedBow::ConfigRef outer;
+    for (auto _ : state) {
+        const IntegratedBow::ConfigRef cfg;
+        benchmark::DoNotOptimize(cfg->requireExclusiveHotkeyPatch);
+    }
+}
+BENCHMARK(BM_ConfigSnapshot_NestedRead);
+
+static void BM_LegacyConfigSnapshot_FrameRead(benchmark::State& state) {
+    auto& c = Legacy();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(c.mode.load(std::memory_order_relaxed));
+        benchmark::DoNotOptimize(c.sheathedDelaySeconds.load(std::memory_order_relaxed));
+        benchmark::DoNotOptimize(c.autoDrawEnabled.load(std::memory_order_relaxed));
+        benchmark::DoNotOptimize(c.cancelHoldExitDelayOnAttackPatch.load(std::memory_order_relaxed));
+        benchmark::DoNotOptimize(c.requireExclusiveHotkeyPatch.load(std::memory_order_relaxed));
+    }
+}
+BENCHMARK(BM_LegacyConfigSnapshot_FrameRead);
+
+// The menu's Apply: copy, swap, retire, reclaim.
+static void BM_ConfigSnapshot_Publish(benchmark::State& state) {
+    IntegratedBow::ConfigSnapshot snap{};
+    for (auto _ : state) {
+        snap.sheathedDelaySeconds += 1.0f;
+        IntegratedBow::PublishConfig(snap);
+    }
+}
+BENCHMARK(BM_ConfigSnapshot_Publish);
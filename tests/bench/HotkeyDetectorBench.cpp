@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+#include "bow_input/HotkeyDetector.h"
+
+namespace {
+    struct NullCallbacks final : BowInput::IHotkeyCallbacks {
+        void OnHotkeyAcceptedPressed(RE::PlayerCharacter*, bool) override {}
+        void OnHotkeyAcceptedReleased(RE::PlayerCharacter*, bool) override {}
+    };
+
+    // Recorded-style frames: `held` unrelated keys stay down the whole time while the LShift+V chord goes down for
+    // half of every 64-frame cycle, so Tick sees both edges and both answers.
+    void RunTick(benchmark::State& state, bool exclusive) {
+        using namespace BowInput;
+        const auto held = static_cast<int>(state.range(0));
+
+        RE::PlayerCharacter player;
+        HotkeyConfig hk{};
+        hk.bowKeyScanCodes = {0x2A, 0x2F, -1};
+        HotkeyDetector::CompileKeyboard(hk);
+        HotkeyRuntime rt{};
+        NullCallbacks cb;
+        auto inputs = std::make_unique<InputState>();
+        bool hotkeyDown = false;
+
+        for (int i = 0; i < held; ++i) {
+            const int code = 0x3B + i;  // F1 onwards: never part of the chord or the tolerated extras
+            inputs->OnButton(RE::INPUT_DEVICE::kKeyboard, code, true, true, false);
+        }
+
+        std::uint64_t frame = 0;
+        std::uint64_t nowMs = 0;
+        for (auto _ : state) {
+            const auto phase = frame++ & 63;
+            if (phase == 0 || phase == 32) {
+                const bool down = phase == 0;
+                for (const int code : {0x2A, 0x2F}) {
+                    inputs->OnButton(RE::INPUT_DEVICE::kKeyboard, code, down, down, !down);
+                }
+            }
+            nowMs += 16;
+            HotkeyDetector::Tick(&player, 0.016f, nowMs, hk, *inputs, exclusive, false, hotkeyDown, rt, cb);
+            benchmark::DoNotOptimize(hotkeyDown);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+}
+
+static void BM_HotkeyDetector_Tick(benchmark::State& state) { RunTick(state, false); }
+BENCHMARK(BM_HotkeyDetector_Tick)->DenseRange(0, 20, 5);
+
+static void BM_HotkeyDetector_TickExclusive(benchmark::State& state) { RunTick(state, true); }
+BENCHMARK(BM_HotkeyDetector_TickExclusive)->DenseRange(0, 20, 5);
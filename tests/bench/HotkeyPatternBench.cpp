@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bow_input/HotkeyPattern.h"
+
+namespace {
+    struct Edge {
+        RE::INPUT_DEVICE dev;
+        int code;
+        bool down;
+        std::uint64_t atMs;
+    };
+
+    // Random press/release sequences over the pattern's keys and a few others, as thousands of short bursts.
+    std::vector<Edge> MakeEdges(std::size_t count) {
+        const std::pair<RE::INPUT_DEVICE, int> keys[] = {
+            {RE::INPUT_DEVICE::kKeyboard, 0x2F}, {RE::INPUT_DEVICE::kKeyboard, 0x2A},
+            {RE::INPUT_DEVICE::kKeyboard, 0x12}, {RE::INPUT_DEVICE::kKeyboard, 0x11},
+            {RE::INPUT_DEVICE::kGamepad, 0x100}, {RE::INPUT_DEVICE::kGamepad, 0xA}};
+        std::mt19937 rng(7);
+        bool down[std::size(keys)]{};
+        std::uint64_t now = 0;
+
+        std::vector<Edge> out;
+        out.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto k = rng() % std::size(keys);
+            down[k] = !down[k];
+            now += rng() % 120;
+            out.push_back({keys[k].first, keys[k].second, down[k], now});
+        }
+        return out;
+    }
+
+    void RunPattern(benchmark::State& state, const char* text) {
+        using namespace BowInput;
+        HotkeyPattern p{};
+        std::string error;
+        if (!HotkeyPattern::Compile(text, p, error)) {
+            state.SkipWithError(error.c_str());
+            return;
+        }
+
+        const auto edges = MakeEdges(4096);
+        PatternRuntime rt{};
+        std::uint64_t base = 0;
+        std::uint64_t accepted = 0;
+        for (auto _ : state) {
+            for (auto const& e : edges) {
+                PatternEngine::OnButton(p, rt, e.dev, e.code, e.down, e.down, !e.down, base + e.atMs, false);
+                accepted += PatternEngine::Accepted(p, rt) ? 1 : 0;
+            }
+            base += edges.back().atMs + 1000;
+        }
+        benchmark::DoNotOptimize(accepted);
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * edges.size()));
+    }
+}
+
+static void BM_HotkeyPattern_Chord(benchmark::State& state) { RunPattern(state, "K:0x2A + K:0x2F"); }
+BENCHMARK(BM_HotkeyPattern_Chord);
+
+static void BM_HotkeyPattern_Sequence(benchmark::State& state) {
+    RunPattern(state, "G:0x100 > G:0xA | within=150 | exclusive");
+}
+BENCHMARK(BM_HotkeyPattern_Sequence);
+
+static void BM_HotkeyPattern_TapThenHold(benchmark::State& state) {
+    RunPattern(state, "tap K:0x2F > tap K:0x2F > K:0x2F | within=600");
+}
+BENCHMARK(BM_HotkeyPattern_TapThenHold);
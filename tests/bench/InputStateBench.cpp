@@ -0,0 +1,147 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "bow_input/InputState.h"
+
+#if defined(_MSC_VER)
+    #define BENCH_NOINLINE __declspec(noinline)
+#else
+    #define BENCH_NOINLINE __attribute__((noinline))
+#endif
+
+namespace {
+    // The representation InputState replaced: one atomic_bool per possible code and vector down-lists searched
+    // linearly. Kept here only as the baseline for the numbers below.
+    struct LegacyInputState {
+        std::array<std::atomic_bool, BowInput::kMaxCode> kbDown{};
+        std::array<std::atomic_bool, BowInput::kMaxCode> gpDown{};
+        std::vector<int> kbDownList;
+        std::vector<int> gpDownList;
+
+        LegacyInputState() {
+            kbDownList.reserve(32);
+            gpDownList.reserve(32);
+        }
+
+        static void Add(std::vector<int>& list, int code) {
+            if (std::ranges::find(list, code) == list.end()) list.push_back(code);
+        }
+
+        static void Remove(std::vector<int>& list, int code) {
+            if (auto it = std::ranges::find(list, code); it != list.end()) {
+                *it = list.back();
+                list.pop_back();
+            }
+        }
+
+        void Clear() {
+            for (auto& v : kbDown) v.store(false, std::memory_order_relaxed);
+            for (auto& v : gpDown) v.store(false, std::memory_order_relaxed);
+            kbDownList.clear();
+            gpDownList.clear();
+        }
+
+        // Out of line like the real one, which lives in its own translation unit.
+        BENCH_NOINLINE void OnButton(RE::INPUT_DEVICE dev, int code, bool isPressed, bool isDownEdge, bool isUpEdge) {
+            if (code < 0 || code >= BowInput::kMaxCode) return;
+            const auto idx = static_cast<std::size_t>(code);
+            if (dev == RE::INPUT_DEVICE::kKeyboard) {
+                kbDown[idx].store(isPressed, std::memory_order_relaxed);
+                if (isDownEdge) Add(kbDownList, code);
+                if (isUpEdge) Remove(kbDownList, code);
+            } else if (dev == RE::INPUT_DEVICE::kGamepad) {
+                gpDown[idx].store(isPressed, std::memory_order_relaxed);
+                if (isDownEdge) Add(gpDownList, code);
+                if (isUpEdge) Remove(gpDownList, code);
+            }
+        }
+    };
+
+    struct Event {
+        RE::INPUT_DEVICE dev;
+        int code;
+        bool pressed;
+        bool down;
+        bool up;
+    };
+
+    // What a frame stream looks like: a few keys (movement, the hotkey, a gamepad shoulder) going down, held for a
+    // while and released, with the holds reported every frame in between.
+    std::vector<Event> MakeStream(std::size_t keys) {
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<int> kb(1, 0xDF);
+        std::uniform_int_distribution<int> pad(0, 15);
+
+        std::vector<Event> codes;
+        for (std::size_t i = 0; i < keys; ++i) {
+            if (i % 4 == 3) {
+                codes.push_back({RE::INPUT_DEVICE::kGamepad, 1 << pad(rng), true, true, false});
+            } else {
+                codes.push_back({RE::INPUT_DEVICE::kKeyboard, kb(rng), true, true, false});
+            }
+        }
+
+        std::vector<Event> out;
+        for (auto const& c : codes) out.push_back(c);
+        for (int frame = 0; frame < 8; ++frame) {
+            for (auto c : codes) {
+                c.down = false;
+                out.push_back(c);
+            }
+        }
+        for (auto c : codes) {
+            c.pressed = false;
+            c.down = false;
+            c.up = true;
+            out.push_back(c);
+        }
+        return out;
+    }
+
+    template <class State>
+    void RunStream(benchmark::State& state, State& s) {
+        const auto stream = MakeStream(static_cast<std::size_t>(state.range(0)));
+        for (auto _ : state) {
+            for (auto const& e : stream) s.OnButton(e.dev, e.code, e.pressed, e.down, e.up);
+            benchmark::DoNotOptimize(s);
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * stream.size()));
+        state.counters["footprint_bytes"] = static_cast<double>(sizeof(State));
+    }
+}
+
+static void BM_InputState_OnButton(benchmark::State& state) {
+    auto s = std::make_unique<BowInput::InputState>();
+    RunStream(state, *s);
+}
+BENCHMARK(BM_InputState_OnButton)->Arg(2)->Arg(8)->Arg(24);
+
+static void BM_LegacyInputState_OnButton(benchmark::State& state) {
+    auto s = std::make_unique<LegacyInputState>();
+    RunStream(state, *s);
+}
+BENCHMARK(BM_LegacyInputState_OnButton)->Arg(2)->Arg(8)->Arg(24);
+
+static void BM_InputState_Clear(benchmark::State& state) {
+    auto s = std::make_unique<BowInput::InputState>();
+    for (auto _ : state) {
+        s->Clear();
+        benchmark::DoNotOptimize(*s);
+    }
+    state.counters["footprint_bytes"] = static_cast<double>(sizeof(BowInput::InputState));
+}
+BENCHMARK(BM_InputState_Clear);
+
+static void BM_LegacyInputState_Clear(benchmark::State& state) {
+    auto s = std::make_unique<LegacyInputState>();
+    for (auto _ : state) {
+        s->Clear();
+        benchmark::DoNotOptimize(*s);
+    }
+    state.counters["footprint_bytes"] = static_cast<double>(sizeof(LegacyInputState));
+}
+BENCHMARK(BM_LegacyInputState_Clear);
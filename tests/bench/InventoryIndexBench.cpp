@@ -0,0 +1,151 @@
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "InventoryIndex.h"
+#include "World.h"
+
+namespace {
+    // A hoarder's inventory: 10k distinct bases on top of the World loadout, a quarter of them singled out with their
+    // own extra list, plus a base container of misc clutter the index skips. One per benchmark run, since only one
+    // World may exist at a time; the forms outlive it.
+    struct Hoard {
+        static constexpr std::size_t kItems = 10'000;
+
+        std::vector<std::unique_ptr<RE::TESBoundObject>> forms;
+        Headless::World w;
+
+        Hoard() {
+            forms.reserve(kItems);
+            for (std::size_t i = 0; i < kItems; ++i) {
+                const auto id = 0x06000000 | static_cast<RE::FormID>(i + 1);
+                switch (i % 10) {
+                    case 0:
+                    case 1:
+                    case 2:
+                    case 3:
+                        forms.push_back(std::make_unique<RE::TESObjectARMO>(id, "Armor", 1u << (i % 32)));
+                        break;
+                    case 4:
+                    case 5:
+                    case 6:
+                        forms.push_back(std::make_unique<RE::TESObjectWEAP>(id, "Weapon"));
+                        break;
+                    case 7:
+                        forms.push_back(std::make_unique<RE::TESAmmo>(id, "Arrow"));
+                        break;
+                    default:
+                        forms.push_back(std::make_unique<RE::TESBoundObject>(id, RE::FormType::None, "Clutter"));
+                        break;
+                }
+                if (i % 10 >= 8) {
+                    w.GiveBase(forms.back().get(), 1);
+                } else {
+                    w.Give(forms.back().get(), 1, i % 4 == 0);
+                }
+            }
+        }
+    };
+
+    using LegacyInventory = std::map<RE::TESBoundObject*, std::pair<std::int32_t, std::unique_ptr<RE::InventoryEntryData>>>;
+
+    // What TESObjectREFR::GetInventory hands back: a fresh map with a copied entry (and extra-list list) per base.
+    // Each bow-mode transition used to build one of these several times over.
+    LegacyInventory LegacyGetInventory(RE::PlayerCharacter& player,
+                                       std::vector<std::unique_ptr<RE::BSSimpleList<RE::ExtraDataList*>>>& lists) {
+        LegacyInventory out;
+        lists.clear();
+        for (auto* data : *player.GetInventoryChanges()->entryList) {
+            auto& [count, entry] = out[data->object];
+            count += data->countDelta;
+            entry = std::make_unique<RE::InventoryEntryData>();
+            entry->object = data->object;
+            entry->countDelta = data->countDelta;
+            if (data->extraLists) {
+                entry->extraLists = lists.emplace_back(std::make_unique<RE::BSSimpleList<RE::ExtraDataList*>>(
+                                                           *data->extraLists))
+                                        .get();
+            }
+        }
+        player.GetContainer()->ForEachContainerObject([&out](RE::ContainerObject& obj) {
+            auto& [count, entry] = out[obj.obj];
+            count += obj.count;
+            if (!entry) {
+                entry = std::make_unique<RE::InventoryEntryData>();
+                entry->object = obj.obj;
+            }
+            return RE::BSContainer::ForEachResult::kContinue;
+        });
+        return out;
+    }
+}
+
+// A query between container changes: one hash lookup.
+static void BM_InventoryIndex_Find(benchmark::State& state) {
+    Hoard h;
+    benchmark::DoNotOptimize(BowState::Inventory::Find(h.w.Bow()));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(BowState::Inventory::Find(h.w.Bow()));
+        benchmark::DoNotOptimize(BowState::Inventory::Find(h.w.IronArrow()));
+    }
+}
+BENCHMARK(BM_InventoryIndex_Find);
+
+// The first query after a container change: one pass over the 10k entries.
+static void BM_InventoryIndex_Rebuild(benchmark::State& state) {
+    Hoard h;
+    for (auto _ : state) {
+        BowState::Inventory::Invalidate();
+        benchmark::DoNotOptimize(BowState::Inventory::Find(h.w.Bow()));
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * Hoard::kItems));
+}
+BENCHMARK(BM_InventoryIndex_Rebuild)->Unit(benchmark::kMicrosecond);
+
+// A bow-mode transition's worth of queries (chosen bow, its live extra twice, arrows, armor) after a pickup.
+static void BM_InventoryIndex_Transition(benchmark::State& state) {
+    Hoard h;
+    auto* bowExtra = h.w.ExtrasOf(h.w.Bow()).front();
+    for (auto _ : state) {
+        h.w.Give(h.w.IronArrow(), 1, false);
+        benchmark::DoNotOptimize(BowState::Inventory::Find(h.w.Bow()));
+        benchmark::DoNotOptimize(BowState::Inventory::IsLive(h.w.Bow(), bowExtra));
+        benchmark::DoNotOptimize(BowState::Inventory::IsLive(h.w.Bow(), bowExtra));
+        benchmark::DoNotOptimize(BowState::Inventory::Find(h.w.IronArrow()));
+        benchmark::DoNotOptimize(BowState::Inventory::Armor().size());
+        benchmark::DoNotOptimize(BowState::Inventory::Armor().size());
+    }
+}
+BENCHMARK(BM_InventoryIndex_Transition)->Unit(benchmark::kMicrosecond);
+
+// The same queries after picking up clutter the index does not hold: no rebuild.
+static void BM_InventoryIndex_ClutterTransition(benchmark::State& state) {
+    Hoard h;
+    auto* bowExtra = h.w.ExtrasOf(h.w.Bow()).front();
+    const RE::TESContainerChangedEvent pickup{0, h.w.Player().GetFormID(), h.forms[8]->GetFormID(), 1};
+    for (auto _ : state) {
+        RE::ScriptEventSourceHolder::GetSingleton()->SendEvent(&pickup);
+        benchmark::DoNotOptimize(BowState::Inventory::Find(h.w.Bow()));
+        benchmark::DoNotOptimize(BowState::Inventory::IsLive(h.w.Bow(), bowExtra));
+        benchmark::DoNotOptimize(BowState::Inventory::IsLive(h.w.Bow(), bowExtra));
+        benchmark::DoNotOptimize(BowState::Inventory::Find(h.w.IronArrow()));
+        benchmark::DoNotOptimize(BowState::Inventory::Armor().size());
+        benchmark::DoNotOptimize(BowState::Inventory::Armor().size());
+    }
+}
+BENCHMARK(BM_InventoryIndex_ClutterTransition)->Unit(benchmark::kMicrosecond);
+
+static void BM_LegacyInventoryIndex_Transition(benchmark::State& state) {
+    Hoard h;
+    std::vector<std::unique_ptr<RE::BSSimpleList<RE::ExtraDataList*>>> lists;
+    for (auto _ : state) {
+        h.w.Give(h.w.IronArrow(), 1, false);
+        for (int call = 0; call < 6; ++call) {
+            auto inv = LegacyGetInventory(h.w.Player(), lists);
+            benchmark::DoNotOptimize(inv.find(h.w.Bow()));
+        }
+    }
+}
+BENCHMARK(BM_LegacyInventoryIndex_Transition)->Unit(benchmark::kMicrosecond);
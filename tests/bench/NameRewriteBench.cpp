@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "AllocCounter.h"
+#include "BowState.h"
+#include "LegacyNameRewrite.h"
+
+namespace {
+    // Display names as they reach ApplyChosenTagToInstance: tempered, already chosen, or plain.
+    const std::vector<std::string>& Names() {
+        static const std::vector<std::string> s{  // NOSONAR
+            "Hunting Bow",
+            "Hunting Bow (Legendary) (chosen)",
+            "Daedric Bow of the Inferno (Epic)",
+            "Nordic Hero Bow (chosen)",
+            "Glass Bow of Debilitation (Fine) (chosen)",
+            "Bow of Shadows (Nightingale)",
+            "Лук охотника (Flawless)",
+            "Arco Élfico (chosen) (Superior)",
+            std::string(200, 'x') + " Bow (Exquisite) (chosen)",
+        };
+        return s;
+    }
+
+    void ReportAllocs(benchmark::State& state, const Headless::Allocs::Scope& allocs) {
+        const auto names = static_cast<double>(std::max<std::int64_t>(state.iterations(), 1)) *
+                           static_cast<double>(Names().size());
+        state.counters["allocs_per_name"] = static_cast<double>(allocs.Count()) / names;
+    }
+}
+
+static void BM_NameRewrite_BaseName(benchmark::State& state) {
+    using namespace BowState::detail;
+    std::array<char, 512> scratch;
+    const Headless::Allocs::Scope allocs;
+    for (auto _ : state) {
+        for (auto const& name : Names()) {
+            const auto cleaned = RemoveChosenTags(name, scratch);
+            benchmark::DoNotOptimize(cleaned.substr(0, BaseNameLength(cleaned)));
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * Names().size()));
+    ReportAllocs(state, allocs);
+}
+BENCHMARK(BM_NameRewrite_BaseName);
+
+static void BM_LegacyNameRewrite_BaseName(benchmark::State& state) {
+    const Headless::Allocs::Scope allocs;
+    for (auto _ : state) {
+        for (auto const& name : Names()) {
+            benchmark::DoNotOptimize(Headless::LegacyNames::BaseName(name));
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * Names().size()));
+    ReportAllocs(state, allocs);
+}
+BENCHMARK(BM_LegacyNameRewrite_BaseName);
@@ -0,0 +1,97 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include "AllocCounter.h"
+#include "SaveBowFiles.h"
+
+namespace SB = Headless::SaveBows;
+
+namespace {
+    constexpr std::size_t kEntries = 100'000;
+
+    // Keys looked up in the timed loops: existing saves in random order, one in eight a save never tracked.
+    const std::vector<std::string>& Probes() {
+        static const std::vector<std::string> probes = [] {  // NOSONAR
+            std::mt19937 rng(99);
+            std::uniform_int_distribution<std::size_t> pick(0, kEntries - 1);
+            std::vector<std::string> out;
+            for (std::size_t i = 0; i < 4096; ++i) {
+                out.push_back(SB::Key(i % 8 == 7 ? kEntries + i : pick(rng)));
+            }
+            return out;
+        }();
+        return probes;
+    }
+}
+
+// First kPostLoadGame: open the files and answer the loaded save's lookup, with their pages evicted first.
+static void BM_SaveBowIndex_ColdLoad(benchmark::State& state) {
+    SB::EnsureFilled(kEntries);
+    auto& db = IntegratedBow::SaveBowDB::Get();
+    const auto key = SB::Key(kEntries / 2);
+
+    std::uint64_t allocs = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        SB::Evict(IntegratedBow::SaveBowDB::IndexPath());
+        SB::Evict(IntegratedBow::SaveBowDB::JournalPath());
+        state.ResumeTiming();
+
+        const Headless::Allocs::Scope scope;
+        db.LoadFromDisk();
+        IntegratedBow::SaveBowPrefs p{};
+        benchmark::DoNotOptimize(db.TryGetNormalized(key, p));
+        allocs += scope.Count();
+    }
+    state.counters["allocs_per_load"] = static_cast<double>(allocs) / static_cast<double>(state.iterations());
+    state.counters["file_bytes"] = static_cast<double>(std::filesystem::file_size(IntegratedBow::SaveBowDB::IndexPath()));
+}
+BENCHMARK(BM_SaveBowIndex_ColdLoad)->Unit(benchmark::kMicrosecond);
+
+static void BM_LegacySaveBowIndex_ColdLoad(benchmark::State& state) {
+    SB::EnsureFilled(kEntries);
+    const auto path = IntegratedBow::SaveBowDB::JsonPath();
+    const auto key = SB::Key(kEntries / 2);
+
+    std::uint64_t allocs = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        SB::Evict(path);
+        state.ResumeTiming();
+
+        const Headless::Allocs::Scope scope;
+        const auto bySave = SB::LegacyLoad(path);
+        benchmark::DoNotOptimize(bySave.find(key));
+        allocs += scope.Count();
+    }
+    state.counters["allocs_per_load"] = static_cast<double>(allocs) / static_cast<double>(state.iterations());
+    state.counters["file_bytes"] = static_cast<double>(std::filesystem::file_size(path));
+}
+BENCHMARK(BM_LegacySaveBowIndex_ColdLoad)->Unit(benchmark::kMillisecond);
+
+static void BM_SaveBowIndex_Lookup(benchmark::State& state) {
+    SB::EnsureFilled(kEntries);
+    auto& db = IntegratedBow::SaveBowDB::Get();
+    const auto& probes = Probes();
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        IntegratedBow::SaveBowPrefs p{};
+        benchmark::DoNotOptimize(db.TryGetNormalized(probes[i++ & (probes.size() - 1)], p));
+    }
+}
+BENCHMARK(BM_SaveBowIndex_Lookup);
+
+static void BM_LegacySaveBowIndex_Lookup(benchmark::State& state) {
+    SB::EnsureFilled(kEntries);
+    const auto bySave = SB::LegacyLoad(IntegratedBow::SaveBowDB::JsonPath());
+    const auto& probes = Probes();
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bySave.find(probes[i++ & (probes.size() - 1)]));
+    }
+}
+BENCHMARK(BM_LegacySaveBowIndex_Lookup);
@@ -0,0 +1,48 @@
+#include <benchmark/benchmark.h>
+
+#include "SaveBowFiles.h"
+
+namespace SB = Headless::SaveBows;
+
+namespace {
+    void Report(benchmark::State& state, std::uint64_t bytes) {
+        state.counters["bytes_per_save"] = static_cast<double>(bytes) / static_cast<double>(state.iterations());
+        state.counters["tracked_saves"] = static_cast<double>(state.range(0));
+    }
+}
+
+// A quicksave with `range(0)` saves already tracked: one changed entry, then SaveToDisk. Written bytes are counted at
+// the syscall for the whole process, so the background compactions a long session triggers are in the figure too.
+static void BM_SaveBowJournal_Save(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    SB::Fill(n);
+    auto& db = IntegratedBow::SaveBowDB::Get();
+
+    const auto before = SB::BytesWritten();
+    std::size_t i = 0;
+    for (auto _ : state) {
+        db.Upsert(SB::Key(i % n), SB::Prefs(i + n));
+        db.SaveToDisk();
+        ++i;
+    }
+    db.WaitForCompaction();
+    Report(state, SB::BytesWritten() - before);
+}
+BENCHMARK(BM_SaveBowJournal_Save)->Arg(100)->Arg(1'000)->Arg(10'000);
+
+static void BM_LegacySaveBowJournal_Save(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    SB::LegacyMap bySave;
+    for (std::size_t i = 0; i < n; ++i) bySave.emplace(SB::Key(i), SB::Prefs(i));
+    const auto path = SB::Dir() / "SaveBows.legacy.json";
+
+    const auto before = SB::BytesWritten();
+    std::size_t i = 0;
+    for (auto _ : state) {
+        bySave[SB::Key(i % n)] = SB::Prefs(i + n);
+        SB::LegacySave(bySave, path);
+        ++i;
+    }
+    Report(state, SB::BytesWritten() - before);
+}
+BENCHMARK(BM_LegacySaveBowJournal_Save)->Arg(100)->Arg(1'000)->Arg(10'000);
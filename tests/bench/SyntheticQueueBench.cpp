@@ -0,0 +1,94 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <mutex>
+#include <queue>
+
+#include "bow_input/MpscRing.h"
+
+namespace {
+    // The synthetic-input queue as it was before MpscRing: every producer takes the mutex to push, and the poll hook
+    // swaps the whole std::queue out under it, so each burst allocates fresh deque blocks.
+    struct LegacyQueue {
+        std::mutex mutex;
+        std::queue<std::uintptr_t> pending;
+
+        bool TryPush(std::uintptr_t v) {
+            std::scoped_lock lk(mutex);
+            pending.push(v);
+            return true;
+        }
+
+        template <class F>
+        void Flush(F&& sink) {
+            std::queue<std::uintptr_t> local;
+            {
+                std::scoped_lock lk(mutex);
+                local.swap(pending);
+            }
+            while (!local.empty()) {
+                sink(local.front());
+                local.pop();
+            }
+        }
+    };
+
+    using Ring = BowInput::MpscRing<std::uintptr_t, 64>;
+
+    template <class F>
+    void Flush(Ring& ring, F&& sink) {
+        if (ring.EmptyRelaxed()) return;
+        std::uintptr_t v = 0;
+        while (ring.TryPop(v)) sink(v);
+    }
+}
+
+// A poll with nothing queued: what every frame pays when no synthetic input is pending.
+static void BM_SyntheticQueue_EmptyPoll(benchmark::State& state) {
+    Ring ring;
+    std::uintptr_t sum = 0;
+    for (auto _ : state) {
+        Flush(ring, [&](std::uintptr_t v) { sum += v; });
+        benchmark::ClobberMemory();
+    }
+    benchmark::DoNotOptimize(sum);
+}
+BENCHMARK(BM_SyntheticQueue_EmptyPoll);
+
+static void BM_LegacySyntheticQueue_EmptyPoll(benchmark::State& state) {
+    LegacyQueue q;
+    std::uintptr_t sum = 0;
+    for (auto _ : state) {
+        q.Flush([&](std::uintptr_t v) { sum += v; });
+        benchmark::ClobberMemory();
+    }
+    benchmark::DoNotOptimize(sum);
+}
+BENCHMARK(BM_LegacySyntheticQueue_EmptyPoll);
+
+// A frame of an attack hold: range(0) events pushed, then one poll drains them.
+static void BM_SyntheticQueue_Frame(benchmark::State& state) {
+    Ring ring;
+    const auto n = static_cast<std::uintptr_t>(state.range(0));
+    std::uintptr_t sum = 0;
+    for (auto _ : state) {
+        for (std::uintptr_t i = 0; i < n; ++i) ring.TryPush(i);
+        Flush(ring, [&](std::uintptr_t v) { sum += v; });
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * n));
+}
+BENCHMARK(BM_SyntheticQueue_Frame)->Arg(1)->Arg(4)->Arg(32);
+
+static void BM_LegacySyntheticQueue_Frame(benchmark::State& state) {
+    LegacyQueue q;
+    const auto n = static_cast<std::uintptr_t>(state.range(0));
+    std::uintptr_t sum = 0;
+    for (auto _ : state) {
+        for (std::uintptr_t i = 0; i < n; ++i) q.TryPush(i);
+        q.Flush([&](std::uintptr_t v) { sum += v; });
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * n));
+}
+BENCHMARK(BM_LegacySyntheticQueue_Frame)->Arg(1)->Arg(4)->Arg(32);
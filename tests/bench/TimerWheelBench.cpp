@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+
+#include "bow_input/TimerWheel.h"
+
+using BowInput::TimerWheel;
+
+namespace {
+    void Noop(std::uintptr_t ctx) { benchmark::DoNotOptimize(ctx); }
+
+    // Timers that stay armed for the whole run: spread over the upper levels, far past any clock the loop reaches.
+    void ArmIdle(TimerWheel& w, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            w.Arm(w.Now() + (std::uint64_t{1} << 40) + (i << 24), &Noop, i);
+        }
+    }
+
+    void Report(benchmark::State& state, std::size_t armed, std::size_t expiring) {
+        state.counters["armed"] = static_cast<double>(armed);
+        state.counters["expiring"] = static_cast<double>(expiring);
+    }
+}
+
+// One frame: `range(1)` timers come due and fire while `range(0)` others stay armed. The cost should follow the
+// second number only.
+static void BM_TimerWheel_Frame(benchmark::State& state) {
+    const auto idle = static_cast<std::size_t>(state.range(0));
+    const auto expiring = static_cast<std::size_t>(state.range(1));
+    TimerWheel w{0};
+    ArmIdle(w, idle);
+
+    for (auto _ : state) {
+        const std::uint64_t due = w.Now() + 1;
+        for (std::size_t i = 0; i < expiring; ++i) w.Arm(due, &Noop, i);
+        benchmark::DoNotOptimize(w.Advance(due));
+    }
+    Report(state, idle + expiring, expiring);
+}
+BENCHMARK(BM_TimerWheel_Frame)
+    ->Args({0, 1})
+    ->Args({16, 1})
+    ->Args({62, 1})
+    ->Args({0, 2})
+    ->Args({0, 8})
+    ->Args({0, 32});
+
+// An idle frame with armed timers only: what every frame pays for the wheel when nothing fires.
+static void BM_TimerWheel_IdleFrame(benchmark::State& state) {
+    const auto idle = static_cast<std::size_t>(state.range(0));
+    TimerWheel w{0};
+    ArmIdle(w, idle);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(w.Advance(w.Now() + 16));
+    }
+    Report(state, idle, 0);
+}
+BENCHMARK(BM_TimerWheel_IdleFrame)->Arg(1)->Arg(16)->Arg(63);
+
+// What the wheel replaced: each subsystem kept its own deadline field and every frame polled all of them.
+static void BM_LegacyTimerWheel_IdleFrame(benchmark::State& state) {
+    const auto fields = static_cast<std::size_t>(state.range(0));
+    std::array<std::uint64_t, 64> at{};
+    for (std::size_t i = 0; i < fields; ++i) at[i] = (std::uint64_t{1} << 40) + i;
+    std::uint64_t now = 0;
+
+    for (auto _ : state) {
+        now += 16;
+        for (std::size_t i = 0; i < fields; ++i) {
+            if (at[i] != 0 && now >= at[i]) {
+                at[i] = 0;
+                Noop(i);
+            }
+        }
+        benchmark::DoNotOptimize(at);
+    }
+    Report(state, fields, 0);
+}
+BENCHMARK(BM_LegacyTimerWheel_IdleFrame)->Arg(1)->Arg(16)->Arg(63);
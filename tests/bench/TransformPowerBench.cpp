@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "RE/Skyrim.h"
+#include "bow_input/TransformWatcher.h"
+
+namespace {
+    using RE::EffectArchetypes::ArchetypeID;
+    using RE::MagicSystem::SpellType;
+
+    // A big load order's worth of spells behind the stand-in data handler, none of them a transformation: the case
+    // where the old power cache stayed empty and every Shout press rescanned.
+    struct SpellWorld {
+        static constexpr std::size_t kSpells = 50'000;
+
+        RE::EffectSetting restore{0x05F00000, ArchetypeID::kValueModifier};
+        RE::Effect effect{&restore};
+        std::vector<std::unique_ptr<RE::SpellItem>> spells;
+        RE::Actor player{0x00000014, "Player"};
+
+        SpellWorld() {
+            spells.reserve(kSpells);
+            for (std::size_t i = 0; i < kSpells; ++i) {
+                const auto type = (i % 10 == 0) ? SpellType::kPower : SpellType::kSpell;
+                auto& s = spells.emplace_back(
+                    std::make_unique<RE::SpellItem>(0x05000000 | static_cast<RE::FormID>(i + 1), "Spell", type));
+                s->effects.push_back(&effect);
+            }
+            player.GetActorRuntimeData().selectedPower = spells[10].get();
+            BowInput::TransformWatcher::Initialize();
+        }
+    };
+
+    SpellWorld& Spells() {
+        static SpellWorld s;  // NOSONAR
+        return s;
+    }
+
+    bool HasTransformArchetype(const RE::MagicItem* item) {
+        return std::ranges::any_of(item->effects, [](const auto* e) {
+            if (!e || !e->baseEffect) return false;
+            const auto arch = e->baseEffect->GetArchetype();
+            return arch == ArchetypeID::kWerewolf || arch == ArchetypeID::kVampireLord;
+        });
+    }
+
+    // The check a Shout press made before the index: build the power list (cached only when non-empty), then test
+    // each power against the actor's selection.
+    bool LegacyIsCurrentTransformPower(RE::Actor* actor) {
+        static std::vector<RE::SpellItem*> s_powers;  // NOSONAR
+        if (s_powers.empty()) {
+            for (auto* spell : RE::TESDataHandler::GetSingleton()->GetFormArray<RE::SpellItem>()) {
+                if (spell->GetSpellType() != SpellType::kPower) continue;
+                if (HasTransformArchetype(spell)) s_powers.push_back(spell);
+            }
+        }
+        const auto* selected = actor->GetActorRuntimeData().selectedPower;
+        return std::ranges::find(s_powers, selected) != s_powers.end();
+    }
+}
+
+static void BM_TransformPower_ShoutPress(benchmark::State& state) {
+    auto& w = Spells();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(BowInput::TransformWatcher::IsCurrentTransformPower(&w.player));
+    }
+}
+BENCHMARK(BM_TransformPower_ShoutPress);
+
+static void BM_LegacyTransformPower_ShoutPress(benchmark::State& state) {
+    auto& w = Spells();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(LegacyIsCurrentTransformPower(&w.player));
+    }
+}
+BENCHMARK(BM_LegacyTransformPower_ShoutPress)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,58 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include "bow_input/InputGate.h"
+
+namespace {
+    using BowInput::UserEventKind;
+
+    // A mix close to play: mostly movement and camera, some attacks, the odd shout or draw.
+    const std::vector<RE::BSFixedString>& Events() {
+        static const std::vector<RE::BSFixedString> s = [] {  // NOSONAR
+            const char* pool[] = {
+                "Forward", "Forward", "Back", "Strafe Left", "Strafe Right", "Jump", "Sprint", "Activate",
+                "Right Attack/Block", "Left Attack Attack/Block", "Shout", "Ready Weapon",
+            };
+            std::mt19937 rng(3);
+            std::vector<RE::BSFixedString> out;
+            out.reserve(1'000'000);
+            for (int i = 0; i < 1'000'000; ++i) out.emplace_back(pool[rng() % std::size(pool)]);
+            return out;
+        }();
+        return s;
+    }
+
+    // The handler's tests before user events were interned: string compares in the order it made them.
+    UserEventKind LegacyClassify(std::string_view ue) noexcept {
+        using namespace std::literals;
+        if (ue == "Left Attack Attack/Block"sv || ue == "Right Attack/Block"sv) return UserEventKind::Attack;
+        if (ue == "Shout"sv) return UserEventKind::Shout;
+        if (ue == "Ready Weapon"sv) return UserEventKind::ReadyWeapon;
+        return UserEventKind::Other;
+    }
+}
+
+static void BM_UserEvent_Classify(benchmark::State& state) {
+    const auto& events = Events();
+    for (auto _ : state) {
+        unsigned sum = 0;
+        for (auto const& ue : events) sum += static_cast<unsigned>(BowInput::InputGate::ClassifyUserEvent(ue));
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * events.size()));
+}
+BENCHMARK(BM_UserEvent_Classify);
+
+static void BM_LegacyUserEvent_Classify(benchmark::State& state) {
+    const auto& events = Events();
+    for (auto _ : state) {
+        unsigned sum = 0;
+        for (auto const& ue : events) sum += static_cast<unsigned>(LegacyClassify(ue.c_str()));
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * events.size()));
+}
+BENCHMARK(BM_LegacyUserEvent_Classify);
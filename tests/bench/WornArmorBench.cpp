@@ -0,0 +1,116 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+#include "AllocCounter.h"
+#include "BowState.h"
+#include "World.h"
+
+namespace {
+    // A large modded armor collection: range(0) armors in the pack, each its own instance, with one piece worn in each
+    // of 24 slots (a few of them covering two).
+    struct Wardrobe {
+        std::vector<std::unique_ptr<RE::TESObjectARMO>> armors;
+        Headless::World w;
+
+        explicit Wardrobe(std::size_t count) {
+            armors.reserve(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                const auto slot = static_cast<std::uint32_t>(i % 24);
+                const std::uint32_t mask = (slot % 6 == 5) ? (3u << (slot - 1)) : (1u << slot);
+                armors.push_back(std::make_unique<RE::TESObjectARMO>(0x07000000 | static_cast<RE::FormID>(i + 1),
+                                                                     "Modded Armor", mask));
+                w.Give(armors.back().get());
+            }
+            for (std::size_t i = 0; i < 24 && i < count; ++i) {
+                w.Equip(armors[i].get(), w.ExtrasOf(armors[i].get()).front());
+            }
+        }
+    };
+
+    // What EnterBowMode did before biped slots: a vector of every worn armor list found by walking the inventory,
+    // taken before and after the equip, and a nested-loop diff. The walk here goes straight over the change entries,
+    // without the GetInventory map the original also built.
+    void LegacySnapshot(RE::PlayerCharacter& player, std::vector<BowState::ExtraEquippedItem>& out) {
+        out.clear();
+        for (auto* data : *player.GetInventoryChanges()->entryList) {
+            if (!data->object->As<RE::TESObjectARMO>() || !data->extraLists) continue;
+            for (auto* x : *data->extraLists) {
+                if (x->HasType(RE::ExtraDataType::kWorn) || x->HasType(RE::ExtraDataType::kWornLeft)) {
+                    out.push_back({data->object, x});
+                }
+            }
+        }
+    }
+
+    std::vector<BowState::ExtraEquippedItem> LegacyDiff(const std::vector<BowState::ExtraEquippedItem>& before,
+                                                        const std::vector<BowState::ExtraEquippedItem>& after) {
+        std::vector<BowState::ExtraEquippedItem> removed;
+        for (auto const& b : before) {
+            bool stillWorn = false;
+            for (auto const& a : after) {
+                if (a.base == b.base && a.extra == b.extra) {
+                    stillWorn = true;
+                    break;
+                }
+            }
+            if (!stillWorn) removed.push_back(b);
+        }
+        return removed;
+    }
+
+    void ReportAllocs(benchmark::State& state, const Headless::Allocs::Scope& allocs) {
+        state.counters["allocs_per_call"] =
+            static_cast<double>(allocs.Count()) / static_cast<double>(std::max<std::int64_t>(state.iterations(), 1));
+    }
+}
+
+// The snapshot EnterBowMode takes from the biped, then the displaced-armor check against it.
+static void BM_WornArmor_SnapshotAndDiff(benchmark::State& state) {
+    Wardrobe wr(static_cast<std::size_t>(state.range(0)));
+    BowState::EnterBowScan scan;
+    BowState::ScanForEnterBowMode(scan, wr.w.IronArrow(), {});
+    BowState::RecordDisplacedArmor(scan.worn);
+
+    const Headless::Allocs::Scope allocs;
+    for (auto _ : state) {
+        BowState::ScanForEnterBowMode(scan, wr.w.IronArrow(), {});
+        BowState::RecordDisplacedArmor(scan.worn);
+        benchmark::DoNotOptimize(BowState::GetPrevExtraEquipped().size());
+    }
+    ReportAllocs(state, allocs);
+}
+BENCHMARK(BM_WornArmor_SnapshotAndDiff)->Arg(100)->Arg(2000)->Unit(benchmark::kMicrosecond);
+
+// No loaded 3D: the snapshot falls back to the indexed armor and its slot masks.
+static void BM_WornArmor_SnapshotWithoutBiped(benchmark::State& state) {
+    Wardrobe wr(static_cast<std::size_t>(state.range(0)));
+    wr.w.DropBiped();
+    BowState::EnterBowScan scan;
+    BowState::ScanForEnterBowMode(scan, wr.w.IronArrow(), {});
+
+    const Headless::Allocs::Scope allocs;
+    for (auto _ : state) {
+        BowState::ScanForEnterBowMode(scan, wr.w.IronArrow(), {});
+        BowState::RecordDisplacedArmor(scan.worn);
+        benchmark::DoNotOptimize(BowState::GetPrevExtraEquipped().size());
+    }
+    ReportAllocs(state, allocs);
+}
+BENCHMARK(BM_WornArmor_SnapshotWithoutBiped)->Arg(100)->Arg(2000)->Unit(benchmark::kMicrosecond);
+
+static void BM_LegacyWornArmor_SnapshotAndDiff(benchmark::State& state) {
+    Wardrobe wr(static_cast<std::size_t>(state.range(0)));
+    std::vector<BowState::ExtraEquippedItem> before;
+    std::vector<BowState::ExtraEquippedItem> after;
+
+    const Headless::Allocs::Scope allocs;
+    for (auto _ : state) {
+        LegacySnapshot(wr.w.Player(), before);
+        LegacySnapshot(wr.w.Player(), after);
+        benchmark::DoNotOptimize(LegacyDiff(before, after));
+    }
+    ReportAllocs(state, allocs);
+}
+BENCHMARK(BM_LegacyWornArmor_SnapshotAndDiff)->Arg(100)->Arg(2000)->Unit(benchmark::kMicrosecond);
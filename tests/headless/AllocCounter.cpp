@@ -0,0 +1,74 @@
+#include "AllocCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    thread_local std::uint64_t t_allocs = 0;  // NOSONAR
+    std::atomic<std::uint64_t> g_allocs{0};   // NOSONAR
+
+    void* Allocate(std::size_t size) {
+        ++t_allocs;
+        g_allocs.fetch_add(1, std::memory_order_relaxed);
+        if (void* p = std::malloc(size ? size : 1)) return p;
+        throw std::bad_alloc{};
+    }
+
+    void* AllocateAligned(std::size_t size, std::align_val_t align) {
+        ++t_allocs;
+        g_allocs.fetch_add(1, std::memory_order_relaxed);
+        const auto a = static_cast<std::size_t>(align);
+        const std::size_t rounded = (size + a - 1) / a * a;
+#ifdef _WIN32
+        if (void* p = _aligned_malloc(rounded ? rounded : a, a)) return p;
+#else
+        if (void* p = std::aligned_alloc(a, rounded ? rounded : a)) return p;
+#endif
+        throw std::bad_alloc{};
+    }
+
+    void FreeAligned(void* p) noexcept {
+#ifdef _WIN32
+        _aligned_free(p);
+#else
+        std::free(p);
+#endif
+    }
+}
+
+namespace Headless::Allocs {
+    std::uint64_t ThisThread() noexcept { return t_allocs; }
+    std::uint64_t Total() noexcept { return g_allocs.load(std::memory_order_relaxed); }
+}
+
+// NOSONAR - replacing the global allocation functions is the point of this file.
+void* operator new(std::size_t size) { return Allocate(size); }
+void* operator new[](std::size_t size) { return Allocate(size); }
+void* operator new(std::size_t size, std::align_val_t align) { return AllocateAligned(size, align); }
+void* operator new[](std::size_t size, std::align_val_t align) { return AllocateAligned(size, align); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return Allocate(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return Allocate(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { FreeAligned(p); }
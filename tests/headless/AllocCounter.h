@@ -0,0 +1,21 @@
+#pragma once
+#include <cstdint>
+
+// Counts every global operator new in the process. Linked into the headless executables only; the counters cost one
+// thread-local increment per allocation.
+namespace Headless::Allocs {
+    // Allocations made by the calling thread since it started.
+    [[nodiscard]] std::uint64_t ThisThread() noexcept;
+    // Allocations made by every thread.
+    [[nodiscard]] std::uint64_t Total() noexcept;
+
+    // Allocations on this thread between construction and Count().
+    class Scope {
+    public:
+        Scope() noexcept : _start(ThisThread()) {}
+        [[nodiscard]] std::uint64_t Count() const noexcept { return ThisThread() - _start; }
+
+    private:
+        std::uint64_t _start;
+    };
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cctype>
+#include <string>
+#include <string_view>
+
+#include "BowState.h"
+
+// The heap-string name rewriting that BaseNameLength / RemoveChosenTags replaced, as it was. The tests use it as the
+// oracle for the single-pass helpers and the benchmark as their baseline.
+namespace Headless::LegacyNames {
+    inline bool IsTemperingTag(std::string_view inside) {
+        for (auto q : BowState::detail::kQualityTags) {
+            if (inside.size() != q.size()) continue;
+
+            bool match = true;
+            for (std::size_t i = 0; i < q.size(); ++i) {
+                const auto c = static_cast<char>(std::tolower(static_cast<unsigned char>(inside[i])));
+                if (c != q[i]) {
+                    match = false;
+                    break;
+                }
+            }
+            if (match) return true;
+        }
+        return false;
+    }
+
+    inline void TrimTrailingSpaces(std::string& s) {
+        while (!s.empty() && s.back() == ' ') s.pop_back();
+    }
+
+    inline void RemoveChosenTagInplace(std::string& s) {
+        constexpr std::string_view chosenTag{" (chosen)"};
+        for (auto pos = s.find(chosenTag); pos != std::string::npos; pos = s.find(chosenTag)) {
+            s.erase(pos, chosenTag.size());
+        }
+        TrimTrailingSpaces(s);
+    }
+
+    inline void StripTemperingSuffixes(std::string& name) {
+        TrimTrailingSpaces(name);
+        for (;;) {
+            if (name.size() < 3 || name.back() != ')') break;
+
+            const auto open = name.rfind('(');
+            if (open == std::string::npos || open == 0 || name[open - 1] != ' ') break;
+            if (!IsTemperingTag(std::string_view(name.data() + open + 1, name.size() - open - 2))) break;
+
+            name.erase(open - 1);
+            TrimTrailingSpaces(name);
+        }
+    }
+
+    // The name ApplyChosenTagToInstance put " (chosen)" after.
+    inline std::string BaseName(std::string_view displayName) {
+        std::string s{displayName};
+        RemoveChosenTagInplace(s);
+        StripTemperingSuffixes(s);
+        return s;
+    }
+}
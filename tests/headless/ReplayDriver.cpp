@@ -0,0 +1,204 @@
+// Replays an input trace recorded by InputTrace (in game, or by IntegratedBowSim --trace) through the input handler,
+// HotkeyDetector and the mode controller against the World stand-in, and reports the bow-mode transitions it
+// produced and what a frame cost. The same trace and build give the same transitions, so a timing change can be
+// judged by diffing two runs.
+//
+//   IntegratedBowReplay <trace> [--mode hold|press|smart] [--verbose]
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "AllocCounter.h"
+#include "BowState.h"
+#include "World.h"
+#include "bow_input/BowInputHandler.h"
+#include "bow_input/InputTrace.h"
+
+namespace {
+    namespace Trace = BowInput::InputTrace;
+
+    struct Options {
+        const char* path{nullptr};
+        int mode{0};
+        bool verbose{false};
+    };
+
+    bool ParseArgs(int argc, char** argv, Options& out) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view arg{argv[i]};
+            if (arg == "--mode" && i + 1 < argc) {
+                const std::string_view m{argv[++i]};
+                if (m == "hold") {
+                    out.mode = 0;
+                } else if (m == "press") {
+                    out.mode = 1;
+                } else if (m == "smart") {
+                    out.mode = 2;
+                } else {
+                    return false;
+                }
+            } else if (arg == "--verbose") {
+                out.verbose = true;
+            } else if (!out.path && !arg.starts_with("--")) {
+                out.path = argv[i];
+            } else {
+                return false;
+            }
+        }
+        return out.path != nullptr;
+    }
+
+    struct Frame {
+        std::uint64_t us{0};
+        std::size_t first{0};
+        std::size_t count{0};
+    };
+
+    // Frames in recording order, each with its slice of `events`. Records from before the first surviving frame
+    // marker (the ring wrapped) and the plugin's own synthetic input are dropped.
+    struct Loaded {
+        std::vector<Frame> frames;
+        std::vector<RE::ButtonEvent> events;
+        std::uint64_t skipped{0};
+    };
+
+    bool Load(const char* path, Loaded& out) {
+        std::ifstream in(path, std::ios::binary);
+        Trace::Header h{};
+        if (!in.read(reinterpret_cast<char*>(&h), sizeof(h))) {  // NOSONAR - layout do arquivo
+            std::fprintf(stderr, "%s: cannot read header\n", path);
+            return false;
+        }
+        if (std::memcmp(h.magic, Trace::kMagic, sizeof(h.magic)) != 0 || h.version != Trace::kVersion ||
+            h.recordSize != sizeof(Trace::Record) || h.capacity == 0 || h.userEventCount > Trace::kMaxUserEvents) {
+            std::fprintf(stderr, "%s: not an input trace (version %u)\n", path, Trace::kVersion);
+            return false;
+        }
+
+        std::vector<char> names(std::size_t{Trace::kMaxUserEvents} * Trace::kUserEventNameLen);
+        std::vector<Trace::Record> ring(h.capacity);
+        if (!in.read(names.data(), static_cast<std::streamsize>(names.size())) ||
+            !in.read(reinterpret_cast<char*>(ring.data()),  // NOSONAR
+                     static_cast<std::streamsize>(ring.size() * sizeof(Trace::Record)))) {
+            std::fprintf(stderr, "%s: truncated\n", path);
+            return false;
+        }
+
+        std::vector<RE::BSFixedString> userEvents;
+        for (std::uint32_t i = 0; i < h.userEventCount; ++i) {
+            const char* name = names.data() + std::size_t{i} * Trace::kUserEventNameLen;
+            userEvents.emplace_back(std::string_view{name, ::strnlen(name, Trace::kUserEventNameLen)});
+        }
+        const RE::BSFixedString none{""};
+
+        const std::uint64_t live = std::min<std::uint64_t>(h.written, h.capacity);
+        for (std::uint64_t i = h.written - live; i < h.written; ++i) {
+            auto const& r = ring[i % h.capacity];
+            if (r.flags & Trace::kFrame) {
+                const auto us = static_cast<std::uint64_t>(static_cast<double>(r.dt) * 1'000'000.0 + 0.5);
+                out.frames.push_back(Frame{us, out.events.size(), 0});
+                continue;
+            }
+            if (out.frames.empty() || (r.flags & Trace::kSynthetic)) {
+                ++out.skipped;
+                continue;
+            }
+
+            auto& ev = out.events.emplace_back();
+            ev.device = static_cast<RE::INPUT_DEVICE>(r.device);
+            ev.eventType = RE::INPUT_EVENT_TYPE::kButton;
+            ev.idCode = r.idCode;
+            ev.userEvent = r.userEvent < userEvents.size() ? userEvents[r.userEvent] : none;
+            ev.value = (r.flags & Trace::kPressed) ? 1.0f : 0.0f;
+            ev.heldDownSecs = r.heldDownSecs;
+            ++out.frames.back().count;
+        }
+        return !out.frames.empty();
+    }
+
+    // FNV-1a over (frame, entered) pairs: one number to compare two replays by.
+    struct Transitions {
+        std::uint64_t entries{0};
+        std::uint64_t exits{0};
+        std::uint64_t digest{0xcbf29ce484222325ull};
+        bool wasUsing{false};
+
+        void Sample(std::uint64_t frame, bool verbose) {
+            const bool using_ = BowState::IsUsingBow();
+            if (using_ == wasUsing) return;
+            wasUsing = using_;
+            using_ ? ++entries : ++exits;
+
+            for (auto v : {frame, std::uint64_t{using_}}) {
+                digest = (digest ^ v) * 0x100000001b3ull;
+            }
+            if (verbose) {
+                std::printf("frame %-10llu %s\n", static_cast<unsigned long long>(frame), using_ ? "enter" : "exit");
+            }
+        }
+    };
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        std::fprintf(stderr, "usage: %s <trace> [--mode hold|press|smart] [--verbose]\n", argv[0]);
+        return 2;
+    }
+    spdlog::set_level(spdlog::level::warn);
+
+    Loaded trace;
+    if (!Load(opt.path, trace)) {
+        return 2;
+    }
+
+    // The same starting point as IntegratedBowSim, so a trace it recorded replays to the same transitions.
+    Headless::World world;
+    BowInput::SetMode(opt.mode);
+    BowState::SetChosenBow(world.Bow(), world.ExtrasOf(world.Bow()).front());
+    BowState::SetPreferredArrow(world.IronArrow());
+
+    const auto& fc = BowInput::GetFrameCounters();
+    const auto fast0 = fc.fastPath.load();
+    const auto full0 = fc.fullPath.load();
+    Transitions tr;
+
+    const Headless::Allocs::Scope allocs;
+    std::chrono::steady_clock::duration spent{};
+    for (std::size_t i = 0; i < trace.frames.size(); ++i) {
+        auto const& f = trace.frames[i];
+        const std::span<const RE::ButtonEvent> events{trace.events.data() + f.first, f.count};
+
+        const auto t0 = std::chrono::steady_clock::now();
+        world.StepRecorded(f.us, events);
+        spent += std::chrono::steady_clock::now() - t0;
+
+        tr.Sample(i, opt.verbose);
+    }
+    const auto allocCount = allocs.Count();
+
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(spent).count();
+    const auto frames = static_cast<double>(trace.frames.size());
+
+    std::printf("frames          %zu\n", trace.frames.size());
+    std::printf("events          %zu (%llu skipped)\n", trace.events.size(),
+                static_cast<unsigned long long>(trace.skipped));
+    std::printf("ns/frame        %.1f\n", static_cast<double>(ns) / frames);
+    std::printf("allocs/frame    %.4f (%llu total)\n", static_cast<double>(allocCount) / frames,
+                static_cast<unsigned long long>(allocCount));
+    std::printf("entries         %llu\n", static_cast<unsigned long long>(tr.entries));
+    std::printf("exits           %llu\n", static_cast<unsigned long long>(tr.exits));
+    std::printf("transitions     %016llx\n", static_cast<unsigned long long>(tr.digest));
+    std::printf("equips          %llu\n", static_cast<unsigned long long>(world.Counters().equips));
+    std::printf("unequips        %llu\n", static_cast<unsigned long long>(world.Counters().unequips));
+    std::printf("fast path       %llu\n", static_cast<unsigned long long>(fc.fastPath.load() - fast0));
+    std::printf("full path       %llu\n", static_cast<unsigned long long>(fc.fullPath.load() - full0));
+    return 0;
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <nlohmann/json.hpp>
+
+#include "config/SaveBowDB.h"
+
+// Scratch files for the SaveBowDB benchmarks: a private data directory, save keys shaped like the game's, and the
+// whole-file JSON persistence the journal and the index replaced.
+namespace Headless::SaveBows {
+    using IntegratedBow::SaveBowDB;
+    using IntegratedBow::SaveBowPrefs;
+
+    // Set before the first SaveBowDB path is asked for; if something asked earlier, whatever it cached is used. A
+    // scratch directory this made is removed at exit.
+    inline const std::filesystem::path& Dir() {
+        struct Scratch {
+            std::filesystem::path made;
+            std::filesystem::path dir;
+
+            Scratch() {
+                made = std::filesystem::temp_directory_path() / ("IntegratedBow-" + std::to_string(::getpid()));
+                std::filesystem::create_directories(made);
+                ::setenv("INTEGRATEDBOW_DATA_DIR", made.c_str(), 0);
+                dir = SaveBowDB::JournalPath().parent_path();
+            }
+
+            ~Scratch() {
+                std::error_code ec;
+                std::filesystem::remove_all(made, ec);
+            }
+        };
+        static const Scratch scratch;  // NOSONAR
+        return scratch.dir;
+    }
+
+    // A normalized save path; every key is distinct and about as long as a real one.
+    inline std::string Key(std::size_t i) {
+        return SaveBowDB::NormalizeKey("C:/Users/Player/Documents/My Games/Skyrim Special Edition/Saves/Save" +
+                                       std::to_string(i) + "_0A1B2C3D_0_4C796469610000_Tamriel_000042_12_1.ess");
+    }
+
+    inline SaveBowPrefs Prefs(std::size_t i) {
+        const auto v = static_cast<std::uint32_t>(i);
+        return {0x00012EB7u + (v % 7), 0x0001397Du + (v % 5), v};
+    }
+
+    inline void RemoveFiles() {
+        std::error_code ec;
+        for (const auto& p : {SaveBowDB::JsonPath(), SaveBowDB::JournalPath(), SaveBowDB::IndexPath()}) {
+            std::filesystem::remove(p, ec);
+            std::filesystem::remove(std::filesystem::path{p} += ".tmp", ec);
+        }
+    }
+
+    // Starts from empty files, saves `n` entries and waits for the compaction that writes the index and the export.
+    inline void Fill(std::size_t n) {
+        auto& db = SaveBowDB::Get();
+        (void)Dir();
+        db.WaitForCompaction();
+        RemoveFiles();
+        db.LoadFromDisk();
+        for (std::size_t i = 0; i < n; ++i) db.Upsert(Key(i), Prefs(i));
+        db.SaveToDisk();
+        db.WaitForCompaction();
+    }
+
+    // Fill(n) unless the files on disk already hold exactly keys 0..n-1.
+    inline void EnsureFilled(std::size_t n) {
+        auto& db = SaveBowDB::Get();
+        (void)Dir();
+        db.WaitForCompaction();
+        db.LoadFromDisk();
+        db.WaitForCompaction();
+        SaveBowPrefs p{};
+        if (n == 0 || !db.TryGetNormalized(Key(n - 1), p) || db.TryGetNormalized(Key(n), p) ||
+            !std::filesystem::exists(SaveBowDB::IndexPath())) {
+            Fill(n);
+        }
+    }
+
+    // Drops the file's clean pages from the page cache, so the next read of it goes to the disk.
+    inline void Evict(const std::filesystem::path& p) {
+        const int fd = ::open(p.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return;
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        ::close(fd);
+    }
+
+    // Bytes this process has handed to write(2) so far, every thread included (Linux /proc accounting).
+    inline std::uint64_t BytesWritten() {
+        std::ifstream io("/proc/self/io");
+        std::string field;
+        std::uint64_t value = 0;
+        while (io >> field >> value) {
+            if (field == "wchar:") return value;
+        }
+        return 0;
+    }
+
+    using LegacyMap = std::unordered_map<std::string, SaveBowPrefs>;
+
+    // The old SaveToDisk: the whole map as pretty-printed JSON, rewritten on every save.
+    inline void LegacySave(const LegacyMap& bySave, const std::filesystem::path& path) {
+        nlohmann::json saves = nlohmann::json::object();
+        for (auto const& [k, v] : bySave) {
+            saves[k] = nlohmann::json{{"bow", v.bow}, {"arrow", v.arrow}, {"bowUid", v.bowUid}};
+        }
+        nlohmann::json j;
+        j["version"] = 2;
+        j["saves"] = std::move(saves);
+
+        std::ofstream f(path, std::ios::trunc);
+        f << j.dump(2);
+    }
+
+    // The old EnsureSaveBowDBLoaded: parse all of SaveBows.json into a node map.
+    inline LegacyMap LegacyLoad(const std::filesystem::path& path) {
+        LegacyMap out;
+        std::ifstream f(path);
+        nlohmann::json j;
+        f >> j;
+        for (auto it = j["saves"].begin(); it != j["saves"].end(); ++it) {
+            const auto& v = it.value();
+            out.emplace(SaveBowDB::NormalizeKey(it.key()),
+                        SaveBowPrefs{v.value("bow", 0u), v.value("arrow", 0u), v.value("bowUid", 0u)});
+        }
+        return out;
+    }
+}
@@ -0,0 +1,198 @@
+// Drives the input handler, the mode controller and the equip path through scripted hotkey use against the World
+// stand-in, and reports what a frame costs: wall time and heap allocations on the input thread.
+//
+//   IntegratedBowSim [--frames N] [--mode hold|press|smart] [--trace FILE]
+//
+// --trace records every frame, warm-up included, for IntegratedBowReplay.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string_view>
+
+#include <spdlog/spdlog.h>
+
+#include "AllocCounter.h"
+#include "BowState.h"
+#include "World.h"
+#include "bow_input/BowInputHandler.h"
+#include "bow_input/InputTrace.h"
+
+namespace {
+    struct Options {
+        std::uint64_t frames{2'000'000};
+        int mode{0};
+        const char* trace{nullptr};
+    };
+
+    bool ParseArgs(int argc, char** argv, Options& out) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view arg{argv[i]};
+            if (arg == "--frames" && i + 1 < argc) {
+                out.frames = std::strtoull(argv[++i], nullptr, 10);
+            } else if (arg == "--mode" && i + 1 < argc) {
+                const std::string_view m{argv[++i]};
+                if (m == "hold") {
+                    out.mode = 0;
+                } else if (m == "press") {
+                    out.mode = 1;
+                } else if (m == "smart") {
+                    out.mode = 2;
+                } else {
+                    return false;
+                }
+            } else if (arg == "--trace" && i + 1 < argc) {
+                out.trace = argv[++i];
+            } else {
+                return false;
+            }
+        }
+        return out.frames > 0;
+    }
+
+    struct Transitions {
+        std::uint64_t entries{0};
+        std::uint64_t exits{0};
+        bool wasUsing{false};
+
+        void Sample() {
+            const bool using_ = BowState::IsUsingBow();
+            if (using_ && !wasUsing) ++entries;
+            if (!using_ && wasUsing) ++exits;
+            wasUsing = using_;
+        }
+    };
+
+    // One scripted stretch of play. Each step is one input frame; the script loops until the frame budget is spent.
+    class Script {
+    public:
+        Script(Headless::World& world, int mode) : _w(world), _mode(mode) {}
+
+        void Frame() {
+            const auto t = _tick++ % kCycleFrames;
+            Act(t);
+            _w.Step(kFrameMs);
+        }
+
+    private:
+        static constexpr std::uint64_t kFrameMs = 16;
+        static constexpr std::uint64_t kCycleFrames = 400;  // 6.4 s of play
+
+        void Act(std::uint64_t t) {
+            using namespace Headless::Keys;
+
+            // Background traffic: the player walks for most of the cycle.
+            if (t == 0) _w.Press(kForward);
+            if (t == 300) _w.Release(kForward);
+
+            switch (_mode) {
+                case 0:  // hold: keep the hotkey down, shoot once, let go
+                    if (t == 10) _w.Press(kHotkey);
+                    if (t == 60) _w.Press(kAttack);
+                    if (t == 100) _w.Release(kAttack);
+                    if (t == 130) _w.Release(kHotkey);
+                    break;
+                case 1:  // press: tap in, shoot, tap out
+                    if (t == 10) _w.Press(kHotkey);
+                    if (t == 14) _w.Release(kHotkey);
+                    if (t == 60) _w.Press(kAttack);
+                    if (t == 100) _w.Release(kAttack);
+                    if (t == 150) _w.Press(kHotkey);
+                    if (t == 154) _w.Release(kHotkey);
+                    break;
+                default:  // smart: a tap one cycle, a hold the next
+                    if (((_tick / kCycleFrames) & 1) == 0) {
+                        if (t == 10) _w.Press(kHotkey);
+                        if (t == 14) _w.Release(kHotkey);
+                        if (t == 150) _w.Press(kHotkey);
+                        if (t == 154) _w.Release(kHotkey);
+                    } else {
+                        if (t == 10) _w.Press(kHotkey);
+                        if (t == 130) _w.Release(kHotkey);
+                    }
+                    if (t == 60) _w.Press(kAttack);
+                    if (t == 100) _w.Release(kAttack);
+                    break;
+            }
+
+            // A menu opened and closed while idle, then the player draws and sheathes their own weapon.
+            if (t == 250) _w.SetMenuOpen("InventoryMenu", true);
+            if (t == 270) _w.SetMenuOpen("InventoryMenu", false);
+            if (t == 320) _w.Press(kReadyWeapon);
+            if (t == 322) _w.Release(kReadyWeapon);
+        }
+
+        Headless::World& _w;
+        int _mode;
+        std::uint64_t _tick{0};
+    };
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        std::fprintf(stderr, "usage: %s [--frames N] [--mode hold|press|smart] [--trace FILE]\n", argv[0]);
+        return 2;
+    }
+    spdlog::set_level(spdlog::level::warn);
+
+    Headless::World world;
+    BowInput::SetMode(opt.mode);
+    BowState::SetChosenBow(world.Bow(), world.ExtrasOf(world.Bow()).front());
+    BowState::SetPreferredArrow(world.IronArrow());
+
+    // A frame marker plus at most a few held keys per frame.
+    constexpr std::uint64_t kRecordsPerFrame = 4;
+    const auto records = std::min<std::uint64_t>((opt.frames + 2000) * kRecordsPerFrame,
+                                                  std::numeric_limits<std::uint32_t>::max());
+    if (opt.trace && !BowInput::InputTrace::Open(opt.trace, static_cast<std::uint32_t>(records))) {
+        return 2;
+    }
+
+    Script script(world, opt.mode);
+    Transitions tr;
+
+    // Warm-up: first-use allocations (pools, index, interned strings) are not what a frame costs.
+    for (int i = 0; i < 2000; ++i) {
+        script.Frame();
+        tr.Sample();
+    }
+    const auto warmEntries = tr.entries;
+    const auto warmExits = tr.exits;
+    const auto& fc = BowInput::GetFrameCounters();
+    const auto fast0 = fc.fastPath.load();
+    const auto full0 = fc.fullPath.load();
+    const auto equips0 = world.Counters().equips;
+    const auto unequips0 = world.Counters().unequips;
+
+    const Headless::Allocs::Scope allocs;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (std::uint64_t i = 0; i < opt.frames; ++i) {
+        script.Frame();
+        tr.Sample();
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    const auto allocCount = allocs.Count();
+    BowInput::InputTrace::Close();
+
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+    const auto frames = static_cast<double>(opt.frames);
+    static constexpr const char* kModes[] = {"hold", "press", "smart"};
+
+    std::printf("mode            %s\n", kModes[opt.mode]);
+    std::printf("frames          %llu\n", static_cast<unsigned long long>(opt.frames));
+    std::printf("ns/frame        %.1f\n", static_cast<double>(ns) / frames);
+    std::printf("allocs/frame    %.4f (%llu total)\n", static_cast<double>(allocCount) / frames,
+                static_cast<unsigned long long>(allocCount));
+    std::printf("entries         %llu\n", static_cast<unsigned long long>(tr.entries - warmEntries));
+    std::printf("exits           %llu\n", static_cast<unsigned long long>(tr.exits - warmExits));
+    std::printf("equips          %llu\n", static_cast<unsigned long long>(world.Counters().equips - equips0));
+    std::printf("unequips        %llu\n", static_cast<unsigned long long>(world.Counters().unequips - unequips0));
+    std::printf("fast path       %llu\n", static_cast<unsigned long long>(fc.fastPath.load() - fast0));
+    std::printf("full path       %llu\n", static_cast<unsigned long long>(fc.fullPath.load() - full0));
+
+    // A script that never gets into bow mode measured nothing worth reporting.
+    return tr.entries > warmEntries && tr.exits > warmExits ? 0 : 1;
+}
@@ -0,0 +1,153 @@
+#include <mutex>
+#include <unordered_set>
+
+#include "RE/Skyrim.h"
+
+namespace RE {
+    namespace {
+        struct StringPool {
+            struct Hash {
+                using is_transparent = void;
+                std::size_t operator()(std::string_view s) const noexcept { return std::hash<std::string_view>{}(s); }
+            };
+
+            std::mutex mtx;
+            std::unordered_set<std::string, Hash, std::equal_to<>> strings;
+        };
+
+        StringPool& Pool() {
+            static StringPool s;  // NOSONAR
+            return s;
+        }
+    }
+
+    // Nodes of an unordered_set never move, so the pointer handed out stays valid for the process.
+    const char* BSFixedString::Intern(std::string_view s) {
+        auto& pool = Pool();
+        std::scoped_lock lk(pool.mtx);
+        if (const auto it = pool.strings.find(s); it != pool.strings.end()) {
+            return it->c_str();
+        }
+        return pool.strings.emplace(s).first->c_str();
+    }
+
+    TESForm::TESForm(FormID a_id, FormType a_type, std::string a_name)
+        : formID(a_id), formType(a_type), fullName(std::move(a_name)) {
+        Registry().insert_or_assign(formID, this);
+    }
+
+    TESForm::~TESForm() {
+        auto& reg = Registry();
+        if (const auto it = reg.find(formID); it != reg.end() && it->second == this) {
+            reg.erase(it);
+        }
+    }
+
+    std::unordered_map<FormID, TESForm*>& TESForm::Registry() {
+        static std::unordered_map<FormID, TESForm*> s;  // NOSONAR
+        return s;
+    }
+
+    TESDataHandler* TESDataHandler::GetSingleton() noexcept {
+        static TESDataHandler s;  // NOSONAR
+        return &s;
+    }
+
+    ExtraTextDisplayData::ExtraTextDisplayData(TESBoundObject* a_base, float a_temperFactor)
+        : temperFactor(a_temperFactor) {
+        if (a_base) displayName = a_base->GetName();
+    }
+
+    void InventoryChanges::SetUniqueID(ExtraDataList* a_extra, TESBoundObject*, TESBoundObject* a_newForm) {
+        if (!a_extra) return;
+
+        a_extra->RemoveByType(ExtraDataType::kUniqueID);
+        a_extra->Add(new ExtraUniqueID(a_newForm ? a_newForm->GetFormID() : 0, nextUniqueID++));
+    }
+
+    Actor::Actor(FormID a_id, std::string a_name)
+        : TESObjectREFR(a_id, FormType::ActorCharacter, std::move(a_name)),
+          inventoryChanges(std::make_unique<InventoryChanges>()) {}
+
+    Actor::~Actor() = default;
+
+    InventoryEntryData* Actor::GetEquippedEntryData(bool a_leftHand) noexcept {
+        auto& hand = hands[a_leftHand ? 1 : 0];
+        if (!hand.object) return nullptr;
+
+        hand.extraLists.clear();
+        if (hand.extra) hand.extraLists.push_back(hand.extra);
+        hand.entry.object = hand.object;
+        hand.entry.countDelta = 1;
+        hand.entry.extraLists = &hand.extraLists;
+        return &hand.entry;
+    }
+
+    TESForm* Actor::GetEquippedObject(bool a_leftHand) const noexcept { return hands[a_leftHand ? 1 : 0].object; }
+
+    std::atomic<PlayerCharacter*>& PlayerCharacter::Instance() noexcept {
+        static std::atomic<PlayerCharacter*> s{nullptr};  // NOSONAR
+        return s;
+    }
+
+    ActorEquipManager* ActorEquipManager::GetSingleton() noexcept {
+        static ActorEquipManager s;  // NOSONAR
+        return &s;
+    }
+
+    void ActorEquipManager::EquipObject(Actor* a_actor, TESBoundObject* a_object, ExtraDataList* a_extraData,
+                                        std::uint32_t, const BGSEquipSlot*, bool a_queueEquip, bool a_forceEquip,
+                                        bool, bool a_applyNow) {
+        ++equips;
+        if (handler) handler(Call{true, a_actor, a_object, a_extraData, a_queueEquip, a_forceEquip, a_applyNow});
+    }
+
+    void ActorEquipManager::UnequipObject(Actor* a_actor, TESBoundObject* a_object, ExtraDataList* a_extraData,
+                                          std::uint32_t, const BGSEquipSlot*, bool a_queueEquip, bool a_forceEquip,
+                                          bool, bool a_applyNow, const BGSEquipSlot*) {
+        ++unequips;
+        if (handler) handler(Call{false, a_actor, a_object, a_extraData, a_queueEquip, a_forceEquip, a_applyNow});
+    }
+
+    // Like the engine's, these are never freed; callers that care recycle them.
+    ButtonEvent* ButtonEvent::Create(INPUT_DEVICE a_inputDevice, const BSFixedString& a_userEvent,
+                                     std::uint32_t a_idCode, float a_value, float a_duration) {
+        auto* ev = new ButtonEvent();  // NOSONAR
+        ev->device = a_inputDevice;
+        ev->eventType = INPUT_EVENT_TYPE::kButton;
+        ev->userEvent = a_userEvent;
+        ev->idCode = a_idCode;
+        ev->value = a_value;
+        ev->heldDownSecs = a_duration;
+        return ev;
+    }
+
+    BSInputDeviceManager* BSInputDeviceManager::GetSingleton() noexcept {
+        static BSInputDeviceManager s;  // NOSONAR
+        return &s;
+    }
+
+    ScriptEventSourceHolder* ScriptEventSourceHolder::GetSingleton() noexcept {
+        static ScriptEventSourceHolder s;  // NOSONAR
+        return &s;
+    }
+
+    UI* UI::GetSingleton() noexcept {
+        static UI s;  // NOSONAR
+        return &s;
+    }
+
+    void UI::SetMenuOpen(const BSFixedString& a_menu, bool a_open) {
+        const bool wasOpen = IsMenuOpen(a_menu);
+        if (a_open == wasOpen) return;
+
+        if (a_open) {
+            openMenus.push_back(a_menu);
+        } else {
+            std::erase(openMenus, a_menu);
+        }
+
+        const MenuOpenCloseEvent ev{a_menu, a_open};
+        SendEvent(&ev);
+    }
+}
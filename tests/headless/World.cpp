@@ -0,0 +1,484 @@
+#include "World.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <string>
+
+#include "BowState.h"
+#include "InventoryIndex.h"
+#include "bow_input/BowInputHandler.h"
+#include "bow_input/BowModeController.h"
+#include "bow_input/FrameClock.h"
+#include "bow_input/InputGate.h"
+#include "bow_input/InputState.h"
+#include "bow_input/TransformWatcher.h"
+#include "config/BowConfig.h"
+#include "config/ConfigSnapshot.h"
+#include "patchs/HiddenItemsPatch.h"
+
+#ifndef _WIN32
+    #include <unistd.h>
+#endif
+
+namespace Headless {
+    namespace {
+        // Never rewound: the scheduler's wheel outlives a World, and a clock that went backwards would leave its
+        // pending timers stranded in the future.
+        std::atomic<std::uint64_t> g_nowUs{1'000'000'000};  // NOSONAR
+        World* g_current = nullptr;                          // NOSONAR
+
+        std::uint64_t VirtualUs() noexcept { return g_nowUs.load(std::memory_order_relaxed); }
+
+        // BowConfig writes next to the DLL; headless, that is a scratch directory per process.
+        void EnsureDataDir() {
+            namespace fs = std::filesystem;
+            const char* env = std::getenv("INTEGRATEDBOW_DATA_DIR");
+            fs::path dir;
+            if (env && *env) {
+                dir = env;
+            } else {
+#ifdef _WIN32
+                dir = fs::temp_directory_path() / "integratedbow-headless";
+                _putenv_s("INTEGRATEDBOW_DATA_DIR", dir.string().c_str());
+#else
+                dir = fs::temp_directory_path() / ("integratedbow-headless-" + std::to_string(::getpid()));
+                ::setenv("INTEGRATEDBOW_DATA_DIR", dir.c_str(), 1);
+#endif
+            }
+            std::error_code ec;
+            fs::create_directories(dir, ec);
+        }
+
+        bool IsBow(const RE::TESForm* form) noexcept {
+            auto const* w = form ? form->As<RE::TESObjectWEAP>() : nullptr;
+            return w && w->IsBow();
+        }
+
+        void ResetPlugin() {
+            auto& cfg = IntegratedBow::GetBowConfig();
+            cfg.chosenBowFormID.store(0, std::memory_order_relaxed);
+            cfg.chosenBowUid.store(0, std::memory_order_relaxed);
+            cfg.preferredArrowFormID.store(0, std::memory_order_relaxed);
+            IntegratedBow::PublishConfig(IntegratedBow::ConfigSnapshot{});
+
+            auto& ctrl = BowInput::BowModeController::Get();
+            ctrl.ForceImmediateExit();
+            ctrl.AllowUnequip();
+            BowState::Reset();
+
+            BowInput::Inputs().Clear();
+            BowInput::SetMode(0);
+            BowInput::SetKeyScanCodes(0x2F, -1, -1);
+            BowInput::SetGamepadButtons(-1, -1, -1);
+            BowInput::SetHotkeyPattern("");
+            BowInput::InputGate::SetBlockingMenus(IntegratedBow::BowConfig::DefaultBlockingMenus());
+            HiddenItemsPatch::SetEnabled(false);
+            BowState::Inventory::Invalidate();
+        }
+    }
+
+    World::World(bool loadout) {
+        EnsureDataDir();
+        g_current = this;
+
+        _bow = std::make_unique<RE::TESObjectWEAP>(0x00013985, "Hunting Bow", RE::WEAPON_TYPE::kBow);
+        _longBow = std::make_unique<RE::TESObjectWEAP>(0x0003B562, "Long Bow", RE::WEAPON_TYPE::kBow);
+        _sword = std::make_unique<RE::TESObjectWEAP>(0x00012EB7, "Iron Sword", RE::WEAPON_TYPE::kOneHandSword);
+        _dagger = std::make_unique<RE::TESObjectWEAP>(0x0001397E, "Iron Dagger", RE::WEAPON_TYPE::kOneHandDagger);
+        _ironArrow = std::make_unique<RE::TESAmmo>(0x0001397D, "Iron Arrow");
+        _steelArrow = std::make_unique<RE::TESAmmo>(0x0001397F, "Steel Arrow");
+        _helmet = std::make_unique<RE::TESObjectARMO>(0x00012E4D, "Iron Helmet", 1u << 0);
+        _cuirass = std::make_unique<RE::TESObjectARMO>(0x00012E49, "Iron Armor", 1u << 2);
+        _gauntlets = std::make_unique<RE::TESObjectARMO>(0x00012E46, "Iron Gauntlets", 1u << 3);
+        _boots = std::make_unique<RE::TESObjectARMO>(0x00012E4B, "Iron Boots", 1u << 7);
+        _quiver = std::make_unique<RE::TESObjectARMO>(0x00800001, "Quiver", 1u << 17);  // slot 47, a mod's quiver
+
+        _player = std::make_unique<RE::PlayerCharacter>();
+        _player->biped3rd = std::make_shared<RE::BipedAnim>();
+        _player->inventoryChanges->entryList = &_entryList;
+        RE::PlayerCharacter::SetSingleton(_player.get());
+
+        auto* equipMgr = RE::ActorEquipManager::GetSingleton();
+        equipMgr->handler = [this](const RE::ActorEquipManager::Call& call) { OnEquipCall(call); };
+        equipMgr->equips = 0;
+        equipMgr->unequips = 0;
+
+        auto* ui = RE::UI::GetSingleton();
+        ui->paused = false;
+        ui->openMenus.clear();
+
+        _held.reserve(16);
+        _events.reserve(32);
+        _anims.reserve(16);
+
+        BowInput::FrameClock::SetSource(&VirtualUs);
+        BowInput::RegisterInputHandler();
+        BowInput::TransformWatcher::Initialize();
+        BowState::Inventory::Register();
+        ResetPlugin();
+
+        if (loadout) {
+            Equip(_sword.get(), Give(_sword.get()));
+            Equip(_helmet.get(), Give(_helmet.get()));
+            Equip(_cuirass.get(), Give(_cuirass.get()));
+            Equip(_boots.get(), Give(_boots.get()));
+            Give(_bow.get());
+            Give(_longBow.get());
+            Give(_ironArrow.get(), 50, false);
+        }
+        _counters = {};
+        equipMgr->equips = 0;
+        equipMgr->unequips = 0;
+    }
+
+    World::~World() {
+        ResetPlugin();
+        IntegratedBow::BowConfig::FlushSave();
+
+        auto* equipMgr = RE::ActorEquipManager::GetSingleton();
+        equipMgr->handler = nullptr;
+        RE::PlayerCharacter::SetSingleton(nullptr);
+        BowInput::FrameClock::SetSource(nullptr);
+        g_current = nullptr;
+    }
+
+    World* World::Current() noexcept { return g_current; }
+
+    std::uint64_t World::NowUs() noexcept { return VirtualUs(); }
+
+    // ---- time and input ----
+
+    void World::Step(std::uint64_t ms) {
+        Advance(ms * 1000);
+        Poll();
+        ObserveState();
+        ++_counters.frames;
+    }
+
+    void World::StepRecorded(std::uint64_t us, std::span<const RE::ButtonEvent> events) {
+        Advance(us);
+        _events.assign(events.begin(), events.end());
+        Dispatch();
+        ObserveState();
+        ++_counters.frames;
+    }
+
+    void World::Advance(std::uint64_t us) {
+        g_nowUs.fetch_add(us, std::memory_order_relaxed);
+        DeliverDueAnims();
+    }
+
+    void World::Run(std::uint64_t ms, std::uint64_t frameMs) {
+        for (std::uint64_t t = 0; t < ms; t += frameMs) {
+            Step(frameMs);
+        }
+    }
+
+    void World::Press(const Key& key) {
+        for (auto& h : _held) {
+            if (h.key.device == key.device && h.key.idCode == key.idCode && !h.released) return;
+        }
+        _held.push_back(HeldKey{key, RE::BSFixedString{key.userEvent}, VirtualUs(), false, true});
+    }
+
+    void World::Release(const Key& key) {
+        for (auto& h : _held) {
+            if (h.key.device == key.device && h.key.idCode == key.idCode) h.released = true;
+        }
+    }
+
+    void World::Tap(const Key& key, std::uint64_t holdMs, std::uint64_t frameMs) {
+        Press(key);
+        Run(holdMs, frameMs);
+        Release(key);
+        Step(frameMs);
+    }
+
+    void World::Poll() {
+        const auto now = VirtualUs();
+        _events.clear();
+        for (auto& h : _held) {
+            auto& ev = _events.emplace_back();
+            ev.device = h.key.device;
+            ev.eventType = RE::INPUT_EVENT_TYPE::kButton;
+            ev.userEvent = h.userEvent;
+            ev.idCode = h.key.idCode;
+
+            // A key pressed and released between two polls still shows up as a down first.
+            const float secs = std::max(static_cast<float>(now - h.downUs) / 1'000'000.0f, 0.001f);
+            if (h.fresh) {
+                ev.value = 1.0f;
+                ev.heldDownSecs = 0.0f;
+                h.fresh = false;
+            } else {
+                ev.value = h.released ? 0.0f : 1.0f;
+                ev.heldDownSecs = secs;
+                h.upSent = h.released;
+            }
+        }
+        std::erase_if(_held, [](const HeldKey& h) { return h.upSent; });
+        Dispatch();
+    }
+
+    void World::Dispatch() {
+        RE::InputEvent* head = nullptr;
+        for (auto it = _events.rbegin(); it != _events.rend(); ++it) {
+            it->next = head;
+            head = &*it;
+        }
+
+        // Same shape as Hooks.cpp's PollInputDevicesHook around the engine's dispatch.
+        using namespace BowState::detail;
+        auto* dispatcher = RE::BSInputDeviceManager::GetSingleton();
+        if (!HasPendingSyntheticInput()) {
+            dispatcher->SendEvent(&head);
+            ObserveInput(head);
+            return;
+        }
+
+        RE::InputEvent* const arr[2]{FlushSyntheticInput(head), nullptr};
+        dispatcher->SendEvent(arr);
+        ObserveInput(arr[0]);
+        RecycleDeliveredSyntheticInput();
+    }
+
+    // The engine's side of an attack press: with a bow out, an arrow is nocked a little later.
+    void World::ObserveInput(const RE::InputEvent* delivered) {
+        const std::less<const RE::InputEvent*> before;
+        const RE::InputEvent* first = _events.data();
+        const RE::InputEvent* last = _events.data() + _events.size();
+        for (auto const* e = delivered; e; e = e->next) {
+            if (before(e, first) || !before(e, last)) ++_counters.syntheticDelivered;
+
+            auto const* button = e->AsButtonEvent();
+            if (!button || !button->IsDown() || !(button->QUserEvent() == _attackEvent)) continue;
+            if (_nockPending || !IsDrawn() || !IsBow(RightHand())) continue;
+            _nockPending = true;
+            Schedule(timing.arrowNockMs, _tagArrowAttach);
+        }
+    }
+
+    void World::ObserveState() {
+        const bool drawn = IsDrawn();
+        auto* right = RightHand();
+        if (drawn && IsBow(right) && (!_wasDrawn || right != _lastRight)) {
+            Schedule(timing.bowEquipMs, _tagEnableBumper);
+        }
+        if (!drawn && _wasDrawn) {
+            Schedule(timing.sheatheMs, _tagWeaponSheathe);
+        }
+        _wasDrawn = drawn;
+        _lastRight = right;
+    }
+
+    void World::Schedule(std::uint64_t delayMs, const RE::BSFixedString& tag) {
+        _anims.push_back(PendingAnim{VirtualUs() + delayMs * 1000, tag});
+    }
+
+    void World::DeliverDueAnims() {
+        const auto now = VirtualUs();
+        for (;;) {
+            auto due = _anims.end();
+            for (auto it = _anims.begin(); it != _anims.end(); ++it) {
+                if (it->dueUs <= now && (due == _anims.end() || it->dueUs < due->dueUs)) due = it;
+            }
+            if (due == _anims.end()) return;
+
+            const RE::BSAnimationGraphEvent ev{due->tag, _player.get(), {}};
+            if (due->tag == _tagArrowAttach) _nockPending = false;
+            _anims.erase(due);
+            ++_counters.animEvents;
+            BowInput::HandleAnimEvent(&ev, nullptr);
+        }
+    }
+
+    // ---- inventory ----
+
+    RE::InventoryEntryData& World::EntryFor(RE::TESBoundObject* base) {
+        if (const auto it = _entryByBase.find(base); it != _entryByBase.end()) return *it->second;
+
+        auto& e = _entries.emplace_back(std::make_unique<RE::InventoryEntryData>());
+        e->object = base;
+        _entryByBase.emplace(base, e.get());
+        _entryList.push_back(e.get());
+        return *e;
+    }
+
+    RE::ExtraDataList* World::NewExtra(RE::TESBoundObject* base) {
+        auto& entry = EntryFor(base);
+        if (!entry.extraLists) {
+            entry.extraLists = _extraLists.emplace_back(std::make_unique<RE::BSSimpleList<RE::ExtraDataList*>>()).get();
+        }
+        auto* extra = _extras.emplace_back(std::make_unique<RE::ExtraDataList>()).get();
+        entry.extraLists->push_back(extra);
+        return extra;
+    }
+
+    RE::ExtraDataList* World::FirstExtraOf(RE::TESBoundObject* base) {
+        auto& entry = EntryFor(base);
+        if (entry.extraLists && !entry.extraLists->empty()) return entry.extraLists->front();
+        return NewExtra(base);
+    }
+
+    RE::ExtraDataList* World::Give(RE::TESBoundObject* base, std::int32_t count, bool withExtra) {
+        EntryFor(base).countDelta += count;
+        RE::ExtraDataList* extra = withExtra ? NewExtra(base) : nullptr;
+
+        const RE::TESContainerChangedEvent ev{0, _player->GetFormID(), base->GetFormID(), count};
+        RE::ScriptEventSourceHolder::GetSingleton()->SendEvent(&ev);
+        return extra;
+    }
+
+    void World::GiveBase(RE::TESBoundObject* base, std::int32_t count) {
+        _player->container.objects.push_back(RE::ContainerObject{count, base});
+        BowState::Inventory::Invalidate();
+    }
+
+    void World::Take(RE::TESBoundObject* base, RE::ExtraDataList* extra) {
+        auto& entry = EntryFor(base);
+        if (entry.extraLists) entry.extraLists->remove(extra);
+        entry.countDelta -= 1;
+        for (auto& hand : _player->hands) {
+            if (hand.extra == extra) hand = {};
+        }
+
+        const RE::TESContainerChangedEvent ev{_player->GetFormID(), 0, base->GetFormID(), 1};
+        RE::ScriptEventSourceHolder::GetSingleton()->SendEvent(&ev);
+    }
+
+    std::vector<RE::ExtraDataList*> World::ExtrasOf(const RE::TESBoundObject* base) const {
+        const auto it = _entryByBase.find(base);
+        if (it == _entryByBase.end() || !it->second->extraLists) return {};
+        return {it->second->extraLists->begin(), it->second->extraLists->end()};
+    }
+
+    bool World::IsWorn(const RE::TESBoundObject* base) const {
+        if (_player->currentAmmo == base) return true;
+        for (auto const& hand : _player->hands) {
+            if (hand.object == base) return true;
+        }
+        for (auto const* extra : ExtrasOf(base)) {
+            if (extra->HasType(RE::ExtraDataType::kWorn)) return true;
+        }
+        return false;
+    }
+
+    void World::SetMenuOpen(std::string_view menu, bool open) {
+        RE::UI::GetSingleton()->SetMenuOpen(RE::BSFixedString{menu}, open);
+    }
+
+    // ---- the equip manager ----
+
+    void World::Equip(RE::TESBoundObject* base, RE::ExtraDataList* extra) { DoEquip(base, extra, false); }
+
+    void World::EquipLeft(RE::TESObjectWEAP* weapon, RE::ExtraDataList* extra) { DoEquip(weapon, extra, true); }
+
+    void World::Unequip(RE::TESBoundObject* base, RE::ExtraDataList* extra) { DoUnequip(base, extra); }
+
+    void World::OnEquipCall(const RE::ActorEquipManager::Call& call) {
+        if (call.actor != _player.get() || !call.object) return;
+        if (call.equip) {
+            ++_counters.equips;
+            DoEquip(call.object, call.extra, false);
+        } else {
+            ++_counters.unequips;
+            DoUnequip(call.object, call.extra);
+        }
+    }
+
+    void World::SetWorn(RE::ExtraDataList* extra, bool worn) {
+        if (!extra) return;
+        if (worn) {
+            if (!extra->HasType(RE::ExtraDataType::kWorn)) extra->Add(new RE::ExtraWorn());  // NOSONAR
+            return;
+        }
+        extra->RemoveByType(RE::ExtraDataType::kWorn);
+        extra->RemoveByType(RE::ExtraDataType::kWornLeft);
+    }
+
+    void World::DoEquip(RE::TESBoundObject* base, RE::ExtraDataList* extra, bool leftHand) {
+        if (auto* ammo = base->As<RE::TESAmmo>()) {
+            _player->currentAmmo = ammo;
+            SendEquipEvent(base, true);
+            return;
+        }
+
+        if (!extra) extra = FirstExtraOf(base);
+
+        if (auto* weapon = base->As<RE::TESObjectWEAP>()) {
+            auto& hand = _player->hands[leftHand ? 1 : 0];
+            if (hand.extra && hand.extra != extra) SetWorn(hand.extra, false);
+            if (weapon->IsBow() || weapon->IsCrossbow() || weapon->IsTwoHanded()) {
+                auto& left = _player->hands[1];
+                if (left.extra) SetWorn(left.extra, false);
+                left = {};
+            }
+            hand = {};
+            hand.object = base;
+            hand.extra = extra;
+            SetWorn(extra, true);
+            if (leftHand && !extra->HasType(RE::ExtraDataType::kWornLeft)) {
+                extra->Add(new RE::ExtraWornLeft());  // NOSONAR
+            }
+            SendEquipEvent(base, true);
+            return;
+        }
+
+        if (auto* armor = base->As<RE::TESObjectARMO>()) {
+            // Whatever shares a slot comes off first, as the engine does.
+            for (auto const& e : _entries) {
+                auto* other = e->object ? e->object->As<RE::TESObjectARMO>() : nullptr;
+                if (!other || other == armor || !(other->slotMask & armor->slotMask) || !e->extraLists) continue;
+                for (auto* x : *e->extraLists) {
+                    if (x->HasType(RE::ExtraDataType::kWorn)) DoUnequip(other, x);
+                }
+            }
+            SetWorn(extra, true);
+            if (auto const& biped = _player->biped3rd) {
+                for (std::uint32_t i = 0; i < 32; ++i) {
+                    if (armor->slotMask & (1u << i)) biped->objects[i].item = armor;
+                }
+            }
+            SendEquipEvent(base, true);
+        }
+    }
+
+    void World::DoUnequip(RE::TESBoundObject* base, RE::ExtraDataList* extra) {
+        if (base->As<RE::TESAmmo>()) {
+            if (_player->currentAmmo == base) _player->currentAmmo = nullptr;
+            SendEquipEvent(base, false);
+            return;
+        }
+
+        if (base->As<RE::TESObjectWEAP>()) {
+            for (auto& hand : _player->hands) {
+                if (hand.object != base || (extra && hand.extra != extra)) continue;
+                SetWorn(hand.extra, false);
+                hand = {};
+            }
+            SendEquipEvent(base, false);
+            return;
+        }
+
+        if (auto* armor = base->As<RE::TESObjectARMO>()) {
+            if (extra) {
+                SetWorn(extra, false);
+            } else {
+                for (auto* x : ExtrasOf(base)) SetWorn(x, false);
+            }
+            if (auto const& biped = _player->biped3rd) {
+                for (auto& slot : biped->objects) {
+                    if (slot.item == armor) slot.item = nullptr;
+                }
+            }
+            SendEquipEvent(base, false);
+        }
+    }
+
+    void World::SendEquipEvent(RE::TESBoundObject* base, bool equipped) {
+        const RE::TESEquipEvent ev{_player.get(), base->GetFormID(), equipped};
+        RE::ScriptEventSourceHolder::GetSingleton()->SendEvent(&ev);
+    }
+}
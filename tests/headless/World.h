@@ -0,0 +1,184 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "RE/Skyrim.h"
+
+// What bow mode sees of a running game, without the game: one player with an inventory, an equip manager that moves
+// items between hands, worn slots and the quiver, the engine's poll hook around synthetic input, and the animation
+// events an equip or a sheathe produces some time later. Time is virtual and only moves in Step.
+//
+// Plugin state lives in function-local statics, so one World at a time; its constructor puts the plugin back in its
+// startup state as far as the public API allows.
+namespace Headless {
+    struct Key {
+        RE::INPUT_DEVICE device{RE::INPUT_DEVICE::kKeyboard};
+        std::uint32_t idCode{0};
+        const char* userEvent{""};
+    };
+
+    namespace Keys {
+        inline constexpr Key kHotkey{RE::INPUT_DEVICE::kKeyboard, 0x2F, ""};  // V, the default binding
+        inline constexpr Key kForward{RE::INPUT_DEVICE::kKeyboard, 0x11, "Forward"};
+        inline constexpr Key kReadyWeapon{RE::INPUT_DEVICE::kKeyboard, 0x13, "Ready Weapon"};
+        inline constexpr Key kShout{RE::INPUT_DEVICE::kKeyboard, 0x2C, "Shout"};
+        inline constexpr Key kAttack{RE::INPUT_DEVICE::kMouse, 0, "Right Attack/Block"};
+        inline constexpr Key kPadHotkey{RE::INPUT_DEVICE::kGamepad, 0x0100, ""};  // left shoulder
+    }
+
+    // Delays the modelled engine takes between a state change and the graph event that confirms it.
+    struct EngineTiming {
+        std::uint64_t bowEquipMs{300};   // bow in hand and drawn -> EnableBumper
+        std::uint64_t sheatheMs{400};    // weapon put away -> WeaponSheathe
+        std::uint64_t arrowNockMs{250};  // attack held with a bow -> arrowAttach
+    };
+
+    struct WorldCounters {
+        std::uint64_t frames{0};
+        std::uint64_t equips{0};
+        std::uint64_t unequips{0};
+        std::uint64_t animEvents{0};
+        std::uint64_t syntheticDelivered{0};
+    };
+
+    class World {
+    public:
+        // With a loadout the player starts with a sword in hand, helmet, cuirass and boots worn, a hunting bow and a
+        // long bow in the pack and 50 iron arrows.
+        explicit World(bool loadout = true);
+        ~World();
+
+        World(const World&) = delete;
+        World& operator=(const World&) = delete;
+
+        [[nodiscard]] static World* Current() noexcept;
+
+        // ---- time and input ----
+
+        // Advances the clock by ms, delivers the graph events that came due, then runs one poll: the held keys as
+        // ButtonEvents (down, held or up, as the engine reports them) plus the queued synthetic input.
+        void Step(std::uint64_t ms = 16);
+        void Run(std::uint64_t ms, std::uint64_t frameMs = 16);
+        // Step for a replay: advances by us and the poll carries exactly `events` (as recorded) instead of the held
+        // keys. Synthetic input still goes through the poll hook.
+        void StepRecorded(std::uint64_t us, std::span<const RE::ButtonEvent> events);
+
+        void Press(const Key& key);
+        void Release(const Key& key);
+        void Tap(const Key& key, std::uint64_t holdMs = 50, std::uint64_t frameMs = 16);
+
+        [[nodiscard]] static std::uint64_t NowUs() noexcept;
+
+        // ---- the player and their things ----
+
+        [[nodiscard]] RE::PlayerCharacter& Player() noexcept { return *_player; }
+        [[nodiscard]] RE::TESObjectWEAP* Bow() noexcept { return _bow.get(); }
+        [[nodiscard]] RE::TESObjectWEAP* LongBow() noexcept { return _longBow.get(); }
+        [[nodiscard]] RE::TESObjectWEAP* Sword() noexcept { return _sword.get(); }
+        [[nodiscard]] RE::TESObjectWEAP* Dagger() noexcept { return _dagger.get(); }
+        [[nodiscard]] RE::TESAmmo* IronArrow() noexcept { return _ironArrow.get(); }
+        [[nodiscard]] RE::TESAmmo* SteelArrow() noexcept { return _steelArrow.get(); }
+        [[nodiscard]] RE::TESObjectARMO* Helmet() noexcept { return _helmet.get(); }
+        [[nodiscard]] RE::TESObjectARMO* Cuirass() noexcept { return _cuirass.get(); }
+        [[nodiscard]] RE::TESObjectARMO* Gauntlets() noexcept { return _gauntlets.get(); }
+        [[nodiscard]] RE::TESObjectARMO* Boots() noexcept { return _boots.get(); }
+        [[nodiscard]] RE::TESObjectARMO* Quiver() noexcept { return _quiver.get(); }
+
+        // Adds count of base to the inventory changes; withExtra singles one of them out with its own extra list
+        // (returned), as a renamed or tempered item would be.
+        RE::ExtraDataList* Give(RE::TESBoundObject* base, std::int32_t count = 1, bool withExtra = true);
+        // Base-container items: counted by the inventory but without change entries.
+        void GiveBase(RE::TESBoundObject* base, std::int32_t count);
+        // Drops one of base's extra lists from the inventory (sold, dropped, merged back into its stack). The list
+        // itself stays allocated, so stale pointers to it can still be compared.
+        void Take(RE::TESBoundObject* base, RE::ExtraDataList* extra);
+        [[nodiscard]] std::vector<RE::ExtraDataList*> ExtrasOf(const RE::TESBoundObject* base) const;
+
+        // Engine-side equips, as the player would do from the inventory menu (no plugin involved).
+        void Equip(RE::TESBoundObject* base, RE::ExtraDataList* extra = nullptr);
+        void EquipLeft(RE::TESObjectWEAP* weapon, RE::ExtraDataList* extra = nullptr);
+        void Unequip(RE::TESBoundObject* base, RE::ExtraDataList* extra = nullptr);
+        void DropBiped() noexcept { _player->biped3rd.reset(); }
+
+        [[nodiscard]] RE::TESForm* RightHand() const noexcept { return _player->hands[0].object; }
+        [[nodiscard]] RE::TESForm* LeftHand() const noexcept { return _player->hands[1].object; }
+        [[nodiscard]] bool IsWorn(const RE::TESBoundObject* base) const;
+        [[nodiscard]] bool IsDrawn() const noexcept { return _player->actorState.IsWeaponDrawn(); }
+
+        void SetMenuOpen(std::string_view menu, bool open);
+
+        EngineTiming timing{};
+        [[nodiscard]] const WorldCounters& Counters() const noexcept { return _counters; }
+
+    private:
+        struct HeldKey {
+            Key key;
+            RE::BSFixedString userEvent;
+            std::uint64_t downUs{0};
+            bool released{false};
+            bool fresh{true};
+            bool upSent{false};
+        };
+
+        struct PendingAnim {
+            std::uint64_t dueUs{0};
+            RE::BSFixedString tag;
+        };
+
+        void OnEquipCall(const RE::ActorEquipManager::Call& call);
+        void DoEquip(RE::TESBoundObject* base, RE::ExtraDataList* extra, bool leftHand);
+        void DoUnequip(RE::TESBoundObject* base, RE::ExtraDataList* extra);
+        void SendEquipEvent(RE::TESBoundObject* base, bool equipped);
+        RE::InventoryEntryData& EntryFor(RE::TESBoundObject* base);
+        RE::ExtraDataList* FirstExtraOf(RE::TESBoundObject* base);
+        RE::ExtraDataList* NewExtra(RE::TESBoundObject* base);
+        void SetWorn(RE::ExtraDataList* extra, bool worn);
+        void Schedule(std::uint64_t delayMs, const RE::BSFixedString& tag);
+        void DeliverDueAnims();
+        void ObserveInput(const RE::InputEvent* delivered);
+        void ObserveState();
+        void Advance(std::uint64_t us);
+        void Poll();
+        void Dispatch();
+
+        std::unique_ptr<RE::PlayerCharacter> _player;
+        std::unique_ptr<RE::TESObjectWEAP> _bow;
+        std::unique_ptr<RE::TESObjectWEAP> _longBow;
+        std::unique_ptr<RE::TESObjectWEAP> _sword;
+        std::unique_ptr<RE::TESObjectWEAP> _dagger;
+        std::unique_ptr<RE::TESAmmo> _ironArrow;
+        std::unique_ptr<RE::TESAmmo> _steelArrow;
+        std::unique_ptr<RE::TESObjectARMO> _helmet;
+        std::unique_ptr<RE::TESObjectARMO> _cuirass;
+        std::unique_ptr<RE::TESObjectARMO> _gauntlets;
+        std::unique_ptr<RE::TESObjectARMO> _boots;
+        std::unique_ptr<RE::TESObjectARMO> _quiver;
+
+        std::list<RE::InventoryEntryData*> _entryList;
+        std::vector<std::unique_ptr<RE::InventoryEntryData>> _entries;
+        std::unordered_map<const RE::TESBoundObject*, RE::InventoryEntryData*> _entryByBase;  // inventories of 10k+
+        std::vector<std::unique_ptr<RE::BSSimpleList<RE::ExtraDataList*>>> _extraLists;
+        std::vector<std::unique_ptr<RE::ExtraDataList>> _extras;
+
+        std::vector<HeldKey> _held;
+        std::vector<RE::ButtonEvent> _events;  // reused every frame
+        std::vector<PendingAnim> _anims;       // unordered; scanned each step
+
+        RE::BSFixedString _tagEnableBumper{"EnableBumper"};
+        RE::BSFixedString _tagWeaponSheathe{"WeaponSheathe"};
+        RE::BSFixedString _tagArrowAttach{"arrowAttach"};
+        RE::BSFixedString _attackEvent{"Right Attack/Block"};
+
+        bool _wasDrawn{false};
+        RE::TESForm* _lastRight{nullptr};
+        bool _nockPending{false};
+
+        WorldCounters _counters{};
+    };
+}
@@ -0,0 +1,710 @@
+#pragma once
+
+// Stand-ins for the slice of CommonLibSSE-NG the gameplay core touches, so it builds and runs without the game. Names,
+// signatures and event semantics follow CommonLib; the state behind them is plain data a test or the simulation
+// driver sets up (see tests/headless/World.h). Nothing here talks to an engine.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#ifndef _WIN32
+    #include <strings.h>
+
+// MSVC's CRT name, which the plugin gets for free on Windows.
+inline int _stricmp(const char* a, const char* b) noexcept { return ::strcasecmp(a, b); }  // NOSONAR
+#endif
+
+namespace RE {
+    using FormID = std::uint32_t;
+
+    // Interned like the engine's string pool: equal text gives the same data() pointer for the life of the process.
+    class BSFixedString {
+    public:
+        BSFixedString() noexcept = default;
+        BSFixedString(const char* s) : _data(Intern(s ? std::string_view{s} : std::string_view{})) {}  // NOLINT
+        BSFixedString(std::string_view s) : _data(Intern(s)) {}                                          // NOLINT
+        BSFixedString(const std::string& s) : _data(Intern(s)) {}                                        // NOLINT
+
+        [[nodiscard]] const char* data() const noexcept { return _data; }
+        [[nodiscard]] const char* c_str() const noexcept { return _data ? _data : ""; }
+        [[nodiscard]] bool empty() const noexcept { return !_data || !*_data; }
+        [[nodiscard]] std::size_t size() const noexcept { return std::string_view{c_str()}.size(); }
+
+        friend bool operator==(const BSFixedString& a, const BSFixedString& b) noexcept { return a._data == b._data; }
+
+    private:
+        static const char* Intern(std::string_view s);
+
+        const char* _data{nullptr};
+    };
+
+    enum class INPUT_DEVICE : std::uint32_t {
+        kNone = static_cast<std::uint32_t>(-1),
+        kKeyboard = 0,
+        kMouse,
+        kGamepad,
+        kVirtualKeyboard,
+        kTotal
+    };
+
+    enum class INPUT_EVENT_TYPE : std::uint32_t { kButton = 0, kMouseMove, kChar, kThumbstick, kDeviceConnect };
+
+    enum class BSEventNotifyControl : std::uint32_t { kContinue = 0, kStop = 1 };
+
+    template <class Event>
+    class BSTEventSource;
+
+    template <class Event>
+    class BSTEventSink {
+    public:
+        virtual ~BSTEventSink() = default;
+        virtual BSEventNotifyControl ProcessEvent(const Event* a_event, BSTEventSource<Event>* a_eventSource) = 0;
+    };
+
+    template <class Event>
+    class BSTEventSource {
+    public:
+        void AddEventSink(BSTEventSink<Event>* a_sink) {
+            for (auto* s : sinks) {
+                if (s == a_sink) return;
+            }
+            sinks.push_back(a_sink);
+        }
+
+        void SendEvent(const Event* a_event) {
+            for (auto* s : sinks) {
+                if (s->ProcessEvent(a_event, this) == BSEventNotifyControl::kStop) break;
+            }
+        }
+
+        std::vector<BSTEventSink<Event>*> sinks;
+    };
+
+    template <class T>
+    using BSSimpleList = std::list<T>;
+
+    // ---- forms ----
+
+    enum class FormType : std::uint8_t {
+        None = 0,
+        Armor = 26,
+        Light = 31,
+        Weapon = 41,
+        Ammo = 42,
+        Spell = 22,
+        Scroll = 23,
+        Reference = 61,
+        ActorCharacter = 62,
+    };
+
+    class TESForm {
+    public:
+        TESForm(FormID a_id, FormType a_type, std::string a_name = {});
+        virtual ~TESForm();
+
+        TESForm(const TESForm&) = delete;
+        TESForm& operator=(const TESForm&) = delete;
+
+        [[nodiscard]] FormID GetFormID() const noexcept { return formID; }
+        [[nodiscard]] FormType GetFormType() const noexcept { return formType; }
+        [[nodiscard]] bool IsArmor() const noexcept { return formType == FormType::Armor; }
+        [[nodiscard]] const char* GetName() const noexcept { return fullName.c_str(); }
+
+        template <class T>
+        [[nodiscard]] T* As() noexcept {
+            return dynamic_cast<T*>(this);
+        }
+
+        template <class T>
+        [[nodiscard]] const T* As() const noexcept {
+            return dynamic_cast<const T*>(this);
+        }
+
+        template <class T = TESForm>
+        [[nodiscard]] static T* LookupByID(FormID a_id) {
+            auto& reg = Registry();
+            const auto it = reg.find(a_id);
+            return it != reg.end() ? dynamic_cast<T*>(it->second) : nullptr;
+        }
+
+        FormID formID{0};
+        FormType formType{FormType::None};
+        std::string fullName;
+
+        [[nodiscard]] static const std::unordered_map<FormID, TESForm*>& Forms() { return Registry(); }
+
+    private:
+        static std::unordered_map<FormID, TESForm*>& Registry();
+    };
+
+    class TESBoundObject : public TESForm {
+    public:
+        using TESForm::TESForm;
+    };
+
+    enum class WEAPON_TYPE : std::uint8_t {
+        kHandToHandMelee = 0,
+        kOneHandSword,
+        kOneHandDagger,
+        kOneHandAxe,
+        kOneHandMace,
+        kTwoHandSword,
+        kTwoHandAxe,
+        kBow,
+        kStaff,
+        kCrossbow
+    };
+
+    class TESObjectWEAP : public TESBoundObject {
+    public:
+        TESObjectWEAP(FormID a_id, std::string a_name, WEAPON_TYPE a_type = WEAPON_TYPE::kOneHandSword)
+            : TESBoundObject(a_id, FormType::Weapon, std::move(a_name)), weaponType(a_type) {}
+
+        [[nodiscard]] WEAPON_TYPE GetWeaponType() const noexcept { return weaponType; }
+        [[nodiscard]] bool IsBow() const noexcept { return weaponType == WEAPON_TYPE::kBow; }
+        [[nodiscard]] bool IsCrossbow() const noexcept { return weaponType == WEAPON_TYPE::kCrossbow; }
+        [[nodiscard]] bool IsTwoHanded() const noexcept {
+            return weaponType >= WEAPON_TYPE::kTwoHandSword && weaponType != WEAPON_TYPE::kStaff;
+        }
+
+        WEAPON_TYPE weaponType{WEAPON_TYPE::kOneHandSword};
+    };
+
+    class TESAmmo : public TESBoundObject {
+    public:
+        TESAmmo(FormID a_id, std::string a_name) : TESBoundObject(a_id, FormType::Ammo, std::move(a_name)) {}
+    };
+
+    struct BGSBipedObjectForm {
+        enum class BipedObjectSlot : std::uint32_t { kNone = 0 };
+    };
+
+    class TESObjectARMO : public TESBoundObject {
+    public:
+        TESObjectARMO(FormID a_id, std::string a_name, std::uint32_t a_slotMask)
+            : TESBoundObject(a_id, FormType::Armor, std::move(a_name)), slotMask(a_slotMask) {}
+
+        [[nodiscard]] BGSBipedObjectForm::BipedObjectSlot GetSlotMask() const noexcept {
+            return static_cast<BGSBipedObjectForm::BipedObjectSlot>(slotMask);
+        }
+
+        std::uint32_t slotMask{0};  // bit i: biped slot 30 + i
+    };
+
+    namespace EffectArchetypes {
+        enum class ArchetypeID : std::uint32_t { kValueModifier = 0, kScript = 1, kWerewolf = 41, kVampireLord = 46 };
+    }
+
+    namespace MagicSystem {
+        enum class SpellType : std::uint32_t { kSpell = 0, kDisease, kPower, kLesserPower, kAbility, kPoison };
+    }
+
+    class EffectSetting : public TESForm {
+    public:
+        EffectSetting(FormID a_id, EffectArchetypes::ArchetypeID a_archetype)
+            : TESForm(a_id, FormType::None), archetype(a_archetype) {}
+
+        [[nodiscard]] EffectArchetypes::ArchetypeID GetArchetype() const noexcept { return archetype; }
+
+        EffectArchetypes::ArchetypeID archetype{};
+    };
+
+    struct Effect {
+        EffectSetting* baseEffect{nullptr};
+    };
+
+    class MagicItem : public TESBoundObject {
+    public:
+        using TESBoundObject::TESBoundObject;
+
+        std::vector<Effect*> effects;
+    };
+
+    class SpellItem : public MagicItem {
+    public:
+        SpellItem(FormID a_id, std::string a_name, MagicSystem::SpellType a_type)
+            : MagicItem(a_id, FormType::Spell, std::move(a_name)), spellType(a_type) {}
+
+        [[nodiscard]] MagicSystem::SpellType GetSpellType() const noexcept { return spellType; }
+
+        MagicSystem::SpellType spellType{};
+    };
+
+    // Load order and form arrays. A plugin's forms get its load index in the top byte, as for full plugins.
+    class TESDataHandler {
+    public:
+        [[nodiscard]] static TESDataHandler* GetSingleton() noexcept;
+
+        // Every registered form of type T, in form ID order.
+        template <class T>
+        [[nodiscard]] std::vector<T*> GetFormArray() const {
+            std::vector<T*> out;
+            for (auto const& [id, form] : TESForm::Forms()) {
+                if (auto* t = dynamic_cast<T*>(form)) out.push_back(t);
+            }
+            std::ranges::sort(out, {}, &TESForm::formID);
+            return out;
+        }
+
+        [[nodiscard]] FormID LookupFormID(FormID a_localID, std::string_view a_plugin) const {
+            for (std::size_t i = 0; i < plugins.size(); ++i) {
+                if (plugins[i] == a_plugin) return (static_cast<FormID>(i) << 24) | (a_localID & 0x00FFFFFF);
+            }
+            return 0;
+        }
+
+        std::vector<std::string> plugins{"Skyrim.esm"};
+    };
+
+    // ---- extra data ----
+
+    enum class ExtraDataType : std::uint32_t {
+        kNone = 0,
+        kWorn = 0x16,
+        kWornLeft = 0x17,
+        kTextDisplayData = 0x99,
+        kUniqueID = 0x9B,
+    };
+
+    class BSExtraData {
+    public:
+        virtual ~BSExtraData() = default;
+        [[nodiscard]] virtual ExtraDataType GetType() const noexcept = 0;
+    };
+
+    class ExtraWorn : public BSExtraData {
+    public:
+        static constexpr auto EXTRADATATYPE = ExtraDataType::kWorn;
+        [[nodiscard]] ExtraDataType GetType() const noexcept override { return EXTRADATATYPE; }
+    };
+
+    class ExtraWornLeft : public BSExtraData {
+    public:
+        static constexpr auto EXTRADATATYPE = ExtraDataType::kWornLeft;
+        [[nodiscard]] ExtraDataType GetType() const noexcept override { return EXTRADATATYPE; }
+    };
+
+    class ExtraUniqueID : public BSExtraData {
+    public:
+        static constexpr auto EXTRADATATYPE = ExtraDataType::kUniqueID;
+        ExtraUniqueID(FormID a_baseID, std::uint16_t a_uniqueID) : baseID(a_baseID), uniqueID(a_uniqueID) {}
+        [[nodiscard]] ExtraDataType GetType() const noexcept override { return EXTRADATATYPE; }
+
+        FormID baseID{0};
+        std::uint16_t uniqueID{0};
+    };
+
+    class ExtraTextDisplayData : public BSExtraData {
+    public:
+        static constexpr auto EXTRADATATYPE = ExtraDataType::kTextDisplayData;
+        ExtraTextDisplayData(TESBoundObject* a_base, float a_temperFactor);
+        [[nodiscard]] ExtraDataType GetType() const noexcept override { return EXTRADATATYPE; }
+
+        void SetName(const char* a_name) { displayName = a_name; }
+
+        BSFixedString displayName;
+        float temperFactor{1.0f};
+    };
+
+    class ExtraDataList {
+    public:
+        [[nodiscard]] bool HasType(ExtraDataType a_type) const noexcept { return Find(a_type) != nullptr; }
+
+        template <class T>
+        [[nodiscard]] T* GetByType() const noexcept {
+            return static_cast<T*>(Find(T::EXTRADATATYPE));
+        }
+
+        [[nodiscard]] ExtraTextDisplayData* GetExtraTextDisplayData() const noexcept {
+            return GetByType<ExtraTextDisplayData>();
+        }
+
+        // The custom name when there is one, else the base's.
+        [[nodiscard]] const char* GetDisplayName(TESBoundObject* a_base) const {
+            if (auto const* tdd = GetExtraTextDisplayData(); tdd && !tdd->displayName.empty()) {
+                return tdd->displayName.c_str();
+            }
+            return a_base ? a_base->GetName() : nullptr;
+        }
+
+        BSExtraData* Add(BSExtraData* a_extra) {
+            data.emplace_back(a_extra);
+            return a_extra;
+        }
+
+        bool RemoveByType(ExtraDataType a_type) {
+            for (auto it = data.begin(); it != data.end(); ++it) {
+                if ((*it)->GetType() == a_type) {
+                    data.erase(it);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        std::vector<std::unique_ptr<BSExtraData>> data;
+
+    private:
+        [[nodiscard]] BSExtraData* Find(ExtraDataType a_type) const noexcept {
+            for (auto const& x : data) {
+                if (x->GetType() == a_type) return x.get();
+            }
+            return nullptr;
+        }
+    };
+
+    // ---- inventory ----
+
+    class InventoryEntryData {
+    public:
+        [[nodiscard]] TESBoundObject* GetObject() const noexcept { return object; }
+
+        TESBoundObject* object{nullptr};
+        BSSimpleList<ExtraDataList*>* extraLists{nullptr};
+        std::int32_t countDelta{0};
+    };
+
+    class InventoryChanges {
+    public:
+        // Gives a_extra the next ExtraUniqueID of this container, as the engine does when an instance is singled out.
+        void SetUniqueID(ExtraDataList* a_extra, TESBoundObject* a_oldForm, TESBoundObject* a_newForm);
+
+        BSSimpleList<InventoryEntryData*>* entryList{nullptr};
+        std::uint16_t nextUniqueID{1};
+    };
+
+    struct ContainerObject {
+        std::int32_t count{0};
+        TESBoundObject* obj{nullptr};
+    };
+
+    namespace BSContainer {
+        enum class ForEachResult : bool { kStop = false, kContinue = true };
+    }
+
+    class TESContainer {
+    public:
+        void ForEachContainerObject(const std::function<BSContainer::ForEachResult(ContainerObject&)>& a_fn) {
+            for (auto& o : objects) {
+                if (a_fn(o) == BSContainer::ForEachResult::kStop) break;
+            }
+        }
+
+        std::vector<ContainerObject> objects;
+    };
+
+    struct BipedObject {
+        TESForm* item{nullptr};
+    };
+
+    struct BipedAnim {
+        std::array<BipedObject, 42> objects{};
+    };
+
+    // ---- actors ----
+
+    enum class KNOCK_STATE_ENUM : std::uint32_t { kNormal = 0, kExplode, kExplodeLeadIn, kOut, kOutLeadIn, kQueued };
+
+    enum class SIT_SLEEP_STATE : std::uint32_t {
+        kNormal = 0,
+        kWantToSit,
+        kWaitingForSitAnim,
+        kIsSitting,
+        kWantToStand,
+        kWantToSleep,
+        kWaitingForSleepAnim,
+        kIsSleeping,
+        kWantToWake,
+    };
+
+    enum class ATTACK_STATE_ENUM : std::uint32_t { kNone = 0, kDraw = 1 };
+    enum class WEAPON_STATE : std::uint32_t { kSheathed = 0, kDrawn = 3 };
+
+    struct ActorState2 {
+        bool talkingToPlayer{false};
+        bool bleedout{false};
+        bool unconscious{false};
+    };
+
+    class ActorState {
+    public:
+        [[nodiscard]] KNOCK_STATE_ENUM GetKnockState() const noexcept { return knockState; }
+        [[nodiscard]] SIT_SLEEP_STATE GetSitSleepState() const noexcept { return sitSleepState; }
+        [[nodiscard]] bool IsBleedingOut() const noexcept { return actorState2.bleedout; }
+        [[nodiscard]] bool IsUnconscious() const noexcept { return actorState2.unconscious; }
+        [[nodiscard]] bool IsWeaponDrawn() const noexcept { return weaponState == WEAPON_STATE::kDrawn; }
+
+        KNOCK_STATE_ENUM knockState{KNOCK_STATE_ENUM::kNormal};
+        SIT_SLEEP_STATE sitSleepState{SIT_SLEEP_STATE::kNormal};
+        WEAPON_STATE weaponState{WEAPON_STATE::kSheathed};
+        ActorState2 actorState2{};
+    };
+
+    class TESObjectREFR : public TESForm {
+    public:
+        using TESForm::TESForm;
+    };
+
+    // What a hand currently holds: the engine answers GetEquippedEntryData with an entry restricted to that instance.
+    struct EquippedHand {
+        TESBoundObject* object{nullptr};
+        ExtraDataList* extra{nullptr};
+        BSSimpleList<ExtraDataList*> extraLists;
+        InventoryEntryData entry;
+    };
+
+    struct ActorRuntimeData {
+        TESForm* selectedPower{nullptr};
+    };
+
+    class Actor : public TESObjectREFR {
+    public:
+        explicit Actor(FormID a_id, std::string a_name = "Actor");
+        ~Actor() override;
+
+        [[nodiscard]] ActorRuntimeData& GetActorRuntimeData() noexcept { return runtimeData; }
+        [[nodiscard]] const ActorRuntimeData& GetActorRuntimeData() const noexcept { return runtimeData; }
+
+        [[nodiscard]] ActorState* AsActorState() noexcept { return &actorState; }
+        [[nodiscard]] const ActorState* AsActorState() const noexcept { return &actorState; }
+
+        void DrawWeaponMagicHands(bool a_draw) {
+            actorState.weaponState = a_draw ? WEAPON_STATE::kDrawn : WEAPON_STATE::kSheathed;
+            ++drawCalls;
+        }
+
+        [[nodiscard]] bool IsInCombat() const noexcept { return inCombat; }
+        [[nodiscard]] TESAmmo* GetCurrentAmmo() const noexcept { return currentAmmo; }
+
+        [[nodiscard]] InventoryEntryData* GetEquippedEntryData(bool a_leftHand) noexcept;
+        [[nodiscard]] TESForm* GetEquippedObject(bool a_leftHand) const noexcept;
+
+        [[nodiscard]] InventoryChanges* GetInventoryChanges() noexcept { return inventoryChanges.get(); }
+        [[nodiscard]] TESContainer* GetContainer() noexcept { return &container; }
+        [[nodiscard]] const std::shared_ptr<BipedAnim>& GetBiped(bool a_firstPerson) const noexcept {
+            return a_firstPerson ? biped1st : biped3rd;
+        }
+
+        bool SetGraphVariableBool(const BSFixedString& a_name, bool a_value) {
+            graphBools[a_name.data()] = a_value;
+            return true;
+        }
+
+        bool SetGraphVariableInt(const BSFixedString& a_name, std::int32_t a_value) {
+            graphInts[a_name.data()] = a_value;
+            return true;
+        }
+
+        ActorState actorState{};
+        ActorRuntimeData runtimeData{};
+        bool inCombat{false};
+        TESAmmo* currentAmmo{nullptr};
+        std::array<EquippedHand, 2> hands{};  // [0] right, [1] left
+
+        std::unique_ptr<InventoryChanges> inventoryChanges;
+        TESContainer container;
+        std::shared_ptr<BipedAnim> biped1st;
+        std::shared_ptr<BipedAnim> biped3rd;
+
+        std::unordered_map<const char*, bool> graphBools;
+        std::unordered_map<const char*, std::int32_t> graphInts;
+        std::uint64_t drawCalls{0};
+    };
+
+    class PlayerCharacter : public Actor {
+    public:
+        PlayerCharacter() : Actor(0x14, "Prisoner") {}
+
+        // The stand-in singleton is whatever player the harness installed (nullptr before one exists).
+        [[nodiscard]] static PlayerCharacter* GetSingleton() noexcept { return Instance().load(); }
+        static void SetSingleton(PlayerCharacter* a_player) noexcept { Instance().store(a_player); }
+
+    private:
+        static std::atomic<PlayerCharacter*>& Instance() noexcept;
+    };
+
+    class BGSEquipSlot;
+
+    // Calls land on an installable handler (the harness's equip model); without one they are only counted.
+    class ActorEquipManager {
+    public:
+        struct Call {
+            bool equip{false};
+            Actor* actor{nullptr};
+            TESBoundObject* object{nullptr};
+            ExtraDataList* extra{nullptr};
+            bool queue{false};
+            bool force{false};
+            bool applyNow{false};
+        };
+
+        using Handler = std::function<void(const Call&)>;
+
+        [[nodiscard]] static ActorEquipManager* GetSingleton() noexcept;
+
+        void EquipObject(Actor* a_actor, TESBoundObject* a_object, ExtraDataList* a_extraData = nullptr,
+                         std::uint32_t a_count = 1, const BGSEquipSlot* a_slot = nullptr, bool a_queueEquip = true,
+                         bool a_forceEquip = false, bool a_playSounds = true, bool a_applyNow = false);
+
+        void UnequipObject(Actor* a_actor, TESBoundObject* a_object, ExtraDataList* a_extraData = nullptr,
+                           std::uint32_t a_count = 1, const BGSEquipSlot* a_slot = nullptr,
+                           bool a_queueEquip = true, bool a_forceEquip = false, bool a_playSounds = true,
+                           bool a_applyNow = false, const BGSEquipSlot* a_slotToReplace = nullptr);
+
+        Handler handler;
+        std::uint64_t equips{0};
+        std::uint64_t unequips{0};
+    };
+
+    // ---- input ----
+
+    class ButtonEvent;
+
+    class InputEvent {
+    public:
+        virtual ~InputEvent() = default;
+
+        [[nodiscard]] INPUT_DEVICE GetDevice() const noexcept { return device; }
+        [[nodiscard]] INPUT_EVENT_TYPE GetEventType() const noexcept { return eventType; }
+
+        [[nodiscard]] ButtonEvent* AsButtonEvent() noexcept;
+        [[nodiscard]] const ButtonEvent* AsButtonEvent() const noexcept;
+
+        INPUT_DEVICE device{INPUT_DEVICE::kNone};
+        INPUT_EVENT_TYPE eventType{INPUT_EVENT_TYPE::kButton};
+        InputEvent* next{nullptr};
+    };
+
+    class IDEvent : public InputEvent {
+    public:
+        [[nodiscard]] const BSFixedString& QUserEvent() const noexcept { return userEvent; }
+        [[nodiscard]] std::uint32_t GetIDCode() const noexcept { return idCode; }
+
+        BSFixedString userEvent;
+        std::uint32_t idCode{0};
+    };
+
+    // Same edge rules as the engine: down is the first frame with a value, up the first frame after without one.
+    class ButtonEvent : public IDEvent {
+    public:
+        [[nodiscard]] static ButtonEvent* Create(INPUT_DEVICE a_inputDevice, const BSFixedString& a_userEvent,
+                                                 std::uint32_t a_idCode, float a_value, float a_duration);
+
+        [[nodiscard]] float Value() const noexcept { return value; }
+        [[nodiscard]] float HeldDuration() const noexcept { return heldDownSecs; }
+        [[nodiscard]] bool IsPressed() const noexcept { return value > 0.0f; }
+        [[nodiscard]] bool IsDown() const noexcept { return value > 0.0f && heldDownSecs == 0.0f; }
+        [[nodiscard]] bool IsHeld() const noexcept { return value > 0.0f && heldDownSecs > 0.0f; }
+        [[nodiscard]] bool IsUp() const noexcept { return value == 0.0f && heldDownSecs > 0.0f; }
+
+        float value{0.0f};
+        float heldDownSecs{0.0f};
+    };
+
+    inline ButtonEvent* InputEvent::AsButtonEvent() noexcept {
+        return eventType == INPUT_EVENT_TYPE::kButton ? static_cast<ButtonEvent*>(this) : nullptr;
+    }
+
+    inline const ButtonEvent* InputEvent::AsButtonEvent() const noexcept {
+        return eventType == INPUT_EVENT_TYPE::kButton ? static_cast<const ButtonEvent*>(this) : nullptr;
+    }
+
+    class BSInputDeviceManager : public BSTEventSource<InputEvent*> {
+    public:
+        [[nodiscard]] static BSInputDeviceManager* GetSingleton() noexcept;
+    };
+
+    // ---- events ----
+
+    struct MenuOpenCloseEvent {
+        BSFixedString menuName;
+        bool opening{false};
+    };
+
+    struct BSAnimationGraphEvent {
+        BSFixedString tag;
+        const TESObjectREFR* holder{nullptr};
+        BSFixedString payload;
+    };
+
+    template <class T>
+    class NiPointer {
+    public:
+        NiPointer() noexcept = default;
+        NiPointer(T* a_ptr) noexcept : _ptr(a_ptr) {}  // NOLINT
+
+        [[nodiscard]] T* get() const noexcept { return _ptr; }
+        [[nodiscard]] T* operator->() const noexcept { return _ptr; }
+        explicit operator bool() const noexcept { return _ptr != nullptr; }
+
+    private:
+        T* _ptr{nullptr};
+    };
+
+    struct TESContainerChangedEvent {
+        FormID oldContainer{0};
+        FormID newContainer{0};
+        FormID baseObj{0};
+        std::int32_t itemCount{0};
+    };
+
+    struct TESEquipEvent {
+        NiPointer<TESObjectREFR> actor;
+        FormID baseObject{0};
+        bool equipped{false};
+    };
+
+    struct TESSwitchRaceCompleteEvent {
+        NiPointer<TESObjectREFR> subject;
+    };
+
+    class ScriptEventSourceHolder : public BSTEventSource<TESContainerChangedEvent>,
+                                    public BSTEventSource<TESEquipEvent>,
+                                    public BSTEventSource<TESSwitchRaceCompleteEvent> {
+    public:
+        [[nodiscard]] static ScriptEventSourceHolder* GetSingleton() noexcept;
+
+        template <class T>
+        void AddEventSink(BSTEventSink<T>* a_sink) {
+            static_cast<BSTEventSource<T>*>(this)->AddEventSink(a_sink);
+        }
+
+        template <class T>
+        void SendEvent(const T* a_event) {
+            static_cast<BSTEventSource<T>*>(this)->SendEvent(a_event);
+        }
+    };
+
+    class UI : public BSTEventSource<MenuOpenCloseEvent> {
+    public:
+        [[nodiscard]] static UI* GetSingleton() noexcept;
+
+        [[nodiscard]] bool GameIsPaused() const noexcept { return paused; }
+        [[nodiscard]] bool IsMenuOpen(const BSFixedString& a_menu) const {
+            for (auto const& m : openMenus) {
+                if (m == a_menu) return true;
+            }
+            return false;
+        }
+
+        template <class T>
+        void AddEventSink(BSTEventSink<T>* a_sink) {
+            static_cast<BSTEventSource<T>*>(this)->AddEventSink(a_sink);
+        }
+
+        // Opens or closes a menu and tells the sinks, as the engine's menu queue does.
+        void SetMenuOpen(const BSFixedString& a_menu, bool a_open);
+
+        bool paused{false};
+        std::vector<BSFixedString> openMenus;
+    };
+}
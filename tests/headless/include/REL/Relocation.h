@@ -0,0 +1,3 @@
+#pragma once
+
+// The headless build patches nothing; this only satisfies PCH.h.
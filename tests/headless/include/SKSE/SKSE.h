@@ -0,0 +1,4 @@
+#pragma once
+
+// The headless build has no SKSE runtime; this only satisfies PCH.h.
+namespace SKSE {}
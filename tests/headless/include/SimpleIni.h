@@ -0,0 +1,128 @@
+#pragma once
+
+// Stand-in for the subset of SimpleIni that BowConfig uses: sections and keys keep file order, values are strings,
+// comments and blank lines are dropped on load. Good enough to round-trip IntegratedBow.ini in the headless build.
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using SI_Error = int;
+inline constexpr SI_Error SI_OK = 0;
+inline constexpr SI_Error SI_UPDATED = 1;
+inline constexpr SI_Error SI_INSERTED = 2;
+inline constexpr SI_Error SI_FAIL = -1;
+inline constexpr SI_Error SI_NOMEM = -2;
+inline constexpr SI_Error SI_FILE = -3;
+
+class CSimpleIniA {
+public:
+    void SetUnicode(bool = true) noexcept {}
+
+    SI_Error LoadFile(const char* a_path) {
+        std::ifstream f(a_path, std::ios::binary);
+        if (!f) return SI_FILE;
+
+        _sections.clear();
+        Section* cur = nullptr;
+        std::string line;
+        while (std::getline(f, line)) {
+            auto text = Trim(line);
+            if (text.starts_with("\xEF\xBB\xBF")) text.remove_prefix(3);
+            if (text.empty() || text.front() == ';' || text.front() == '#') continue;
+
+            if (text.front() == '[') {
+                const auto close = text.find(']');
+                cur = &Touch(Trim(text.substr(1, close == std::string_view::npos ? text.npos : close - 1)));
+                continue;
+            }
+
+            const auto eq = text.find('=');
+            if (eq == std::string_view::npos || !cur) continue;
+            Put(*cur, Trim(text.substr(0, eq)), Trim(text.substr(eq + 1)));
+        }
+        return SI_OK;
+    }
+
+    SI_Error SaveFile(const char* a_path) const {
+        std::ofstream f(a_path, std::ios::binary | std::ios::trunc);
+        if (!f) return SI_FILE;
+
+        bool first = true;
+        for (auto const& s : _sections) {
+            if (!first) f << '\n';
+            first = false;
+            f << '[' << s.name << "]\n";
+            for (auto const& [k, v] : s.keys) {
+                f << k << " = " << v << '\n';
+            }
+        }
+        f.close();
+        return f.fail() ? SI_FILE : SI_OK;
+    }
+
+    [[nodiscard]] const char* GetValue(const char* a_section, const char* a_key,
+                                       const char* a_default = nullptr) const {
+        for (auto const& s : _sections) {
+            if (s.name != a_section) continue;
+            for (auto const& [k, v] : s.keys) {
+                if (k == a_key) return v.c_str();
+            }
+        }
+        return a_default;
+    }
+
+    SI_Error SetValue(const char* a_section, const char* a_key, const char* a_value) {
+        return Put(Touch(a_section), a_key, a_value ? a_value : "");
+    }
+
+    SI_Error SetLongValue(const char* a_section, const char* a_key, long a_value) {
+        return SetValue(a_section, a_key, std::to_string(a_value).c_str());
+    }
+
+    SI_Error SetBoolValue(const char* a_section, const char* a_key, bool a_value) {
+        return SetValue(a_section, a_key, a_value ? "true" : "false");
+    }
+
+    SI_Error SetDoubleValue(const char* a_section, const char* a_key, double a_value) {
+        std::ostringstream os;
+        os << a_value;
+        return SetValue(a_section, a_key, os.str().c_str());
+    }
+
+private:
+    struct Section {
+        std::string name;
+        std::vector<std::pair<std::string, std::string>> keys;
+    };
+
+    static std::string_view Trim(std::string_view s) noexcept {
+        while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+        while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1);
+        return s;
+    }
+
+    Section& Touch(std::string_view a_name) {
+        for (auto& s : _sections) {
+            if (s.name == a_name) return s;
+        }
+        return _sections.emplace_back(Section{std::string{a_name}, {}});
+    }
+
+    static SI_Error Put(Section& a_section, std::string_view a_key, std::string_view a_value) {
+        for (auto& [k, v] : a_section.keys) {
+            if (k == a_key) {
+                v = a_value;
+                return SI_UPDATED;
+            }
+        }
+        a_section.keys.emplace_back(std::string{a_key}, std::string{a_value});
+        return SI_INSERTED;
+    }
+
+    std::vector<Section> _sections;
+};